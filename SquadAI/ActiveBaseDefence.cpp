@@ -68,7 +68,7 @@ void ActiveBaseDefence::ProcessMessage(Message* pMessage)
 		if(pMsg->GetData().m_orderState == SucceededOrderState)
 		{
 			XMFLOAT2 movePosition(0.0f, 0.0f);
-			if(!m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(GetTeamAI()->GetFlagData(GetTeamAI()->GetTeam()).m_basePosition, m_patrolRadius, movePosition))
+			if(!m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(GetTeamAI()->GetFlagData(GetTeamAI()->GetTeam()).m_basePosition, m_patrolRadius, GetParticipant(pMsg->GetData().m_entityId)->GetPosition(), movePosition))
 			{
 				m_pTeamAI->ReleaseEntityFromManoeuvre(pMsg->GetData().m_entityId);
 			}else
@@ -101,12 +101,12 @@ BehaviourStatus ActiveBaseDefence::Initiate(void)
 		// Randomly pick a grid field near the base and patrol to it.
 
 		XMFLOAT2 movePosition(0.0f, 0.0f);
-		if(!m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(GetTeamAI()->GetFlagData(GetTeamAI()->GetTeam()).m_basePosition, m_patrolRadius, movePosition))
+		if(!m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(GetTeamAI()->GetFlagData(GetTeamAI()->GetTeam()).m_basePosition, m_patrolRadius, (*it)->GetPosition(), movePosition))
 		{
 			return StatusFailure;
 		}
 
-		Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, movePosition);
+		Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, movePosition, g_kPatrolPathSuboptimality);
 
 		if(!pNewOrder)
 		{
@@ -36,6 +36,26 @@ const XMFLOAT4 g_kGridColour(1.0f, 1.0f, 1.0f, 1.0f);			  // The colour of the g
 
 // Test environment settings
 const unsigned int g_kSoldiersPerTeam = 8; // The number of soldiers forming a team during the matches
+const bool  g_kUseBatchedFieldOfViewTest = true; // Whether range and field of view of all soldiers are tested at once at the start of each frame (see FieldOfViewCandidates)
+const bool  g_kUseVisibilityTable = true; // Whether soldiers in grid fields that are fully visible from each other skip the exact line of sight test (see VisibilityTable)
+const bool  g_kUseGridTraversalLineOfSight = true; // Whether line of sight checks only test the obstacles on the grid fields crossed by the line (see CheckLineOfSightTraversal) instead of all within its bounding box
+const float g_kSpatialHashBucketSize = 10.0f; // The size of the buckets sorting the soldiers by position for proximity queries, a sensor query (viewing distance 20) visits at most 5x5 buckets
+
+// Pathfinding settings
+const unsigned int g_kClusterSize					= 16;   // The number of grid fields along each side of the clusters used for hierarchical pathfinding
+const unsigned int g_kMaxSingleEntranceWidth		= 6;    // Openings between clusters narrower than this get a single entrance in their centre, wider ones an entrance at each end
+const unsigned int g_kPathCacheCapacity				= 256;  // The maximal number of search results held by the path cache of the pathfinder
+const unsigned int g_kPathExpansionsPerFrame		= 4000; // The maximal number of nodes all path searches of the soldiers may expand per frame together
+const unsigned int g_kMinPathExpansionsPerSearch	= 64;   // The smallest share of the per-frame expansion budget handed to a single search
+const unsigned int g_kMaxAdaptiveSearchSeriesLength = 256;  // The number of consecutive adaptive searches after which the learned heuristic values are discarded
+const unsigned int g_kNumberOfLandmarks				= 8;    // The number of landmarks the landmark (ALT) heuristic calculates distances to
+const float		   g_kPatrolPathSuboptimality		= 0.5f;  // Paths to patrol targets may cost this much more than the shortest ones (0.5 -> 50%), trades path quality for faster searches
+const float		   g_kAssemblyPathSuboptimality		= 0.25f; // Paths to the assembly points of attack manoeuvres may cost this much more than the shortest ones
+const bool		   g_kUseCooperativePathfinding		= true;  // Whether attack manoeuvres plan the paths of their participants cooperatively to avoid congestion at base entrances
+const unsigned int g_kReservationWindow				= 16;    // The number of time steps (grid fields crossed) cooperative paths reserve grid fields in advance
+const bool		   g_kRemoveCollinearWaypoints		= true;  // Whether paths found on the grid only keep the waypoints, at which they change direction
+const bool		   g_kStraightenPaths				= true;  // Whether paths found on the grid skip waypoints that lie between two others connected by a straight line crossing only free fields (see CheckStraightPathGrid)
+const bool		   g_kCollectPathfindingStatistics	= true;  // Whether the pathfinder measures the wall time of its queries and aggregates their statistics (see PathfindingStatistics)
 
 // Game settings
 const float g_kPickupFlagRadiusRelative = 0.5f;  // An entity has to approach a flag this close (in relation to the grid spacing) in order to pick it up or return it
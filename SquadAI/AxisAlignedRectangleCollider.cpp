@@ -41,23 +41,33 @@ bool AxisAlignedRectangleCollider::CheckLineCollision(const XMFLOAT2& lineStart,
 	XMFLOAT2 lineEndGrid(lineEnd.x + m_halfGridSize, lineEnd.y + m_halfGridSize);
 
 
-	// Determine intersections of the four lines making up the rectangle with the passed in line
-
-	// Check if the line is fully encompassed by the rectangle (if so the tests conducted below won't
-	// register an intersection).
-	if(CheckPointCollision(lineStartGrid) && CheckPointCollision(lineEndGrid))
+	// The line misses the rectangle if their bounding boxes do not overlap
+	if(std::max(lineStartGrid.x, lineEndGrid.x) < m_bottomLeft.x || std::min(lineStartGrid.x, lineEndGrid.x) > m_bottomRight.x ||
+	   std::max(lineStartGrid.y, lineEndGrid.y) < m_bottomLeft.y || std::min(lineStartGrid.y, lineEndGrid.y) > m_topLeft.y)
 	{
-		// Both line segment end points are encompassed by the rectangle
-		return true;
+		return false;
 	}
 
-	// Check the sides of the rectangle
+	// Otherwise it misses the rectangle only if all four corners lie strictly on the same side of it. Testing the
+	// corners needs no intersection points with the sides, whose rounding errors would let lines crossing the
+	// rectangle close to a corner slip through.
+	double deltaX = static_cast<double>(lineEndGrid.x) - lineStartGrid.x;
+	double deltaY = static_cast<double>(lineEndGrid.y) - lineStartGrid.y;
+
+	const XMFLOAT2* corners[4] = {&m_topLeft, &m_topRight, &m_bottomLeft, &m_bottomRight};
+
+	bool isLeft	 = false;
+	bool isRight = false;
+
+	for(unsigned int i = 0; i < 4; ++i)
+	{
+		double side = deltaX * (static_cast<double>(corners[i]->y) - lineStartGrid.y) - deltaY * (static_cast<double>(corners[i]->x) - lineStartGrid.x);
 
-	return (CheckLineSegmentsIntersection(lineStartGrid, lineEndGrid, m_bottomLeft, m_topLeft) ||     // left side
-			CheckLineSegmentsIntersection(lineStartGrid, lineEndGrid, m_topLeft, m_topRight) ||       // top
-			CheckLineSegmentsIntersection(lineStartGrid, lineEndGrid, m_bottomRight, m_topRight) ||   // right
-			CheckLineSegmentsIntersection(lineStartGrid, lineEndGrid, m_bottomLeft, m_bottomRight));  // bottom
+		isLeft	= isLeft || side >= 0.0;
+		isRight = isRight || side <= 0.0;
+	}
 
+	return isLeft && isRight;
 }
 
 //--------------------------------------------------------------------------------------
@@ -71,58 +81,6 @@ bool AxisAlignedRectangleCollider::CheckPointCollision(const XMFLOAT2& point) co
 	return point.x >= m_bottomLeft.x && point.y >= m_bottomLeft.y && point.x <= m_bottomRight.x && point.y <= m_topLeft.y;
 }
 
-//--------------------------------------------------------------------------------------
-// Checks for intersection between two line segments.
-// Param1: The start point of the first line.
-// Param2: The end point of the first line.
-// Param3: The start point of the second line.
-// Param4: The end point of the second line.
-// Returns true if the two line segments intersect, inluding coincidence, false otherwise
-//--------------------------------------------------------------------------------------
-bool AxisAlignedRectangleCollider::CheckLineSegmentsIntersection(const XMFLOAT2& line1Start, const XMFLOAT2& line1End, const XMFLOAT2& line2Start, const XMFLOAT2& line2End) const
-{
-	// Get the intersection point
-	XMVECTOR intersection = XMVector2IntersectLine(XMLoadFloat2(&line1Start), XMLoadFloat2(&line1End), XMLoadFloat2(&line2Start), XMLoadFloat2(&line2End));  
-
-	// The intersection vector is NaN if the lines are parallel
-	if(!XMVector2IsNaN(intersection))
-	{
-		// The intersection vector is infinited when the lines are coincident (this counts as collision)
-		if(!XMVector2IsInfinite(intersection))
-		{
-			XMFLOAT2 intersectionPoint;
-			XMStoreFloat2(&intersectionPoint, intersection);
-
-			// Check if the intersection point lies within both segments.
-			// Checking the x value is sufficient as it is already guaranteed that the point lies on the lines.
-			std::pair<float, float> line1XMinMax = std::minmax<float>(line1Start.x, line1End.x);
-			std::pair<float, float> line2XMinMax = std::minmax<float>(line2Start.x, line2End.x);
-			std::pair<float, float> line1YMinMax = std::minmax<float>(line1Start.y, line1End.y);
-			std::pair<float, float> line2YMinMax = std::minmax<float>(line2Start.y, line2End.y);
-			if((line1XMinMax.first <= intersectionPoint.x  && intersectionPoint.x <= line1XMinMax.second) &&
-			   (line2XMinMax.first <= intersectionPoint.x  && intersectionPoint.x <= line2XMinMax.second) &&
-			   (line1YMinMax.first <= intersectionPoint.y  && intersectionPoint.y <= line1YMinMax.second) &&
-			   (line2YMinMax.first <= intersectionPoint.y  && intersectionPoint.y <= line2YMinMax.second))
-			{
-				return true;
-			}
-		}else
-		{
-			// The lines are coincident, check if the segments overlap.
-			// Checking the x values is sufficient.
-			std::pair<float, float> line1MinMax = std::minmax<float>(line1Start.x, line1End.x);
-			if((line1MinMax.first <= line2Start.x  && line2Start.x <= line1MinMax.second) ||
-			   (line1MinMax.first <= line2End.x  && line2End.x <= line1MinMax.second))
-			{
-				// The segments overlap
-				return true;
-			}
-		}
-	}
-
-	return false;
-}
-
 // Data access functions
 
 float AxisAlignedRectangleCollider::GetWidth(void) const
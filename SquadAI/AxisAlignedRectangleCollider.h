@@ -48,8 +48,6 @@ public:
 
 private:
 
-	bool CheckLineSegmentsIntersection(const XMFLOAT2& line1Start, const XMFLOAT2& line1End, const XMFLOAT2& line2Start, const XMFLOAT2& line2End) const;
-
 	float	 m_width;		 // The width of the rectangle making up the collider
 	float	 m_height;		 // The height of the rectangle making up the collider
 	float    m_halfGridSize; // Only used internally to convert coordinates from world space to grid space
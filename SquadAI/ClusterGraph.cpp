@@ -0,0 +1,338 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  ClusterGraph.cpp
+*  An abstraction of the node graph of a test environment used for hierarchical pathfinding (HPA*).
+*  The grid is partitioned into square clusters of a fixed size. Pairs of adjacent traversable nodes
+*  on the borders between clusters are chosen as entrances and the costs of the shortest paths between
+*  the entrances of each cluster are precomputed. Changes to the obstacles of the test environment only
+*  invalidate the clusters they affect, these are rebuilt on the next update.
+*/
+
+// Includes
+#include <cfloat>
+#include <algorithm>
+#include "ClusterGraph.h"
+#include "Pathfinder.h"
+#include "TestEnvironment.h"
+
+ClusterGraph::ClusterGraph(void) : m_pEnvironment(nullptr),
+								   m_clusterSize(0),
+								   m_numberOfClustersPerSide(0),
+								   m_isUpToDate(false)
+{
+	m_searchContext.SetCallerTag("Cluster Graph");
+}
+
+ClusterGraph::~ClusterGraph(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Initialises the cluster graph for the current grid of a test environment. All clusters
+// are marked for rebuild.
+// Param1: A pointer to the test environment, the node graph of which should be abstracted.
+// Param2: The number of grid fields along each side of a cluster.
+// Returns true if the cluster graph was initialised successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool ClusterGraph::Initialise(const TestEnvironment* pTestEnvironment, unsigned int clusterSize)
+{
+	if(!pTestEnvironment || clusterSize == 0)
+	{
+		return false;
+	}
+
+	m_pEnvironment = pTestEnvironment;
+	m_clusterSize  = clusterSize;
+
+	unsigned int numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+
+	m_numberOfClustersPerSide = (numberOfGridPartitions + m_clusterSize - 1) / m_clusterSize;
+
+	m_clusters.assign(m_numberOfClustersPerSide * m_numberOfClustersPerSide, Cluster());
+	m_entranceIndices.assign(numberOfGridPartitions * numberOfGridPartitions, -1);
+
+	m_isUpToDate = false;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Marks the clusters affected by a change to a grid field (an obstacle was added or removed)
+// for rebuild. Besides the cluster containing the field this includes the clusters sharing
+// a border with the field, as the entrances on that border depend on both sides.
+// Param1: The x-coordinate of the changed grid field.
+// Param2: The y-coordinate of the changed grid field.
+//--------------------------------------------------------------------------------------
+void ClusterGraph::Invalidate(unsigned int gridX, unsigned int gridY)
+{
+	if(m_clusterSize == 0 || gridX >= m_pEnvironment->GetNumberOfGridPartitions() || gridY >= m_pEnvironment->GetNumberOfGridPartitions())
+	{
+		return;
+	}
+
+	unsigned int clusterX = gridX / m_clusterSize;
+	unsigned int clusterY = gridY / m_clusterSize;
+
+	SetDirty(clusterX, clusterY);
+
+	if((gridX % m_clusterSize == 0) && (clusterX > 0))
+	{
+		SetDirty(clusterX - 1, clusterY);
+	}
+	if((gridX % m_clusterSize == m_clusterSize - 1) && (clusterX + 1 < m_numberOfClustersPerSide))
+	{
+		SetDirty(clusterX + 1, clusterY);
+	}
+	if((gridY % m_clusterSize == 0) && (clusterY > 0))
+	{
+		SetDirty(clusterX, clusterY - 1);
+	}
+	if((gridY % m_clusterSize == m_clusterSize - 1) && (clusterY + 1 < m_numberOfClustersPerSide))
+	{
+		SetDirty(clusterX, clusterY + 1);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Rebuilds the entrances and distances of all clusters marked as dirty. Has to be called
+// after the obstacles were applied to the node graph.
+// Param1: The pathfinder used to calculate the distances within the clusters.
+//--------------------------------------------------------------------------------------
+void ClusterGraph::Update(const Pathfinder& pathfinder)
+{
+	if(m_isUpToDate)
+	{
+		return;
+	}
+
+	for(unsigned int i = 0; i < m_clusters.size(); ++i)
+	{
+		if(m_clusters[i].m_isDirty)
+		{
+			FindEntrances(i);
+			CalculateDistances(i, pathfinder);
+			m_clusters[i].m_isDirty = false;
+		}
+	}
+
+	m_isUpToDate = true;
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the cluster that a grid field belongs to.
+// Param1: The x-coordinate of the grid field.
+// Param2: The y-coordinate of the grid field.
+// Returns the index of the cluster containing the grid field.
+//--------------------------------------------------------------------------------------
+unsigned int ClusterGraph::GetClusterIndex(unsigned int gridX, unsigned int gridY) const
+{
+	return (gridX / m_clusterSize) * m_numberOfClustersPerSide + (gridY / m_clusterSize);
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the grid fields covered by a cluster. Clusters at the edge of the grid may
+// be smaller than the others.
+// Param1: The index of the cluster.
+// Param2: Will hold the smallest x-coordinate of the grid fields within the cluster.
+// Param3: Will hold the smallest y-coordinate of the grid fields within the cluster.
+// Param4: Will hold the greatest x-coordinate of the grid fields within the cluster.
+// Param5: Will hold the greatest y-coordinate of the grid fields within the cluster.
+//--------------------------------------------------------------------------------------
+void ClusterGraph::GetClusterBounds(unsigned int clusterIndex, unsigned int& minX, unsigned int& minY, unsigned int& maxX, unsigned int& maxY) const
+{
+	unsigned int numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+
+	minX = (clusterIndex / m_numberOfClustersPerSide) * m_clusterSize;
+	minY = (clusterIndex % m_numberOfClustersPerSide) * m_clusterSize;
+	maxX = std::min(minX + m_clusterSize, numberOfGridPartitions) - 1;
+	maxY = std::min(minY + m_clusterSize, numberOfGridPartitions) - 1;
+}
+
+//--------------------------------------------------------------------------------------
+// Gets the position of a node within the entrance list of its cluster.
+// Param1: The id of the node.
+// Returns the index of the node in the entrance list of its cluster, -1 if it is no entrance.
+//--------------------------------------------------------------------------------------
+int ClusterGraph::GetEntranceIndex(unsigned long nodeId) const
+{
+	return m_entranceIndices[nodeId];
+}
+
+//--------------------------------------------------------------------------------------
+// Gets the cost of the shortest path between two entrances of a cluster that does not leave
+// the cluster.
+// Param1: The index of the cluster.
+// Param2: The index of the entrance to start from.
+// Param3: The index of the entrance to move to.
+// Returns the cost of the path, FLT_MAX if the entrances are not connected within the cluster.
+//--------------------------------------------------------------------------------------
+float ClusterGraph::GetDistance(unsigned int clusterIndex, unsigned int fromEntrance, unsigned int toEntrance) const
+{
+	return m_clusters[clusterIndex].m_distances[fromEntrance * m_clusters[clusterIndex].m_entrances.size() + toEntrance];
+}
+
+//--------------------------------------------------------------------------------------
+// Marks a cluster for rebuild.
+// Param1: The x-coordinate of the cluster.
+// Param2: The y-coordinate of the cluster.
+//--------------------------------------------------------------------------------------
+void ClusterGraph::SetDirty(unsigned int clusterX, unsigned int clusterY)
+{
+	m_clusters[clusterX * m_numberOfClustersPerSide + clusterY].m_isDirty = true;
+	m_isUpToDate = false;
+}
+
+//--------------------------------------------------------------------------------------
+// Replaces the entrances of a cluster with the ones found on its current borders.
+// Param1: The index of the cluster.
+//--------------------------------------------------------------------------------------
+void ClusterGraph::FindEntrances(unsigned int clusterIndex)
+{
+	Cluster& cluster = m_clusters[clusterIndex];
+
+	for(std::vector<unsigned long>::const_iterator it = cluster.m_entrances.begin(); it != cluster.m_entrances.end(); ++it)
+	{
+		m_entranceIndices[*it] = -1;
+	}
+
+	cluster.m_entrances.clear();
+
+	AddBorderEntrances(clusterIndex, -1,  0);
+	AddBorderEntrances(clusterIndex,  1,  0);
+	AddBorderEntrances(clusterIndex,  0, -1);
+	AddBorderEntrances(clusterIndex,  0,  1);
+}
+
+//--------------------------------------------------------------------------------------
+// Adds the entrances on one border of a cluster. The border is split into sections, in
+// which the grid fields on both sides are traversable. Narrow sections get a single entrance
+// in their centre, wider ones an entrance at each end. As the sections only depend on the
+// fields along the border, the neighbouring cluster finds the matching entrances on its side.
+// Param1: The index of the cluster.
+// Param2: The direction of the border along the x-axis (-1, 0 or 1).
+// Param3: The direction of the border along the y-axis (-1, 0 or 1).
+//--------------------------------------------------------------------------------------
+void ClusterGraph::AddBorderEntrances(unsigned int clusterIndex, int directionX, int directionY)
+{
+	unsigned int minX, minY, maxX, maxY;
+	GetClusterBounds(clusterIndex, minX, minY, maxX, maxY);
+
+	unsigned int numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+
+	if((directionX < 0 && minX == 0) || (directionX > 0 && maxX + 1 >= numberOfGridPartitions) ||
+	   (directionY < 0 && minY == 0) || (directionY > 0 && maxY + 1 >= numberOfGridPartitions))
+	{
+		// There is no neighbouring cluster in this direction
+		return;
+	}
+
+	// The fixed coordinate of the grid fields along the border on this side and the running range
+	unsigned int line  = (directionX < 0) ? minX : ((directionX > 0) ? maxX : ((directionY < 0) ? minY : maxY));
+	unsigned int first = (directionX != 0) ? minY : minX;
+	unsigned int last  = (directionX != 0) ? maxY : maxX;
+
+	int sectionStart = -1;
+
+	for(unsigned int i = first; i <= last + 1; ++i)
+	{
+		bool isOpen = false;
+
+		if(i <= last)
+		{
+			const Node* pInside  = (directionX != 0) ? m_pEnvironment->GetNode(line, i) : m_pEnvironment->GetNode(i, line);
+			const Node* pOutside = (directionX != 0) ? m_pEnvironment->GetNode(line + directionX, i) : m_pEnvironment->GetNode(i, line + directionY);
+
+			isOpen = !pInside->IsObstacle() && !pOutside->IsObstacle();
+		}
+
+		if(isOpen && sectionStart < 0)
+		{
+			sectionStart = i;
+		}else if(!isOpen && sectionStart >= 0)
+		{
+			unsigned int sectionEnd = i - 1;
+
+			if(sectionEnd - sectionStart + 1 < g_kMaxSingleEntranceWidth)
+			{
+				unsigned int centre = (sectionStart + sectionEnd) / 2;
+				AddEntrance(clusterIndex, (directionX != 0) ? line : centre, (directionX != 0) ? centre : line);
+			}else
+			{
+				AddEntrance(clusterIndex, (directionX != 0) ? line : sectionStart, (directionX != 0) ? sectionStart : line);
+				AddEntrance(clusterIndex, (directionX != 0) ? line : sectionEnd, (directionX != 0) ? sectionEnd : line);
+			}
+
+			sectionStart = -1;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Adds a grid field to the entrances of a cluster unless it already is one.
+// Param1: The index of the cluster.
+// Param2: The x-coordinate of the grid field.
+// Param3: The y-coordinate of the grid field.
+//--------------------------------------------------------------------------------------
+void ClusterGraph::AddEntrance(unsigned int clusterIndex, unsigned int gridX, unsigned int gridY)
+{
+	unsigned long id = m_pEnvironment->GetNode(gridX, gridY)->GetId();
+
+	if(m_entranceIndices[id] < 0)
+	{
+		m_entranceIndices[id] = static_cast<int>(m_clusters[clusterIndex].m_entrances.size());
+		m_clusters[clusterIndex].m_entrances.push_back(id);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates the costs of the shortest paths between all entrances of a cluster, only
+// considering paths that stay within the cluster.
+// Param1: The index of the cluster.
+// Param2: The pathfinder used to calculate the costs.
+//--------------------------------------------------------------------------------------
+void ClusterGraph::CalculateDistances(unsigned int clusterIndex, const Pathfinder& pathfinder)
+{
+	Cluster& cluster = m_clusters[clusterIndex];
+
+	unsigned int numberOfEntrances = cluster.m_entrances.size();
+
+	cluster.m_distances.assign(numberOfEntrances * numberOfEntrances, FLT_MAX);
+
+	unsigned int minX, minY, maxX, maxY;
+	GetClusterBounds(clusterIndex, minX, minY, maxX, maxY);
+
+	for(unsigned int i = 0; i < numberOfEntrances; ++i)
+	{
+		pathfinder.CalculateCostsInArea(m_pEnvironment->GetNodeById(cluster.m_entrances[i]), minX, minY, maxX, maxY, m_searchContext);
+
+		for(unsigned int k = 0; k < numberOfEntrances; ++k)
+		{
+			if(m_searchContext.IsClosed(cluster.m_entrances[k]))
+			{
+				cluster.m_distances[i * numberOfEntrances + k] = m_searchContext.GetNodeData(cluster.m_entrances[k]).m_movementCost;
+			}
+		}
+	}
+}
+
+// Data access functions
+
+unsigned int ClusterGraph::GetClusterSize(void) const
+{
+	return m_clusterSize;
+}
+
+unsigned int ClusterGraph::GetNumberOfClustersPerSide(void) const
+{
+	return m_numberOfClustersPerSide;
+}
+
+const std::vector<unsigned long>& ClusterGraph::GetEntrances(unsigned int clusterIndex) const
+{
+	return m_clusters[clusterIndex].m_entrances;
+}
+
+bool ClusterGraph::IsUpToDate(void) const
+{
+	return m_isUpToDate;
+}
@@ -0,0 +1,73 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  ClusterGraph.h
+*  An abstraction of the node graph of a test environment used for hierarchical pathfinding (HPA*).
+*  The grid is partitioned into square clusters of a fixed size. Pairs of adjacent traversable nodes
+*  on the borders between clusters are chosen as entrances and the costs of the shortest paths between
+*  the entrances of each cluster are precomputed. Changes to the obstacles of the test environment only
+*  invalidate the clusters they affect, these are rebuilt on the next update.
+*/
+
+#ifndef CLUSTER_GRAPH_H
+#define CLUSTER_GRAPH_H
+
+// Includes
+#include <vector>
+#include "SearchContext.h"
+
+// Forward declarations
+class TestEnvironment;
+class Pathfinder;
+
+//--------------------------------------------------------------------------------------
+// A square section of the grid and the entrances leading into it.
+//--------------------------------------------------------------------------------------
+struct Cluster
+{
+	Cluster(void) : m_isDirty(true)
+	{}
+
+	std::vector<unsigned long> m_entrances; // The ids of the nodes of this cluster that are entrances from/to adjacent clusters
+	std::vector<float>		   m_distances; // The costs of the shortest paths within the cluster between all pairs of entrances (row-major, FLT_MAX if there is none)
+	bool					   m_isDirty;	// Tells whether the cluster has to be rebuilt because obstacles in or next to it changed
+};
+
+class ClusterGraph
+{
+public:
+	ClusterGraph(void);
+	~ClusterGraph(void);
+
+	bool Initialise(const TestEnvironment* pTestEnvironment, unsigned int clusterSize);
+	void Invalidate(unsigned int gridX, unsigned int gridY);
+	void Update(const Pathfinder& pathfinder);
+
+	unsigned int GetClusterIndex(unsigned int gridX, unsigned int gridY) const;
+	void		 GetClusterBounds(unsigned int clusterIndex, unsigned int& minX, unsigned int& minY, unsigned int& maxX, unsigned int& maxY) const;
+	int			 GetEntranceIndex(unsigned long nodeId) const;
+	float		 GetDistance(unsigned int clusterIndex, unsigned int fromEntrance, unsigned int toEntrance) const;
+
+	// Data access functions
+
+	unsigned int					  GetClusterSize(void) const;
+	unsigned int					  GetNumberOfClustersPerSide(void) const;
+	const std::vector<unsigned long>& GetEntrances(unsigned int clusterIndex) const;
+	bool							  IsUpToDate(void) const;
+
+private:
+	void SetDirty(unsigned int clusterX, unsigned int clusterY);
+	void FindEntrances(unsigned int clusterIndex);
+	void AddBorderEntrances(unsigned int clusterIndex, int directionX, int directionY);
+	void AddEntrance(unsigned int clusterIndex, unsigned int gridX, unsigned int gridY);
+	void CalculateDistances(unsigned int clusterIndex, const Pathfinder& pathfinder);
+
+	const TestEnvironment* m_pEnvironment;			   // The test environment, the node graph of which is abstracted
+	unsigned int		   m_clusterSize;			   // The number of grid fields along each side of a cluster
+	unsigned int		   m_numberOfClustersPerSide;  // The number of clusters along the x and y axis of the grid
+	std::vector<Cluster>   m_clusters;				   // The clusters, indexed by clusterX * m_numberOfClustersPerSide + clusterY
+	std::vector<int>	   m_entranceIndices;		   // For each node the index in the entrance list of its cluster, -1 if the node is no entrance
+	SearchContext		   m_searchContext;			   // Used to calculate the distances between the entrances of a cluster
+	bool				   m_isUpToDate;			   // Tells whether all clusters are valid for the current obstacles
+};
+
+#endif // CLUSTER_GRAPH_H
@@ -0,0 +1,219 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  ConnectedComponents.cpp
+*  Labels the traversable nodes of the grid with the connected component they belong to. Two nodes
+*  are connected if there is a path between them. The labels allow the pathfinder to reject searches
+*  for unreachable targets in constant time and random targets to be picked from the reachable 
+*  part of the grid only.
+*/
+
+// Includes
+#include "ConnectedComponents.h"
+#include "TestEnvironment.h"
+
+ConnectedComponents::ConnectedComponents(void) : m_pEnvironment(nullptr),
+												 m_obstacleVersion(0),
+												 m_isBuilt(false)
+{
+}
+
+ConnectedComponents::~ConnectedComponents(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Initialises the component labels for the current grid of a test environment. The labels
+// are calculated by the next update.
+// Param1: A pointer to the test environment, the grid of which should be labelled.
+// Returns true if the connected components were initialised successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool ConnectedComponents::Initialise(const TestEnvironment* pTestEnvironment)
+{
+	if(!pTestEnvironment)
+	{
+		return false;
+	}
+
+	m_pEnvironment = pTestEnvironment;
+	m_components.clear();
+	m_componentNodes.clear();
+	m_componentOffsets.clear();
+	m_isBuilt = false;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Labels the nodes according to the current obstacles using union-find. Diagonal moves are
+// only possible if both nodes next to the diagonal are traversable (no corner cutting), thus 
+// it is sufficient to unite each traversable node with its traversable right and upper neighbours.
+//--------------------------------------------------------------------------------------
+void ConnectedComponents::Update(void)
+{
+	if(IsUpToDate())
+	{
+		return;
+	}
+
+	unsigned int  numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+	unsigned long numberOfNodes			 = numberOfGridPartitions * numberOfGridPartitions;
+
+	std::vector<unsigned long> parents(numberOfNodes);
+
+	for(unsigned long id = 0; id < numberOfNodes; ++id)
+	{
+		parents[id] = id;
+	}
+
+	for(unsigned int x = 0; x < numberOfGridPartitions; ++x)
+	{
+		for(unsigned int y = 0; y < numberOfGridPartitions; ++y)
+		{
+			if(m_pEnvironment->GetNode(x, y)->IsObstacle())
+			{
+				continue;
+			}
+
+			unsigned long id = x * numberOfGridPartitions + y;
+
+			if(x + 1 < numberOfGridPartitions && !m_pEnvironment->GetNode(x + 1, y)->IsObstacle())
+			{
+				Unite(parents, id, id + numberOfGridPartitions);
+			}
+
+			if(y + 1 < numberOfGridPartitions && !m_pEnvironment->GetNode(x, y + 1)->IsObstacle())
+			{
+				Unite(parents, id, id + 1);
+			}
+		}
+	}
+
+	// Number the components consecutively and count their nodes
+	m_components.assign(numberOfNodes, g_kNoComponent);
+	m_componentOffsets.clear();
+
+	for(unsigned long id = 0; id < numberOfNodes; ++id)
+	{
+		if(m_pEnvironment->GetNodeById(id)->IsObstacle())
+		{
+			continue;
+		}
+
+		// The root of a set is its first node in this loop and receives the next label
+		unsigned long root = FindRoot(parents, id);
+
+		if(m_components[root] == g_kNoComponent)
+		{
+			m_components[root] = m_componentOffsets.size();
+			m_componentOffsets.push_back(0);
+		}
+
+		m_components[id] = m_components[root];
+		++m_componentOffsets[m_components[id]];
+	}
+
+	// Turn the counts into offsets and group the nodes by component
+	unsigned int offset = 0;
+
+	for(std::vector<unsigned int>::iterator it = m_componentOffsets.begin(); it != m_componentOffsets.end(); ++it)
+	{
+		unsigned int size = *it;
+		*it = offset;
+		offset += size;
+	}
+
+	m_componentOffsets.push_back(offset);
+	m_componentNodes.resize(offset);
+
+	std::vector<unsigned int> insertPositions(m_componentOffsets.begin(), m_componentOffsets.end() - 1);
+
+	for(unsigned long id = 0; id < numberOfNodes; ++id)
+	{
+		if(m_components[id] != g_kNoComponent)
+		{
+			m_componentNodes[insertPositions[m_components[id]]++] = id;
+		}
+	}
+
+	m_obstacleVersion = m_pEnvironment->GetObstacleVersion();
+	m_isBuilt		  = true;
+}
+
+//--------------------------------------------------------------------------------------
+// Tells whether there is a path between two nodes.
+// Param1: The id of the first node.
+// Param2: The id of the second node.
+// Returns true if both nodes are traversable and belong to the same component, false otherwise.
+//--------------------------------------------------------------------------------------
+bool ConnectedComponents::AreConnected(unsigned long nodeId, unsigned long otherNodeId) const
+{
+	return m_components[nodeId] != g_kNoComponent && m_components[nodeId] == m_components[otherNodeId];
+}
+
+//--------------------------------------------------------------------------------------
+// Finds the representative of the set a node belongs to. Halves the paths along the way.
+// Param1: The parent of each node in the union-find forest.
+// Param2: The id of the node.
+// Returns the id of the root of the tree containing the node.
+//--------------------------------------------------------------------------------------
+unsigned long ConnectedComponents::FindRoot(std::vector<unsigned long>& parents, unsigned long nodeId) const
+{
+	while(parents[nodeId] != nodeId)
+	{
+		parents[nodeId] = parents[parents[nodeId]];
+		nodeId = parents[nodeId];
+	}
+
+	return nodeId;
+}
+
+//--------------------------------------------------------------------------------------
+// Merges the sets two nodes belong to.
+// Param1: The parent of each node in the union-find forest.
+// Param2: The id of the first node.
+// Param3: The id of the second node.
+//--------------------------------------------------------------------------------------
+void ConnectedComponents::Unite(std::vector<unsigned long>& parents, unsigned long nodeId, unsigned long otherNodeId) const
+{
+	unsigned long root		= FindRoot(parents, nodeId);
+	unsigned long otherRoot = FindRoot(parents, otherNodeId);
+
+	if(root != otherRoot)
+	{
+		// Attach the larger root to the smaller one, the root of each set is its node with the smallest id
+		if(root < otherRoot)
+		{
+			parents[otherRoot] = root;
+		}else
+		{
+			parents[root] = otherRoot;
+		}
+	}
+}
+
+// Data access functions
+
+unsigned int ConnectedComponents::GetComponent(unsigned long nodeId) const
+{
+	return m_components[nodeId];
+}
+
+unsigned int ConnectedComponents::GetNumberOfComponents(void) const
+{
+	return m_componentOffsets.empty() ? 0 : m_componentOffsets.size() - 1;
+}
+
+unsigned int ConnectedComponents::GetComponentSize(unsigned int component) const
+{
+	return m_componentOffsets[component + 1] - m_componentOffsets[component];
+}
+
+unsigned long ConnectedComponents::GetComponentNode(unsigned int component, unsigned int index) const
+{
+	return m_componentNodes[m_componentOffsets[component] + index];
+}
+
+bool ConnectedComponents::IsUpToDate(void) const
+{
+	return m_isBuilt && m_obstacleVersion == m_pEnvironment->GetObstacleVersion();
+}
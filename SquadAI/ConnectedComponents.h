@@ -0,0 +1,53 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  ConnectedComponents.h
+*  Labels the traversable nodes of the grid with the connected component they belong to. Two nodes
+*  are connected if there is a path between them. The labels allow the pathfinder to reject searches
+*  for unreachable targets in constant time and random targets to be picked from the reachable 
+*  part of the grid only.
+*/
+
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+// Includes
+#include <climits>
+#include <vector>
+
+// Forward declarations
+class TestEnvironment;
+
+// The component label of nodes that are blocked by obstacles
+const unsigned int g_kNoComponent = UINT_MAX;
+
+class ConnectedComponents
+{
+public:
+	ConnectedComponents(void);
+	~ConnectedComponents(void);
+
+	bool Initialise(const TestEnvironment* pTestEnvironment);
+	void Update(void);
+	bool AreConnected(unsigned long nodeId, unsigned long otherNodeId) const;
+
+	// Data access functions
+
+	unsigned int  GetComponent(unsigned long nodeId) const;
+	unsigned int  GetNumberOfComponents(void) const;
+	unsigned int  GetComponentSize(unsigned int component) const;
+	unsigned long GetComponentNode(unsigned int component, unsigned int index) const;
+	bool		  IsUpToDate(void) const;
+
+private:
+	unsigned long FindRoot(std::vector<unsigned long>& parents, unsigned long nodeId) const;
+	void		  Unite(std::vector<unsigned long>& parents, unsigned long nodeId, unsigned long otherNodeId) const;
+
+	const TestEnvironment*	   m_pEnvironment;	   // The test environment, the grid of which is labelled
+	std::vector<unsigned int>  m_components;	   // The component of each node, g_kNoComponent for obstacles
+	std::vector<unsigned long> m_componentNodes;   // The ids of all traversable nodes grouped by component
+	std::vector<unsigned int>  m_componentOffsets; // The index of the first node of each component in m_componentNodes, has one additional entry marking the end
+	unsigned int			   m_obstacleVersion;  // The obstacle version of the test environment the labels were calculated for
+	bool					   m_isBuilt;		   // Tells whether the labels were calculated since the grid was initialised
+};
+
+#endif // CONNECTED_COMPONENTS_H
@@ -161,12 +161,17 @@ void CoordinatedBaseAttack::StartAttack(void)
 
 	for(std::vector<Entity*>::iterator it = m_participants.begin(); it != m_participants.end(); ++it)
 	{
-		// Send out the new move orders to attack the enemy flag/base
-		Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, XMFLOAT2(target));
+		// Send out the new move orders to attack the enemy flag/base, the way across the map is searched
+		// hierarchically if no cooperative path can be planned
+		MoveOrder* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, XMFLOAT2(target), 0.0f, HierarchicalAStar);
 		
 		if(!pNewOrder)
 		{
 			SetFailed(true);
+		}else
+		{
+			// Plan the path cooperatively to keep the participants from crowding the same grid fields at the same time
+			GetTeamAI()->CalculateCooperativePath(*it, target, *pNewOrder->GetPath(), GetManoeuvreNameFromType(GetType()));
 		}
 		
 		FollowOrderMessageData data(pNewOrder);
@@ -226,7 +231,7 @@ BehaviourStatus CoordinatedBaseAttack::Initiate(void)
 
 	for(std::vector<Entity*>::iterator it = m_participants.begin(); it != m_participants.end(); ++it)
 	{
-		Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, m_assemblyPoints[m_entityGroupMap[(*it)->GetId()]]);
+		Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, m_assemblyPoints[m_entityGroupMap[(*it)->GetId()]], g_kAssemblyPathSuboptimality);
 			
 		if(!pNewOrder)
 		{
@@ -138,35 +138,50 @@ bool DefendBaseEntrances::DistributeEntities(bool createNewOrders)
 
 	m_guardedEntrances.clear();
 
-	// Keeps track of how many entities are guarding each direction
-	unsigned int entityCount[NumberOfDirections] = {0};
-
 	int startIndex = rand() % m_pTeamAI->GetTestEnvironment()->GetBaseEntrances(m_pTeamAI->GetTeam()).size(); 
 
 	std::unordered_map<Direction, std::vector<XMFLOAT2>>::const_iterator entranceIt = m_pTeamAI->GetTestEnvironment()->GetBaseEntrances(m_pTeamAI->GetTeam()).begin();
 	std::advance(entranceIt, startIndex);
 
+	std::vector<XMFLOAT2> unguardedEntrances;
+	std::vector<XMFLOAT2> path;
+
 	for(std::vector<Entity*>::iterator it = m_participants.begin(); it != m_participants.end(); ++it)
 	{
-		// Randomly determine an entrance from the available entrances for the current direction
-		// Make sure the entrance is not yet guarded by another participant.
+		// Send the participant to the entrance of the current direction that is not yet guarded by another
+		// participant and that it can reach the fastest.
+
+		unguardedEntrances.clear();
 
-		// Note: This could be implemented better, it's still not a perfectly even distribution among all entrances.
-		unsigned int entranceNumber(0);
-		do
+		for(std::vector<XMFLOAT2>::const_iterator entrance = entranceIt->second.begin(); entrance != entranceIt->second.end(); ++entrance)
 		{
-			entranceNumber = rand() % entranceIt->second.size();
-		}while(entityCount[entranceIt->first] < entranceIt->second.size() && IsGuarded(entranceIt->first, entranceIt->second[entranceNumber]));
+			if(!IsGuarded(entranceIt->first, *entrance))
+			{
+				unguardedEntrances.push_back(*entrance);
+			}
+		}
 
-		++entityCount[entranceIt->first];
+		XMFLOAT2	 entrancePosition(0.0f, 0.0f);
+		unsigned int nearestIndex(0);
+
+		m_pTeamAI->GetSearchContext().SetCallerTag(GetManoeuvreNameFromType(GetType()));
+
+		if(!unguardedEntrances.empty() && m_pTeamAI->GetTestEnvironment()->GetPathfinder().CalculatePathToNearest((*it)->GetPosition(), unguardedEntrances, path, nearestIndex, m_pTeamAI->GetSearchContext()))
+		{
+			entrancePosition = unguardedEntrances[nearestIndex];
+		}else
+		{
+			// All entrances are guarded already or none can be reached, pick any of them
+			entrancePosition = entranceIt->second[rand() % entranceIt->second.size()];
+		}
 
 		// Determine the observation direction
 		XMFLOAT2 viewDirection(0.0f, 0.0f);
-		XMStoreFloat2(&viewDirection, XMLoadFloat2(&entranceIt->second[entranceNumber]) - XMLoadFloat2(&m_pTeamAI->GetFlagData(m_pTeamAI->GetTeam()).m_basePosition));
+		XMStoreFloat2(&viewDirection, XMLoadFloat2(&entrancePosition) - XMLoadFloat2(&m_pTeamAI->GetFlagData(m_pTeamAI->GetTeam()).m_basePosition));
 
 		if(createNewOrders)
 		{
-			Order* pNewOrder = new DefendOrder((*it)->GetId(), DefendPositionOrder, MediumPriority, entranceIt->second[entranceNumber], viewDirection);
+			Order* pNewOrder = new DefendOrder((*it)->GetId(), DefendPositionOrder, MediumPriority, entrancePosition, viewDirection);
 			
 			if(!pNewOrder)
 			{
@@ -176,17 +191,17 @@ bool DefendBaseEntrances::DistributeEntities(bool createNewOrders)
 			FollowOrderMessageData data(pNewOrder);
 			SendMessage(*it, FollowOrderMessageType, &data);
 
-			//m_guardedEntrances.insert(std::pair<unsigned long, GuardData>((*it)->GetId(), GuardData(entranceIt->first, entranceIt->second[entranceNumber])));
+			//m_guardedEntrances.insert(std::pair<unsigned long, GuardData>((*it)->GetId(), GuardData(entranceIt->first, entrancePosition)));
 			m_activeOrders.insert(std::pair<unsigned long, Order*>((*it)->GetId(), pNewOrder));
 		}else
 		{
 
 			DefendOrder* order = reinterpret_cast<DefendOrder*>(m_activeOrders.find((*it)->GetId())->second);
-			order->SetDefendPosition(entranceIt->second[entranceNumber]);
+			order->SetDefendPosition(entrancePosition);
 			order->SetViewDirection(viewDirection);
 		}
 
-		m_guardedEntrances.insert(std::pair<unsigned long, GuardData>((*it)->GetId(), GuardData(entranceIt->first, entranceIt->second[entranceNumber])));
+		m_guardedEntrances.insert(std::pair<unsigned long, GuardData>((*it)->GetId(), GuardData(entranceIt->first, entrancePosition)));
 
 		if(++entranceIt == m_pTeamAI->GetTestEnvironment()->GetBaseEntrances(m_pTeamAI->GetTeam()).end())
 		{
@@ -221,11 +221,15 @@ void DistractionBaseAttack::StartDistractionAttack(void)
 			m_activeOrders.erase(m_activeOrders.find((*it)->GetId()));
 
 			// Send out the new move order to attack the enemy flag/base
-			Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, XMFLOAT2(target));
+			MoveOrder* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, XMFLOAT2(target));
 		
 			if(!pNewOrder)
 			{
 				SetFailed(true);
+			}else
+			{
+				// Avoid the grid fields the other attackers pass at the same time
+				GetTeamAI()->CalculateCooperativePath(*it, target, *pNewOrder->GetPath(), GetManoeuvreNameFromType(GetType()));
 			}
 		
 			FollowOrderMessageData data(pNewOrder);
@@ -263,11 +267,15 @@ void DistractionBaseAttack::StartSneakAttack(void)
 			m_activeOrders.erase(m_activeOrders.find((*it)->GetId()));
 
 			// Send out the new move order to attack the enemy flag/base
-			Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, HighPriority, XMFLOAT2(target));
+			MoveOrder* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, HighPriority, XMFLOAT2(target));
 		
 			if(!pNewOrder)
 			{
 				SetFailed(true);
+			}else
+			{
+				// Avoid the grid fields the other attackers pass at the same time
+				GetTeamAI()->CalculateCooperativePath(*it, target, *pNewOrder->GetPath(), GetManoeuvreNameFromType(GetType()));
 			}
 		
 			FollowOrderMessageData data(pNewOrder);
@@ -350,10 +358,10 @@ BehaviourStatus DistractionBaseAttack::Initiate(void)
 
 		if(m_sneakParticipants.find((*it)->GetId()) != m_sneakParticipants.end())
 		{
-			pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, m_sneakAssemblyPoint);
+			pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, m_sneakAssemblyPoint, g_kAssemblyPathSuboptimality);
 		}else
 		{
-			pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, m_distractionAssemblyPoint);
+			pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, m_distractionAssemblyPoint, g_kAssemblyPathSuboptimality);
 		}
 
 		if(!pNewOrder)
@@ -21,9 +21,13 @@ Entity::Entity(void) : CollidableObject(),
 					   m_readyForAttack(false),
 					   m_movementTargetSet(false),
 					   m_movementTarget(0.0f, 0.0f),
+					   m_pathSuboptimality(0.0f),
+					   m_pathfindingAlgorithm(AdaptiveAStar),
 					   m_currentHealth(0.0f),
 					   m_maximalHealth(0.0f),
 					   m_viewDirection(0.0f, 1.0f),
+					   m_pPath(nullptr),
+					   m_pFlowField(nullptr),
 					   m_reportInterval(0.0f),
 					   m_reportTimer(0.0f),
 					   m_doReport(false),
@@ -132,12 +136,15 @@ void Entity::Reset(void)
 	m_readyForAttack		   = false;
 	m_movementTargetSet		   = false;
 	m_movementTarget		   = XMFLOAT2(0.0f, 0.0f);
+	m_pathSuboptimality		   = 0.0f;
+	m_pathfindingAlgorithm	   = AdaptiveAStar;
 	m_attackTargetSet          = false;
 	m_attackTarget		       = XMFLOAT2(0.0f, 0.0f);
 	m_observationTargetSet     = false;
 	m_observationTarget		   = XMFLOAT2(0.0f, 0.0f);
 	m_currentHealth			   = m_maximalHealth;
 	m_isHandicapped			   = false;
+	m_pFlowField			   = nullptr;
 	m_pCurrentOrder			   = nullptr;
 
 	ResetCommunication();
@@ -572,15 +579,19 @@ void Entity::ProcessRespawn(const XMFLOAT2& respawnPosition)
 	m_readyForAttack		   = false;
 	m_movementTargetSet		   = false;
 	m_movementTarget		   = XMFLOAT2(0.0f, 0.0f);
+	m_pathSuboptimality		   = 0.0f;
+	m_pathfindingAlgorithm	   = AdaptiveAStar;
 	m_attackTargetSet          = false;
 	m_attackTarget		       = XMFLOAT2(0.0f, 0.0f);
 	m_observationTargetSet     = false;
 	m_observationTarget		   = XMFLOAT2(0.0f, 0.0f);
 	m_currentHealth			   = m_maximalHealth;
 	m_isHandicapped            = false;
+	m_pFlowField			   = nullptr;
 
 	SetPosition(respawnPosition);
 	UpdateColliderPosition(respawnPosition);
+	m_pEnvironment->UpdateEntityPosition(this);
 	SetRotation(static_cast<float>(rand() % 360));
 }
 
@@ -656,6 +667,16 @@ const XMFLOAT2& Entity::GetMovementTarget(void) const
 	return m_movementTarget;
 }
 
+float Entity::GetPathSuboptimality(void) const
+{
+	return m_pathSuboptimality;
+}
+
+PathfindingAlgorithm Entity::GetPathfindingAlgorithm(void) const
+{
+	return m_pathfindingAlgorithm;
+}
+
 float Entity::GetCurrentHealth(void) const
 {
 	return m_currentHealth;
@@ -688,7 +709,7 @@ const XMFLOAT2& Entity::GetObservationTarget(void) const
 
 bool Entity::IsPathSet(void) const
 {
-	return m_pPath != nullptr;
+	return m_pPath != nullptr || m_pFlowField != nullptr;
 }
 
 std::vector<XMFLOAT2>* Entity::GetPath(void)
@@ -696,6 +717,11 @@ std::vector<XMFLOAT2>* Entity::GetPath(void)
 	return m_pPath;
 }
 
+const FlowField* Entity::GetFlowField(void) const
+{
+	return m_pFlowField;
+}
+
 float Entity::GetReportInterval(void) const
 {
 	return m_reportInterval;
@@ -764,6 +790,16 @@ void Entity::SetMovementTarget(const XMFLOAT2& target)
 	m_movementTarget = target;
 }
 
+void Entity::SetPathSuboptimality(float suboptimality)
+{
+	m_pathSuboptimality = suboptimality;
+}
+
+void Entity::SetPathfindingAlgorithm(PathfindingAlgorithm algorithm)
+{
+	m_pathfindingAlgorithm = algorithm;
+}
+
 void Entity::SetCurrentHealth(float health)
 {
 	m_currentHealth = health;
@@ -794,6 +830,11 @@ void Entity::SetPath(std::vector<XMFLOAT2>* pPath)
 	m_pPath = pPath;
 }
 
+void Entity::SetFlowField(const FlowField* pFlowField)
+{
+	m_pFlowField = pFlowField;
+}
+
 void Entity::SetReportInterval(float reportInterval)
 {
 	m_reportInterval = reportInterval;
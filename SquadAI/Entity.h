@@ -12,6 +12,7 @@
 #include <DirectXMath.h>
 #include <vector>
 #include <queue>
+#include <unordered_map>
 #include "CollidableObject.h"
 #include "ObjectTypes.h"
 #include "Behaviour.h"
@@ -23,6 +24,7 @@
 class TestEnvironment;
 class TeamAI;
 class Message;
+struct FlowField;
 
 //--------------------------------------------------------------------------------------
 // Bundles information associated to a known threat to an entity.
@@ -117,6 +119,8 @@ public:
 	const XMFLOAT2&						GetAttackTarget(void) const;
 	bool								IsMovementTargetSet(void) const;
 	const XMFLOAT2&						GetMovementTarget(void) const;
+	float								GetPathSuboptimality(void) const;
+	PathfindingAlgorithm				GetPathfindingAlgorithm(void) const;
 	float								GetCurrentHealth(void) const;
 	float								GetMaximalHealth(void) const;
 	const XMFLOAT2&						GetViewDirection(void) const;
@@ -126,6 +130,7 @@ public:
 	const XMFLOAT2&						GetObservationTarget(void) const;
 	bool                                IsPathSet(void) const;
 	std::vector<XMFLOAT2>*              GetPath(void);
+	const FlowField*                    GetFlowField(void) const;
 	float								GetReportInterval(void) const;
 
 	bool IsHandicapped(void) const;
@@ -141,6 +146,8 @@ public:
 	void SetAttackTarget(const XMFLOAT2& target);
 	void SetMovementTargetSet(bool targetSet);
 	void SetMovementTarget(const XMFLOAT2& target);
+	void SetPathSuboptimality(float suboptimality);
+	void SetPathfindingAlgorithm(PathfindingAlgorithm algorithm);
 	void SetCurrentHealth(float health);
 	void SetMaximalHealth(float maxHealth);
 	void SetViewDirection(const XMFLOAT2& direction);
@@ -148,6 +155,7 @@ public:
 	void SetObservationTargetSet(bool targetSet);
 	void SetObservationTarget(const XMFLOAT2& target);
 	void SetPath(std::vector<XMFLOAT2>* pPath);
+	void SetFlowField(const FlowField* pFlowField);
 	void SetReportInterval(float reportInterval);
 
 	void SetHandicap(bool isHandicapped);
@@ -220,6 +228,21 @@ public:
 		XMFLOAT2 m_target;
 	};
 
+	//--------------------------------------------------------------------------------------
+	// Functor used to sort entities by the costs of their paths to a common target.
+	//--------------------------------------------------------------------------------------
+	class CompareEntityByPathCost
+	{
+	public:
+		CompareEntityByPathCost(const std::unordered_map<unsigned long, float>& pathCosts) : m_pPathCosts(&pathCosts){}
+		bool operator()(const Entity* pLeft, const Entity* pRight)
+		{
+			return m_pPathCosts->at(pLeft->GetId()) < m_pPathCosts->at(pRight->GetId());
+		}
+	private:
+		const std::unordered_map<unsigned long, float>* m_pPathCosts; // The path cost of each entity, indexed by entity id
+	};
+
 	virtual void ProcessEvent(EventType type, void* pEventData);
 
 protected:
@@ -254,6 +277,8 @@ private:
 	bool						 m_readyForAttack;			 // Tells whether the entity is ready for attack
 	bool						 m_movementTargetSet;		 // Tells whether there is a movement target set or not
 	XMFLOAT2			         m_movementTarget;			 // The position to move to
+	float						 m_pathSuboptimality;		 // How much more than the shortest one the path to the movement target may cost (0.5 -> 50%)
+	PathfindingAlgorithm		 m_pathfindingAlgorithm;	 // The algorithm used to search the path to the movement target
 	bool						 m_attackTargetSet;			 // Tells whether an attack target was set
 	XMFLOAT2                     m_attackTarget;			 // The position to attack
 	float						 m_currentHealth;			 // The current health state of the entity (percentage between 0.0 and 1.0 in relation to maximal health)
@@ -262,6 +287,7 @@ private:
 	XMFLOAT2                     m_viewDirection;            // The direction the entity is currently looking at
 
 	std::vector<XMFLOAT2>*       m_pPath;                    // The path to the current movement target
+	const FlowField*             m_pFlowField;               // The flow field leading to the current movement target, used instead of the path if set
 	XMFLOAT2			         m_observationTarget;		 // The position to observe while holding a position
 	bool						 m_observationTargetSet;	 // Tells whether an observation target was set
 	float                        m_reportInterval;           // Determines at which interval the entity will report updates to the team AI associated to it
@@ -9,14 +9,18 @@
 #include "EntityMovementManager.h"
 #include "Entity.h"
 #include "Pathfinder.h"
+#include "FlowFieldManager.h"
 #include "TestEnvironment.h"
 
 EntityMovementManager::EntityMovementManager(void) : m_pEntity(nullptr),
 												  	 m_pEnvironment(nullptr),
 													 m_velocity(XMFLOAT2(0.0f, 0.0f)),
 													 m_steeringForce(0.0f, 0.0f),
+													 m_searchTarget(0.0f, 0.0f),
+													 m_searchAlgorithm(AdaptiveAStar),
 													 m_currentNode(0),
-													 m_seekTarget(0.0f, 0.0f)
+													 m_seekTarget(0.0f, 0.0f),
+													 m_waitTime(0.0f)
 {
 }
 
@@ -116,6 +120,7 @@ void EntityMovementManager::UpdatePosition(float deltaTime, float maxSpeed, floa
 
 	m_pEntity->SetPosition(newPosition);
 	m_pEntity->UpdateColliderPosition(newPosition);
+	m_pEnvironment->UpdateEntityPosition(m_pEntity);
 
 	// Update the rotation to make the entity face the direction, in which it is moving
 	if(!(newVelocity.x == 0.0f && newVelocity.y == 0.0f))
@@ -138,26 +143,70 @@ void EntityMovementManager::Reset(void)
 	m_path.clear();
 	m_velocity = XMFLOAT2(0.0f, 0.0f);
 	m_currentNode = 0;
+	m_waitTime = 0.0f;
+	m_searchContext.GetPendingSearch().m_isPending = false;
 }
 
 //--------------------------------------------------------------------------------------
-// Calculate a path to the target position.
+// Calculates a path to the target position using a time-sliced search. A search that does
+// not complete within the budget is continued by the next request for the same target,
+// requesting another target discards it. Consecutive searches use adaptive A* to learn from
+// each other, which keeps replanning cheap while chasing a moving target. Requests accepting
+// suboptimal paths use weighted A* instead. Long queries can use HPA* or bidirectional A*,
+// which complete within a single slice.
 // Param1: The target position of the path.
-// Returns a pointer to the path that was created, nullptr if no path exists.
+// Param2: The algorithm to use, AdaptiveAStar unless the query is known to be long.
+// Param3: The suboptimality bound epsilon, the path will cost at most (1 + epsilon) times as much
+//         as the shortest one.
+// Param4: The maximal number of nodes to expand, reduced by the number of expanded nodes.
+// Param5: Will point to the path that was created, nullptr if there is none (yet).
+// Returns SearchSucceeded if the path was created, SearchFailed if there is no path to the target
+// and SearchPending if the search has to be continued in a later frame.
 //--------------------------------------------------------------------------------------
-std::vector<XMFLOAT2>* EntityMovementManager::CreatePathTo(const XMFLOAT2& targetPosition)
+PathSearchStatus EntityMovementManager::RequestPathTo(const XMFLOAT2& targetPosition, PathfindingAlgorithm algorithm, float suboptimality, unsigned int& expansionBudget, std::vector<XMFLOAT2>*& pPath)
 {
-	bool result = false;
-	result = m_pEnvironment->GetPathfinder().CalculatePath(AStar, EuclideanDistance, m_pEntity->GetPosition(), targetPosition, m_path);
+	PathSearchStatus status = SearchFailed;
 
-	if(result)
+	if(m_searchContext.GetPendingSearch().m_isPending && m_searchTarget.x == targetPosition.x && m_searchTarget.y == targetPosition.y &&
+	   m_searchAlgorithm == algorithm && m_searchContext.GetPendingSearch().m_suboptimality == suboptimality)
+	{
+		status = m_pEnvironment->GetPathfinder().ContinuePathSearch(m_path, m_searchContext, expansionBudget);
+	}else
+	{
+		m_searchTarget	  = targetPosition;
+		m_searchAlgorithm = algorithm;
+		status = m_pEnvironment->GetPathfinder().StartPathSearch(algorithm, EuclideanDistance, suboptimality, m_pEntity->GetPosition(), targetPosition, m_path, m_searchContext, expansionBudget);
+	}
+
+	if(status == SearchSucceeded)
 	{
 		m_currentNode = 0;
-		return &m_path;
+		pPath = &m_path;
 	}else
+	{
+		pPath = nullptr;
+	}
+
+	return status;
+}
+
+//--------------------------------------------------------------------------------------
+// Looks up a flow field leading to the target position. Flow fields are only available for
+// the strategic targets of the test environment.
+// Param1: The target position.
+// Returns a pointer to the flow field, nullptr if there is none or the target cannot be reached
+// from the current position of the entity.
+//--------------------------------------------------------------------------------------
+const FlowField* EntityMovementManager::GetFlowFieldTo(const XMFLOAT2& targetPosition) const
+{
+	const FlowField* pFlowField = m_pEnvironment->GetFlowFieldManager().GetFlowField(targetPosition);
+
+	if(!pFlowField || !pFlowField->IsReachable(GetCurrentGridNodeId()))
 	{
 		return nullptr;
 	}
+
+	return pFlowField;
 }
 
 //--------------------------------------------------------------------------------------
@@ -228,9 +277,10 @@ void EntityMovementManager::Wait()
 // Param1: A pointer to the path to follow.
 // Param2: When the entity has approached the target by this distance, it counts as reached.
 // Param3: The speed, at which the entity should follow the path.
+// Param4: The time in seconds passed since the last frame.
 // Returns true if the end of the current path was reached, false if there is still way to go.
 //--------------------------------------------------------------------------------------
-bool EntityMovementManager::FollowPath(std::vector<XMFLOAT2>* pPath, float nodeReachedRadius, float speed)
+bool EntityMovementManager::FollowPath(std::vector<XMFLOAT2>* pPath, float nodeReachedRadius, float speed, float deltaTime)
 {
 	if(!pPath)
 	{
@@ -248,6 +298,20 @@ bool EntityMovementManager::FollowPath(std::vector<XMFLOAT2>* pPath, float nodeR
 
 		if(distance <= nodeReachedRadius)
 		{
+			if(m_currentNode + 1 < pPath->size() && (*pPath)[m_currentNode + 1].x == target.x && (*pPath)[m_currentNode + 1].y == target.y)
+			{
+				// A repeated node of a cooperative path, wait as long as it takes to cross a grid field
+				m_waitTime += deltaTime;
+
+				if(m_waitTime < m_pEnvironment->GetGridSpacing() / speed)
+				{
+					Wait();
+					return false;
+				}
+
+				m_waitTime = 0.0f;
+			}
+
 			// The entity has reached the node
 			++m_currentNode;
 
@@ -273,6 +337,61 @@ bool EntityMovementManager::FollowPath(std::vector<XMFLOAT2>* pPath, float nodeR
 	return true;
 }
 
+//--------------------------------------------------------------------------------------
+// Calculate the path following force for a flow field and add it to the total force. The
+// entity seeks the next node stored for the grid field it is in, the target itself is 
+// approached directly once the entity has reached its grid field.
+// Param1: A pointer to the flow field to follow.
+// Param2: The target position, has to lie in the target grid field of the flow field.
+// Param3: When the entity has approached the target by this distance, it counts as reached.
+// Param4: The speed, at which the entity should follow the flow field.
+// Returns true if the target was reached, false if there is still way to go.
+//--------------------------------------------------------------------------------------
+bool EntityMovementManager::FollowPath(const FlowField* pFlowField, const XMFLOAT2& targetPosition, float nodeReachedRadius, float speed)
+{
+	if(!pFlowField)
+	{
+		return false;
+	}
+
+	unsigned long currentId = GetCurrentGridNodeId();
+
+	if(currentId == pFlowField->m_targetId || !pFlowField->IsReachable(currentId))
+	{
+		// Final approach, or the entity was pushed off the field (e.g. by separation), head for the target directly
+		if(Seek(targetPosition, nodeReachedRadius, speed))
+		{
+			m_velocity = XMFLOAT2(0.0f, 0.0f);
+			return true;
+		}
+
+		return false;
+	}
+
+	unsigned long nextId = pFlowField->m_nextNodeIds[currentId];
+	XMFLOAT2 target = m_pEnvironment->GetNodeById(nextId)->GetWorldPosition();
+
+	// Skip nodes that already count as reached to avoid slowing down at every grid field
+	float distance = 0.0f;
+	XMStoreFloat(&distance, XMVector2Length(XMLoadFloat2(&target) - XMLoadFloat2(&m_pEntity->GetPosition())));
+
+	while(distance <= nodeReachedRadius && nextId != pFlowField->m_targetId)
+	{
+		nextId = pFlowField->m_nextNodeIds[nextId];
+		target = m_pEnvironment->GetNodeById(nextId)->GetWorldPosition();
+		XMStoreFloat(&distance, XMVector2Length(XMLoadFloat2(&target) - XMLoadFloat2(&m_pEntity->GetPosition())));
+	}
+
+	if(nextId == pFlowField->m_targetId)
+	{
+		target = targetPosition;
+	}
+
+	Seek(target, nodeReachedRadius, speed);
+
+	return false;
+}
+
 //--------------------------------------------------------------------------------------
 // Calculate the collision avoidance force and add it to the total force. This force 
 // is used to avoid collisions of an entity with static obstacles in the environment and
@@ -287,24 +406,30 @@ void EntityMovementManager::AvoidCollisions(float seeAheadDistance, float maxima
 		return;
 	}
 
-	std::multimap<float, CollidableObject*> nearbyObjects;
-	m_pEnvironment->GetNearbyObjects(m_pEntity->GetPosition(), seeAheadDistance, GroupAllSoldiersAndObstacles, nearbyObjects);
+	NearbyObjectsFilter filter;
+	filter.m_includeObstacles = true;
+	filter.m_excludedId		  = m_pEntity->GetId();
+
+	m_pEnvironment->GetNearbyObjects(m_pEntity->GetPosition(), seeAheadDistance, filter, m_nearbyObjects);
 
-	// One element is entity itself -> Check if there are more than one
-	if(nearbyObjects.size() > 1)
+	if(!m_nearbyObjects.IsEmpty())
 	{
+		// The closest collision is avoided, thus the objects have to be checked by increasing distance
+		m_nearbyObjects.SortByDistance();
+
 		XMFLOAT2 lineEndPoint(0.0f, 0.0f);
 		XMStoreFloat2(&lineEndPoint, XMLoadFloat2(&m_pEntity->GetPosition()) + XMVector2Normalize(XMLoadFloat2(&m_pEntity->GetViewDirection())) * seeAheadDistance);
 
-		for(std::multimap<float, CollidableObject*>::iterator it = nearbyObjects.begin(); it != nearbyObjects.end(); ++it)
+		for(unsigned int i = 0; i < m_nearbyObjects.GetSize(); ++i)
 		{
-			
-			if((it->second->GetId() != m_pEntity->GetId()) && reinterpret_cast<CollidableObject*>(it->second)->GetCollider()->CheckLineCollision(m_pEntity->GetPosition(), lineEndPoint))
+			CollidableObject* pObject = m_nearbyObjects.GetNearbyObject(i).m_pObject;
+
+			if(pObject->GetCollider()->CheckLineCollision(m_pEntity->GetPosition(), lineEndPoint))
 			{
 				// Determine whether the other entity is left or right of this entity
 
 				XMFLOAT2 entityToObject(0.0f, 0.0f);
-				XMStoreFloat2(&entityToObject, XMLoadFloat2(&it->second->GetPosition()) - XMLoadFloat2(&m_pEntity->GetPosition()));
+				XMStoreFloat2(&entityToObject, XMLoadFloat2(&pObject->GetPosition()) - XMLoadFloat2(&m_pEntity->GetPosition()));
 
 				float dot = m_pEntity->GetViewDirection().x * (-entityToObject.y) + m_pEntity->GetViewDirection().y * entityToObject.x;	
 					
@@ -344,18 +469,23 @@ void EntityMovementManager::StayAwayFromWalls(float avoidWallsRadius, float maxi
 {
 	// Get nearby obstacles
 
-	std::multimap<float, CollidableObject*> nearbyObjects;
-	m_pEnvironment->GetNearbyObjects(m_pEntity->GetPosition(), avoidWallsRadius, GroupObstacles, nearbyObjects);
+	NearbyObjectsFilter filter;
+	filter.m_includeEntities  = false;
+	filter.m_includeObstacles = true;
+
+	m_pEnvironment->GetNearbyObjects(m_pEntity->GetPosition(), avoidWallsRadius, filter, m_nearbyObjects);
 
-	if(!nearbyObjects.empty())
+	if(!m_nearbyObjects.IsEmpty())
 	{
 		XMVECTOR avoidanceForce = XMVectorZero();
 
-		for(std::multimap<float, CollidableObject*>::iterator it = nearbyObjects.begin(); it != nearbyObjects.end(); ++it)
+		for(unsigned int i = 0; i < m_nearbyObjects.GetSize(); ++i)
 		{
+			const NearbyObject& nearbyObject = m_nearbyObjects.GetNearbyObject(i);
+
 			// Scale the force according to the proximity of the nearby entity. Thus the push from close objects will be
 			// stronger than that from objects that are farther away.
-			avoidanceForce += (XMLoadFloat2(&m_pEntity->GetPosition()) - XMLoadFloat2(&(it->second->GetPosition()))) / it->first;
+			avoidanceForce += (XMLoadFloat2(&m_pEntity->GetPosition()) - XMLoadFloat2(&(nearbyObject.m_pObject->GetPosition()))) / nearbyObject.m_squareDistance;
 		}
 
 		// Truncate the force according to the maximally allowed wall avoidance force.
@@ -377,24 +507,24 @@ void EntityMovementManager::Separate(float separationRadius, float maximalForce)
 
 	// Find the moving entities that are in close proximity to this one (check both teams)
 
-	std::multimap<float, CollidableObject*> nearbySoldiers;
-	m_pEnvironment->GetNearbyObjects(m_pEntity->GetPosition(), separationRadius, GroupAllSoldiers, nearbySoldiers);
+	NearbyObjectsFilter filter;
+	filter.m_excludedId = m_pEntity->GetId();
+
+	m_pEnvironment->GetNearbyObjects(m_pEntity->GetPosition(), separationRadius, filter, m_nearbyObjects);
 
-	// The entity itself will be included in the list of soldiers -> check if there are others as well
-	if(nearbySoldiers.size() > 1)
+	if(!m_nearbyObjects.IsEmpty())
 	{
-		for(std::multimap<float, CollidableObject*>::const_iterator it = nearbySoldiers.begin(); it !=  nearbySoldiers.end(); ++it)
+		for(unsigned int i = 0; i < m_nearbyObjects.GetSize(); ++i)
 		{
-			if(it->second->GetId() != m_pEntity->GetId())
-			{
-				// Scale the force according to the proximity of the nearby entity. Thus the push from close objects will be
-				// stronger than that from objects that are farther away.
+			const NearbyObject& nearbyObject = m_nearbyObjects.GetNearbyObject(i);
 
-				// Avoid possible division by zero
-				float proximity = (it->first != 0) ? it->first : 0.01f;
+			// Scale the force according to the proximity of the nearby entity. Thus the push from close objects will be
+			// stronger than that from objects that are farther away.
 
-				separationVector += (XMLoadFloat2(&m_pEntity->GetPosition()) - XMLoadFloat2(&it->second->GetPosition())) / proximity;
-			}
+			// Avoid possible division by zero
+			float proximity = (nearbyObject.m_squareDistance != 0) ? nearbyObject.m_squareDistance : 0.01f;
+
+			separationVector += (XMLoadFloat2(&m_pEntity->GetPosition()) - XMLoadFloat2(&nearbyObject.m_pObject->GetPosition())) / proximity;
 		}
 
 		// Truncate the force according to the maximally allowed separation force.
@@ -405,6 +535,22 @@ void EntityMovementManager::Separate(float separationRadius, float maximalForce)
 	}
 }
 
+//--------------------------------------------------------------------------------------
+// Determines the node of the grid field the entity is currently in.
+// Returns the id of the node.
+//--------------------------------------------------------------------------------------
+unsigned long EntityMovementManager::GetCurrentGridNodeId(void) const
+{
+	XMFLOAT2 gridPosition;
+	m_pEnvironment->WorldToGridPosition(m_pEntity->GetPosition(), gridPosition);
+
+	unsigned int maxIndex = m_pEnvironment->GetNumberOfGridPartitions() - 1;
+	unsigned int gridX	  = (gridPosition.x < 0.0f) ? 0 : std::min(static_cast<unsigned int>(gridPosition.x), maxIndex);
+	unsigned int gridY	  = (gridPosition.y < 0.0f) ? 0 : std::min(static_cast<unsigned int>(gridPosition.y), maxIndex);
+
+	return m_pEnvironment->GetNode(gridX, gridY)->GetId();
+}
+
 // Data access functions
 
 const XMFLOAT2& EntityMovementManager::GetVelocity(void) const
@@ -420,4 +566,9 @@ unsigned int EntityMovementManager::GetCurrentNode(void) const
 void EntityMovementManager::SetCurrentNode(unsigned int node)
 {
 	m_currentNode = node;
-}
\ No newline at end of file
+}
+
+void EntityMovementManager::SetSearchCallerTag(const char* pCallerTag)
+{
+	m_searchContext.SetCallerTag(pCallerTag);
+}
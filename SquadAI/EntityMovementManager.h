@@ -12,10 +12,13 @@
 #include <DirectXMath.h>
 #include <vector>
 #include <map>
+#include "SearchContext.h"
+#include "NearbyObjects.h"
 
 // Forward declarations
 class Entity;
 class TestEnvironment;
+struct FlowField;
 
 using namespace DirectX;
 
@@ -29,10 +32,12 @@ public:
 	void UpdatePosition(float deltaTime, float maxSpeed, float maxForce, float handicap);
 	void Reset(void);
 
-	std::vector<XMFLOAT2>* CreatePathTo(const XMFLOAT2& targetPosition);
+	PathSearchStatus	   RequestPathTo(const XMFLOAT2& targetPosition, PathfindingAlgorithm algorithm, float suboptimality, unsigned int& expansionBudget, std::vector<XMFLOAT2>*& pPath);
+	const FlowField*	   GetFlowFieldTo(const XMFLOAT2& targetPosition) const;
 
 	bool Seek(const XMFLOAT2& targetPosition, float targetReachedRadius, float speed);
-	bool FollowPath(std::vector<XMFLOAT2>* pPath, float nodeReachedRadius, float speed);
+	bool FollowPath(std::vector<XMFLOAT2>* pPath, float nodeReachedRadius, float speed, float deltaTime);
+	bool FollowPath(const FlowField* pFlowField, const XMFLOAT2& targetPosition, float nodeReachedRadius, float speed);
 	void LookAt(const XMFLOAT2& targetPosition);
 	void Wait();
 	
@@ -46,18 +51,25 @@ public:
 
 	unsigned int GetCurrentNode(void) const;
 	void SetCurrentNode(unsigned int node);
+	void SetSearchCallerTag(const char* pCallerTag);
 
 private:
 
-	void SetInitialViewDirection(void);
+	void		  SetInitialViewDirection(void);
+	unsigned long GetCurrentGridNodeId(void) const;
 
 	Entity*				  m_pEntity;       // The entity that this movement manager is associated to
 	TestEnvironment*	  m_pEnvironment;  // The test environment that the entity is part of
 	XMFLOAT2			  m_velocity;      // The initial velocity of the entity
 	XMFLOAT2			  m_steeringForce; // The accumulated force that will be applied to the entity
 	std::vector<XMFLOAT2> m_path;          // The current path of the entity, empty when no destination for pathfinding
+	SearchContext         m_searchContext; // Holds the scratch data for the path searches of this entity
+	XMFLOAT2              m_searchTarget;  // The target of the time-sliced path search pending in the search context, if any
+	PathfindingAlgorithm  m_searchAlgorithm; // The algorithm requested for the pending path search
 	unsigned int          m_currentNode;   // The current target node within the path vector
 	XMFLOAT2              m_seekTarget;	   // The current target to seek
+	float				  m_waitTime;	   // The time in seconds the entity has been waiting at the current node of a cooperative path
+	NearbyObjects		  m_nearbyObjects; // Receives the results of the proximity queries of the steering behaviours, reused for every query
 };
 
 #endif // ENTITY_MOVEMENT_MANAGER_H
\ No newline at end of file
@@ -48,55 +48,63 @@ bool EntitySensors::Initialise(Entity* pEntity, TestEnvironment* pTestEnvironmen
 //--------------------------------------------------------------------------------------
 void EntitySensors::CheckForThreats(const XMFLOAT2& viewDirection, float viewingRange, float fieldOfView)
 {
-	// Find nearby hostile entities.
+	// Find hostile entities that might be visible. Usually range and field of view of all soldiers were already
+	// tested at the start of the frame, otherwise find the enemies in range here and test the field of view below.
 
-	std::multimap<float, CollidableObject*> enemies;
+	bool areEnemiesInRange   = false;
+	bool isFieldOfViewTested = m_pEnvironment->GetFieldOfViewCandidates(m_pEntity, m_nearbyEnemies, areEnemiesInRange);
 
-	if(m_pEntity->GetTeam() == TeamRed)
+	if(!isFieldOfViewTested)
 	{
-		m_pEnvironment->GetNearbyObjects(m_pEntity->GetPosition(), viewingRange, GroupTeamBlue, enemies);
-	}else
-	{
-		m_pEnvironment->GetNearbyObjects(m_pEntity->GetPosition(), viewingRange, GroupTeamRed, enemies);
+		NearbyObjectsFilter filter;
+		filter.m_team = (m_pEntity->GetTeam() == TeamRed) ? TeamBlue : TeamRed;
+
+		m_pEnvironment->GetNearbyObjects(m_pEntity->GetPosition(), viewingRange, filter, m_nearbyEnemies);
+
+		areEnemiesInRange = !m_nearbyEnemies.IsEmpty();
 	}
 
-	if(!enemies.empty())
+	if(areEnemiesInRange)
 	{
-		std::vector<Entity*> newKnownThreats;
-
-		XMFLOAT2 gridPos;
-		m_pEnvironment->WorldToGridPosition(m_pEntity->GetPosition(), gridPos);
+		// The vector keeps its capacity, no memory is allocated once it is large enough
+		m_newKnownThreats.clear();
 
 		// Get the vector that represents the direction the entity is looking to
 		XMFLOAT2 viewVector;
 		XMStoreFloat2(&viewVector, XMLoadFloat2(&viewDirection));
 
-		for(std::multimap<float, CollidableObject*>::iterator it = enemies.begin(); it != enemies.end(); ++it)
+		for(unsigned int i = 0; i < m_nearbyEnemies.GetSize(); ++i)
 		{
-			// Check if enemy is within line of sight and within visibiliy range
-			if(reinterpret_cast<Entity*>(it->second)->IsAlive())
+			Entity* pEnemy = static_cast<Entity*>(m_nearbyEnemies.GetNearbyObject(i).m_pObject);
+
+			// Candidates may have been killed since the start of the frame
+			if(!pEnemy->IsAlive())
+			{
+				continue;
+			}
+
+			if(!isFieldOfViewTested)
 			{
 				// Get the vector from the entity to the enemy
 				XMFLOAT2 toEnemyVector;
-				XMStoreFloat2(&toEnemyVector, XMLoadFloat2(&it->second->GetPosition()) - XMLoadFloat2(&m_pEntity->GetPosition()));
+				XMStoreFloat2(&toEnemyVector, XMLoadFloat2(&pEnemy->GetPosition()) - XMLoadFloat2(&m_pEntity->GetPosition()));
 
 				// Get the angle between the vectors
 				float angle = 0.0f;
 				XMStoreFloat(&angle, XMVector2AngleBetweenVectors(XMLoadFloat2(&viewVector), XMLoadFloat2(&toEnemyVector)));
 				
 				// Check if enemy is in field of view
-				if(abs(angle) <= fieldOfView)
+				if(abs(angle) > fieldOfView)
 				{
-					XMFLOAT2 enemyGridPos;
-					m_pEnvironment->WorldToGridPosition(it->second->GetPosition(), enemyGridPos);
-
-					// Check if enemy is visible or hidden behind an obstacle
-					if(m_pEnvironment->CheckLineOfSight(m_pEntity->GetPosition(), it->second->GetPosition()))
-					{
-						// Remember this enemy as a known threat
-						newKnownThreats.push_back(reinterpret_cast<Entity*>(it->second));
-					}
-				}	
+					continue;
+				}
+			}
+
+			// Check if enemy is visible or hidden behind an obstacle
+			if(m_pEnvironment->CheckVisibility(m_pEntity->GetPosition(), pEnemy->GetPosition()))
+			{
+				// Remember this enemy as a known threat
+				m_newKnownThreats.push_back(pEnemy);
 			}
 		}
 
@@ -108,8 +116,8 @@ void EntitySensors::CheckForThreats(const XMFLOAT2& viewDirection, float viewing
 		std::vector<KnownThreat>::iterator it = m_pEntity->GetKnownThreats().begin();
 		while(it != m_pEntity->GetKnownThreats().end())
 		{
-			std::vector<Entity*>::const_iterator foundIt = std::find_if(newKnownThreats.begin(), newKnownThreats.end(), Entity::FindEntityById(it->m_pEntity->GetId()));
-			if(foundIt == newKnownThreats.end())
+			std::vector<Entity*>::const_iterator foundIt = std::find_if(m_newKnownThreats.begin(), m_newKnownThreats.end(), Entity::FindEntityById(it->m_pEntity->GetId()));
+			if(foundIt == m_newKnownThreats.end())
 			{
 				if(it->m_pEntity->IsAlive() && !m_pEntity->IsSuspectedThreat(it->m_pEntity->GetId()))
 				{
@@ -129,7 +137,7 @@ void EntitySensors::CheckForThreats(const XMFLOAT2& viewDirection, float viewing
 		}
 		
 		// Set new known threats
-		for(std::vector<Entity*>::iterator it = newKnownThreats.begin(); it != newKnownThreats.end(); ++it)
+		for(std::vector<Entity*>::iterator it = m_newKnownThreats.begin(); it != m_newKnownThreats.end(); ++it)
 		{
 			// Check if the threat was known before
 			if(!m_pEntity->IsKnownThreat((*it)->GetId()))
@@ -12,6 +12,7 @@
 #include <DirectXMath.h>
 #include <vector>
 #include <algorithm>
+#include "NearbyObjects.h"
 
 // Forward declarations
 class Entity;
@@ -32,6 +33,9 @@ public:
 private:
 	Entity*          m_pEntity;      // The entity object associated to this sensors component
 	TestEnvironment* m_pEnvironment; // The test environment, to which the entity belongs
+
+	NearbyObjects		 m_nearbyEnemies;	// Receives the enemies within viewing range, reused for every check
+	std::vector<Entity*> m_newKnownThreats; // The enemies seen during the current check, reused for every check
 };
 
 #endif // ENTITY_SENSORS_H
\ No newline at end of file
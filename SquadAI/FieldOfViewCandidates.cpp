@@ -0,0 +1,265 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  FieldOfViewCandidates.cpp
+*  Determines once per frame which enemies are within viewing range and field of view of each
+*  soldier. The positions and view directions of all soldiers are laid out as structure of arrays
+*  and all observer/target pairs are tested at once, four targets at a time using SSE where available.
+*  The cone test compares the dot product against the cosine of the field of view, squared to avoid
+*  square roots and trigonometry. The results are bitsets of candidates per observer, only these
+*  candidates are passed on to the expensive line of sight test.
+*/
+
+// Includes
+#include <cmath>
+#include <cfloat>
+#include "FieldOfViewCandidates.h"
+#include "Soldier.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FIELD_OF_VIEW_USE_SSE
+#endif
+
+FieldOfViewCandidates::FieldOfViewCandidates(void) : m_numberOfSoldiers(0),
+													 m_numberOfWords(0)
+{
+}
+
+FieldOfViewCandidates::~FieldOfViewCandidates(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Gathers the current positions, view directions and sensor properties of the soldiers
+// and determines the candidates of each soldier. To be called once per frame, before the
+// soldiers are updated.
+// Param1: The soldiers of all teams.
+// Param2: The number of soldiers.
+//--------------------------------------------------------------------------------------
+void FieldOfViewCandidates::Update(const Soldier* pSoldiers, unsigned int numberOfSoldiers)
+{
+	unsigned int paddedNumberOfSoldiers = (numberOfSoldiers + 3) & ~3u;
+
+	m_numberOfSoldiers = numberOfSoldiers;
+	m_numberOfWords	   = (numberOfSoldiers + 31) / 32;
+
+	// Padding targets are placed infinitely far away, thus never in range. The vectors keep their
+	// capacity, after the first frame no memory is allocated.
+	m_positionsX.assign(paddedNumberOfSoldiers, FLT_MAX);
+	m_positionsY.assign(paddedNumberOfSoldiers, FLT_MAX);
+	m_viewDirectionsX.resize(numberOfSoldiers);
+	m_viewDirectionsY.resize(numberOfSoldiers);
+	m_squareViewingRanges.resize(numberOfSoldiers);
+	m_coneThresholds.resize(numberOfSoldiers);
+	m_isWideFieldOfView.resize(numberOfSoldiers);
+	m_teams.resize(numberOfSoldiers);
+	m_teamMembers.assign((NumberOfTeams - 1) * m_numberOfWords, 0);
+	m_candidates.assign(numberOfSoldiers * m_numberOfWords, 0);
+	m_enemiesInRange.assign(numberOfSoldiers * m_numberOfWords, 0);
+
+	for(unsigned int i = 0; i < numberOfSoldiers; ++i)
+	{
+		const Soldier& soldier = pSoldiers[i];
+
+		if(soldier.GetId() >= m_observerIndices.size())
+		{
+			m_observerIndices.resize(soldier.GetId() + 1, g_kNoFieldOfViewObserver);
+		}
+
+		m_observerIndices[soldier.GetId()] = i;
+
+		m_positionsX[i]		 = soldier.GetPosition().x;
+		m_positionsY[i]		 = soldier.GetPosition().y;
+		m_viewDirectionsX[i] = soldier.GetViewDirection().x;
+		m_viewDirectionsY[i] = soldier.GetViewDirection().y;
+		m_teams[i]			 = soldier.GetTeam();
+
+		m_squareViewingRanges[i] = soldier.GetViewingDistance() * soldier.GetViewingDistance();
+
+		// A target is in the field of view when dot(view, toTarget) >= cos(fov) * |view| * |toTarget|,
+		// both sides are squared to get rid of the lengths
+		float cosine		   = cos(soldier.GetFieldOfView());
+		float squareViewLength = m_viewDirectionsX[i] * m_viewDirectionsX[i] + m_viewDirectionsY[i] * m_viewDirectionsY[i];
+
+		m_coneThresholds[i]	   = cosine * cosine * squareViewLength;
+		m_isWideFieldOfView[i] = cosine < 0.0f;
+
+		if(soldier.IsAlive() && soldier.GetTeam() < NumberOfTeams - 1)
+		{
+			m_teamMembers[soldier.GetTeam() * m_numberOfWords + i / 32] |= 1u << (i % 32);
+		}
+	}
+
+	CalculateCandidates();
+}
+
+//--------------------------------------------------------------------------------------
+// Removes all candidates, for instance at the end of a match.
+//--------------------------------------------------------------------------------------
+void FieldOfViewCandidates::Clear(void)
+{
+	m_numberOfSoldiers = 0;
+	m_numberOfWords	   = 0;
+	m_candidates.clear();
+	m_enemiesInRange.clear();
+	m_observerIndices.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// Tests all observer/target pairs for range and field of view and stores the bitsets
+// of the candidates. Only living enemies of living observers become candidates.
+//--------------------------------------------------------------------------------------
+void FieldOfViewCandidates::CalculateCandidates(void)
+{
+	unsigned int paddedNumberOfSoldiers = static_cast<unsigned int>(m_positionsX.size());
+
+	for(unsigned int observer = 0; observer < m_numberOfSoldiers; ++observer)
+	{
+		if(m_teams[observer] >= NumberOfTeams - 1 || !(m_teamMembers[m_teams[observer] * m_numberOfWords + observer / 32] & (1u << (observer % 32))))
+		{
+			// Dead observers cannot see anything
+			continue;
+		}
+
+		unsigned int* pWords	  = &m_candidates[observer * m_numberOfWords];
+		unsigned int* pRangeWords = &m_enemiesInRange[observer * m_numberOfWords];
+
+		float observerX	 = m_positionsX[observer];
+		float observerY	 = m_positionsY[observer];
+		float viewX		 = m_viewDirectionsX[observer];
+		float viewY		 = m_viewDirectionsY[observer];
+		float rangeSq	 = m_squareViewingRanges[observer];
+		float threshold	 = m_coneThresholds[observer];
+		bool  isWide	 = m_isWideFieldOfView[observer];
+
+#ifdef FIELD_OF_VIEW_USE_SSE
+		__m128 observerX4 = _mm_set1_ps(observerX);
+		__m128 observerY4 = _mm_set1_ps(observerY);
+		__m128 viewX4	  = _mm_set1_ps(viewX);
+		__m128 viewY4	  = _mm_set1_ps(viewY);
+		__m128 rangeSq4	  = _mm_set1_ps(rangeSq);
+		__m128 threshold4 = _mm_set1_ps(threshold);
+		__m128 zero4	  = _mm_setzero_ps();
+
+		for(unsigned int target = 0; target < paddedNumberOfSoldiers; target += 4)
+		{
+			__m128 toTargetX = _mm_sub_ps(_mm_loadu_ps(&m_positionsX[target]), observerX4);
+			__m128 toTargetY = _mm_sub_ps(_mm_loadu_ps(&m_positionsY[target]), observerY4);
+
+			__m128 distanceSq = _mm_add_ps(_mm_mul_ps(toTargetX, toTargetX), _mm_mul_ps(toTargetY, toTargetY));
+			__m128 dot		  = _mm_add_ps(_mm_mul_ps(toTargetX, viewX4), _mm_mul_ps(toTargetY, viewY4));
+			__m128 dotSq	  = _mm_mul_ps(dot, dot);
+			__m128 limitSq	  = _mm_mul_ps(threshold4, distanceSq);
+
+			__m128 inRange = _mm_cmple_ps(distanceSq, rangeSq4);
+			__m128 inFront = _mm_cmpge_ps(dot, zero4);
+			__m128 inCone;
+
+			if(isWide)
+			{
+				// The cone reaches behind the observer, targets there are in view as long as the dot product is not too negative
+				inCone = _mm_or_ps(inFront, _mm_cmple_ps(dotSq, limitSq));
+			}else
+			{
+				inCone = _mm_and_ps(inFront, _mm_cmpge_ps(dotSq, limitSq));
+			}
+
+			unsigned int bits	   = static_cast<unsigned int>(_mm_movemask_ps(_mm_and_ps(inRange, inCone)));
+			unsigned int rangeBits = static_cast<unsigned int>(_mm_movemask_ps(inRange));
+
+			pWords[target / 32]		 |= bits << (target % 32);
+			pRangeWords[target / 32] |= rangeBits << (target % 32);
+		}
+#else
+		for(unsigned int target = 0; target < m_numberOfSoldiers; ++target)
+		{
+			float toTargetX	 = m_positionsX[target] - observerX;
+			float toTargetY	 = m_positionsY[target] - observerY;
+			float distanceSq = toTargetX * toTargetX + toTargetY * toTargetY;
+			float dot		 = toTargetX * viewX + toTargetY * viewY;
+			float limitSq	 = threshold * distanceSq;
+
+			bool inCone = isWide ? (dot >= 0.0f || dot * dot <= limitSq) : (dot >= 0.0f && dot * dot >= limitSq);
+
+			if(distanceSq <= rangeSq)
+			{
+				pRangeWords[target / 32] |= 1u << (target % 32);
+
+				if(inCone)
+				{
+					pWords[target / 32] |= 1u << (target % 32);
+				}
+			}
+		}
+#endif
+
+		// Only keep the living enemies
+		for(unsigned int word = 0; word < m_numberOfWords; ++word)
+		{
+			unsigned int enemies = 0;
+
+			for(unsigned int team = 0; team < NumberOfTeams - 1; ++team)
+			{
+				if(team != static_cast<unsigned int>(m_teams[observer]))
+				{
+					enemies |= m_teamMembers[team * m_numberOfWords + word];
+				}
+			}
+
+			pWords[word]	  &= enemies;
+			pRangeWords[word] &= enemies;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Tells whether a soldier was within range and field of view of another one.
+// Param1: The index of the observing soldier.
+// Param2: The index of the observed soldier.
+// Returns true if the observed soldier is a candidate for the line of sight test, false otherwise.
+//--------------------------------------------------------------------------------------
+bool FieldOfViewCandidates::IsCandidate(unsigned int observer, unsigned int target) const
+{
+	return (m_candidates[observer * m_numberOfWords + target / 32] & (1u << (target % 32))) != 0;
+}
+
+//--------------------------------------------------------------------------------------
+// Tells whether any living enemy was within viewing range of a soldier, regardless of its
+// field of view.
+// Param1: The index of the observing soldier.
+// Returns true if there was at least one enemy in range, false otherwise.
+//--------------------------------------------------------------------------------------
+bool FieldOfViewCandidates::AreEnemiesInRange(unsigned int observer) const
+{
+	for(unsigned int word = 0; word < m_numberOfWords; ++word)
+	{
+		if(m_enemiesInRange[observer * m_numberOfWords + word] != 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Data access functions
+
+unsigned int FieldOfViewCandidates::GetObserverIndex(unsigned long id) const
+{
+	if(id >= m_observerIndices.size() || m_observerIndices[id] >= m_numberOfSoldiers)
+	{
+		return g_kNoFieldOfViewObserver;
+	}
+
+	return m_observerIndices[id];
+}
+
+const unsigned int* FieldOfViewCandidates::GetCandidates(unsigned int observer) const
+{
+	return &m_candidates[observer * m_numberOfWords];
+}
+
+unsigned int FieldOfViewCandidates::GetNumberOfWords(void) const
+{
+	return m_numberOfWords;
+}
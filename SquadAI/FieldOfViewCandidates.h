@@ -0,0 +1,62 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  FieldOfViewCandidates.h
+*  Determines once per frame which enemies are within viewing range and field of view of each
+*  soldier. The positions and view directions of all soldiers are laid out as structure of arrays
+*  and all observer/target pairs are tested at once, four targets at a time using SSE where available.
+*  The cone test compares the dot product against the cosine of the field of view, squared to avoid
+*  square roots and trigonometry. The results are bitsets of candidates per observer, only these
+*  candidates are passed on to the expensive line of sight test.
+*/
+
+#ifndef FIELD_OF_VIEW_CANDIDATES_H
+#define FIELD_OF_VIEW_CANDIDATES_H
+
+// Includes
+#include <vector>
+#include "ObjectTypes.h"
+
+// Forward declarations
+class Soldier;
+
+// Marks objects that are not observers of the field of view test
+const unsigned int g_kNoFieldOfViewObserver = 0xffffffff;
+
+class FieldOfViewCandidates
+{
+public:
+	FieldOfViewCandidates(void);
+	~FieldOfViewCandidates(void);
+
+	void Update(const Soldier* pSoldiers, unsigned int numberOfSoldiers);
+	void Clear(void);
+
+	bool IsCandidate(unsigned int observer, unsigned int target) const;
+	bool AreEnemiesInRange(unsigned int observer) const;
+
+	// Data access functions
+
+	unsigned int		GetObserverIndex(unsigned long id) const;
+	const unsigned int* GetCandidates(unsigned int observer) const;
+	unsigned int		GetNumberOfWords(void) const;
+
+private:
+	void CalculateCandidates(void);
+
+	unsigned int			  m_numberOfSoldiers;	 // The number of soldiers tested during the last update
+	unsigned int			  m_numberOfWords;		 // The number of 32 bit words of each bitset
+	std::vector<float>		  m_positionsX;			 // The x coordinates of the soldier positions, padded to a multiple of four
+	std::vector<float>		  m_positionsY;			 // The y coordinates of the soldier positions, padded to a multiple of four
+	std::vector<float>		  m_viewDirectionsX;	 // The x components of the view directions of the soldiers
+	std::vector<float>		  m_viewDirectionsY;	 // The y components of the view directions of the soldiers
+	std::vector<float>		  m_squareViewingRanges; // The squared viewing distances of the soldiers
+	std::vector<float>		  m_coneThresholds;		 // The squared cosine of the field of view times the squared length of the view direction
+	std::vector<bool>		  m_isWideFieldOfView;	 // Whether the field of view of a soldier exceeds 90 degrees, its cosine is negative then
+	std::vector<EntityTeam>	  m_teams;				 // The teams of the soldiers
+	std::vector<unsigned int> m_teamMembers;		 // The bitset of the living soldiers of each team, indexed by team * number of words + word
+	std::vector<unsigned int> m_candidates;			 // The bitset of the candidates of each soldier, indexed by observer * number of words + word
+	std::vector<unsigned int> m_enemiesInRange;		 // The bitset of the living enemies within viewing range of each soldier, same layout as the candidates
+	std::vector<unsigned int> m_observerIndices;	 // The index of each soldier, indexed by soldier id
+};
+
+#endif // FIELD_OF_VIEW_CANDIDATES_H
@@ -0,0 +1,174 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  FlowFieldManager.cpp
+*  Maintains flow fields (Dijkstra maps) towards the strategic targets of the test environment,
+*  such as the flag bases, the base entrances and the attack positions. A flow field stores the
+*  distance to its target and the next node on the shortest path for every node of the grid.
+*  Any number of entities heading to the same target share a single field and look up their next
+*  step in constant time instead of running a path search each.
+*/
+
+// Includes
+#include <cfloat>
+#include <climits>
+#include "FlowFieldManager.h"
+#include "Pathfinder.h"
+#include "TestEnvironment.h"
+
+FlowFieldManager::FlowFieldManager(void) : m_pEnvironment(nullptr)
+{
+	m_searchContext.SetCallerTag("Flow Fields");
+}
+
+FlowFieldManager::~FlowFieldManager(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Initialises the flow field manager for the current grid of a test environment. Existing
+// flow fields are discarded.
+// Param1: A pointer to the test environment, for which the flow fields are calculated.
+// Returns true if the flow field manager was initialised successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool FlowFieldManager::Initialise(const TestEnvironment* pTestEnvironment)
+{
+	if(!pTestEnvironment)
+	{
+		return false;
+	}
+
+	m_pEnvironment = pTestEnvironment;
+	m_flowFields.clear();
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Makes sure that there is an up-to-date flow field for each of the targets. Fields are only
+// rebuilt if the obstacles changed since they were calculated, fields for positions that are
+// no longer targets are discarded.
+// Param1: The world positions of the targets.
+// Param2: The pathfinder used to calculate the fields.
+//--------------------------------------------------------------------------------------
+void FlowFieldManager::Update(const std::vector<XMFLOAT2>& targetPositions, const Pathfinder& pathfinder)
+{
+	std::unordered_map<unsigned long, FlowField> flowFields;
+
+	for(std::vector<XMFLOAT2>::const_iterator it = targetPositions.begin(); it != targetPositions.end(); ++it)
+	{
+		XMFLOAT2 gridPosition;
+		m_pEnvironment->WorldToGridPosition(*it, gridPosition);
+
+		if((gridPosition.x < 0) || (gridPosition.y < 0) ||
+		   (gridPosition.x >= m_pEnvironment->GetNumberOfGridPartitions()) || (gridPosition.y >= m_pEnvironment->GetNumberOfGridPartitions()))
+		{
+			continue;
+		}
+
+		const Node* pTargetNode = m_pEnvironment->GetNode(static_cast<unsigned int>(gridPosition.x), static_cast<unsigned int>(gridPosition.y));
+
+		if(pTargetNode->IsObstacle() || flowFields.find(pTargetNode->GetId()) != flowFields.end())
+		{
+			continue;
+		}
+
+		FlowField& flowField = flowFields[pTargetNode->GetId()];
+
+		std::unordered_map<unsigned long, FlowField>::iterator foundIt = m_flowFields.find(pTargetNode->GetId());
+
+		if(foundIt != m_flowFields.end() && foundIt->second.m_version == m_pEnvironment->GetObstacleVersion())
+		{
+			// The existing field is still valid
+			flowField.m_targetId = foundIt->second.m_targetId;
+			flowField.m_version  = foundIt->second.m_version;
+			flowField.m_distances.swap(foundIt->second.m_distances);
+			flowField.m_nextNodeIds.swap(foundIt->second.m_nextNodeIds);
+		}else
+		{
+			BuildFlowField(pTargetNode->GetId(), pathfinder, flowField);
+		}
+	}
+
+	m_flowFields.swap(flowFields);
+}
+
+//--------------------------------------------------------------------------------------
+// Discards all flow fields.
+//--------------------------------------------------------------------------------------
+void FlowFieldManager::Clear(void)
+{
+	m_flowFields.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// Looks up the flow field leading to a position.
+// Param1: The world position of the target.
+// Returns a pointer to the flow field leading to the grid field containing the position, nullptr
+// if the position is no strategic target or the field is outdated.
+//--------------------------------------------------------------------------------------
+const FlowField* FlowFieldManager::GetFlowField(const XMFLOAT2& targetPosition) const
+{
+	if(m_flowFields.empty())
+	{
+		return nullptr;
+	}
+
+	XMFLOAT2 gridPosition;
+	m_pEnvironment->WorldToGridPosition(targetPosition, gridPosition);
+
+	if((gridPosition.x < 0) || (gridPosition.y < 0) ||
+	   (gridPosition.x >= m_pEnvironment->GetNumberOfGridPartitions()) || (gridPosition.y >= m_pEnvironment->GetNumberOfGridPartitions()))
+	{
+		return nullptr;
+	}
+
+	unsigned long targetId = static_cast<unsigned long>(gridPosition.x) * m_pEnvironment->GetNumberOfGridPartitions() + static_cast<unsigned long>(gridPosition.y);
+
+	std::unordered_map<unsigned long, FlowField>::const_iterator foundIt = m_flowFields.find(targetId);
+
+	if(foundIt == m_flowFields.end() || foundIt->second.m_version != m_pEnvironment->GetObstacleVersion())
+	{
+		return nullptr;
+	}
+
+	return &foundIt->second;
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a flow field by expanding the whole grid from the target node. The traversal
+// costs are symmetric, thus the shortest path tree rooted at the target yields the next step
+// towards the target for every node.
+// Param1: The id of the target node.
+// Param2: The pathfinder used to expand the grid.
+// Param3: The flow field to fill.
+//--------------------------------------------------------------------------------------
+void FlowFieldManager::BuildFlowField(unsigned long targetId, const Pathfinder& pathfinder, FlowField& flowField)
+{
+	unsigned int numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+	unsigned int numberOfNodes			= numberOfGridPartitions * numberOfGridPartitions;
+
+	pathfinder.CalculateCostsInArea(m_pEnvironment->GetNodeById(targetId), 0, 0, numberOfGridPartitions - 1, numberOfGridPartitions - 1, m_searchContext);
+
+	flowField.m_targetId = targetId;
+	flowField.m_version  = m_pEnvironment->GetObstacleVersion();
+	flowField.m_distances.assign(numberOfNodes, FLT_MAX);
+	flowField.m_nextNodeIds.assign(numberOfNodes, ULONG_MAX);
+
+	for(unsigned long id = 0; id < numberOfNodes; ++id)
+	{
+		if(m_searchContext.IsClosed(id))
+		{
+			// The parent of a node in the search tree is its next step towards the target,
+			// the target itself is its own parent.
+			flowField.m_distances[id]	= m_searchContext.GetNodeData(id).m_movementCost;
+			flowField.m_nextNodeIds[id] = m_searchContext.GetNodeData(id).m_parentId;
+		}
+	}
+}
+
+// Data access functions
+
+unsigned int FlowFieldManager::GetNumberOfFlowFields(void) const
+{
+	return m_flowFields.size();
+}
@@ -0,0 +1,76 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  FlowFieldManager.h
+*  Maintains flow fields (Dijkstra maps) towards the strategic targets of the test environment,
+*  such as the flag bases, the base entrances and the attack positions. A flow field stores the
+*  distance to its target and the next node on the shortest path for every node of the grid.
+*  Any number of entities heading to the same target share a single field and look up their next
+*  step in constant time instead of running a path search each.
+*/
+
+#ifndef FLOW_FIELD_MANAGER_H
+#define FLOW_FIELD_MANAGER_H
+
+// Includes
+#include <DirectXMath.h>
+#include <climits>
+#include <vector>
+#include <unordered_map>
+#include "SearchContext.h"
+
+// Forward declarations
+class TestEnvironment;
+class Pathfinder;
+
+using namespace DirectX;
+
+//--------------------------------------------------------------------------------------
+// The result of a reverse Dijkstra search from a target over the whole grid.
+//--------------------------------------------------------------------------------------
+struct FlowField
+{
+	FlowField(void) : m_targetId(0),
+					  m_version(0)
+	{}
+
+	//--------------------------------------------------------------------------------------
+	// Tells whether the target can be reached from a node.
+	// Param1: The id of the node.
+	// Returns true if there is a path from the node to the target, false otherwise.
+	//--------------------------------------------------------------------------------------
+	bool IsReachable(unsigned long id) const
+	{
+		return m_nextNodeIds[id] != ULONG_MAX;
+	}
+
+	unsigned long			   m_targetId;	  // The id of the node the field leads to
+	unsigned int			   m_version;	  // The obstacle version of the test environment the field was built for
+	std::vector<float>		   m_distances;	  // The cost of the shortest path from each node to the target, FLT_MAX if there is none
+	std::vector<unsigned long> m_nextNodeIds; // The id of the next node on the shortest path from each node to the target, ULONG_MAX if there is none
+};
+
+class FlowFieldManager
+{
+public:
+	FlowFieldManager(void);
+	~FlowFieldManager(void);
+
+	bool Initialise(const TestEnvironment* pTestEnvironment);
+	void Update(const std::vector<XMFLOAT2>& targetPositions, const Pathfinder& pathfinder);
+	void Clear(void);
+
+	const FlowField* GetFlowField(const XMFLOAT2& targetPosition) const;
+
+	// Data access functions
+
+	unsigned int GetNumberOfFlowFields(void) const;
+
+private:
+	void BuildFlowField(unsigned long targetId, const Pathfinder& pathfinder, FlowField& flowField);
+
+	const TestEnvironment*						 m_pEnvironment;  // The test environment the flow fields are calculated for
+	std::unordered_map<unsigned long, FlowField> m_flowFields;	  // The flow fields, indexed by the id of their target node
+	SearchContext								 m_searchContext; // Used to run the searches building the flow fields
+};
+
+#endif // FLOW_FIELD_MANAGER_H
@@ -136,7 +136,7 @@ BehaviourStatus GuardedFlagCapture::Initiate(void)
 			// Orders for the protectors
 
 			XMFLOAT2 movementTarget(0.0f, 0.0f);
-			if(!m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(flagCarrierPosition, m_guardRadius, movementTarget))
+			if(!m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(flagCarrierPosition, m_guardRadius, (*it)->GetPosition(), movementTarget))
 			{
 				return StatusFailure;
 			}
@@ -238,7 +238,7 @@ void GuardedFlagCapture::UpdateMovementTargets(void)
 		{
 			XMFLOAT2 newMovementTarget(0.0f, 0.0f);
 			
-			if(!m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(flagCarrierPosition, m_guardRadius, newMovementTarget))
+			if(!m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(flagCarrierPosition, m_guardRadius, (*it)->GetPosition(), newMovementTarget))
 			{
 				m_pTeamAI->ReleaseEntityFromManoeuvre((*it)->GetId());
 			}
@@ -103,7 +103,7 @@ void InterceptFlagCarrier::ProcessMessage(Message* pMessage)
 			EntityTeam enemyTeam = (GetTeamAI()->GetTeam() == TeamRed) ? (TeamBlue) : (TeamRed);
 			// Get a random position close to the base and patrol it.
 			XMFLOAT2 patrolPosition(0.0f, 0.0f);
-			if(!(m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(GetTeamAI()->GetFlagData(enemyTeam).m_basePosition, m_searchRadius, patrolPosition)))
+			if(!(m_pTeamAI->GetTestEnvironment()->GetRandomUnblockedTargetInArea(GetTeamAI()->GetFlagData(enemyTeam).m_basePosition, m_searchRadius, GetParticipant(pMsg->GetData().m_entityId)->GetPosition(), patrolPosition)))
 			{
 				// An error occurred
 				SetFailed(true);
@@ -0,0 +1,189 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  LandmarkTable.cpp
+*  Holds the costs of the shortest paths from a small set of landmark nodes to all nodes of the
+*  grid. By the triangle inequality the difference between the distances of two nodes to a landmark
+*  is a lower bound for the distance between the nodes, which is used by the landmark (ALT) heuristic.
+*  Unlike straight line estimates the bounds account for walls between the nodes.
+*/
+
+// Includes
+#include <cfloat>
+#include <cmath>
+#include "LandmarkTable.h"
+#include "Pathfinder.h"
+#include "TestEnvironment.h"
+
+LandmarkTable::LandmarkTable(void) : m_pEnvironment(nullptr),
+									 m_maxLandmarks(0),
+									 m_obstacleVersion(0),
+									 m_isBuilt(false)
+{
+	m_searchContext.SetCallerTag("Landmarks");
+}
+
+LandmarkTable::~LandmarkTable(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Initialises the landmark table for the current grid of a test environment. The distances
+// are calculated by the next update.
+// Param1: A pointer to the test environment, for which the distances are calculated.
+// Param2: The number of landmarks to place.
+// Returns true if the landmark table was initialised successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool LandmarkTable::Initialise(const TestEnvironment* pTestEnvironment, unsigned int numberOfLandmarks)
+{
+	if(!pTestEnvironment || numberOfLandmarks == 0)
+	{
+		return false;
+	}
+
+	m_pEnvironment = pTestEnvironment;
+	m_maxLandmarks = numberOfLandmarks;
+	m_landmarks.clear();
+	m_distances.clear();
+	m_isBuilt	   = false;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Places the landmarks and calculates the distances from all nodes to them, unless the
+// table is still valid for the current obstacles. The landmarks are spread out by farthest
+// point selection: each new landmark is the node with the longest path to the closest of the
+// landmarks placed before, which yields good bounds for most pairs of nodes. 
+// Param1: The pathfinder used to calculate the distances.
+//--------------------------------------------------------------------------------------
+void LandmarkTable::Update(const Pathfinder& pathfinder)
+{
+	if(IsUpToDate())
+	{
+		return;
+	}
+
+	unsigned int numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+	unsigned int numberOfNodes			= numberOfGridPartitions * numberOfGridPartitions;
+
+	m_landmarks.clear();
+	m_distances.assign(numberOfNodes * m_maxLandmarks, FLT_MAX);
+	m_obstacleVersion = m_pEnvironment->GetObstacleVersion();
+	m_isBuilt		  = true;
+
+	// Start the selection with the node farthest away from an arbitrary traversable node
+	unsigned long seedId = 0;
+
+	while(seedId < numberOfNodes && m_pEnvironment->GetNodeById(seedId)->IsObstacle())
+	{
+		++seedId;
+	}
+
+	if(seedId == numberOfNodes)
+	{
+		// There are no traversable nodes
+		return;
+	}
+
+	pathfinder.CalculateCostsInArea(m_pEnvironment->GetNodeById(seedId), 0, 0, numberOfGridPartitions - 1, numberOfGridPartitions - 1, m_searchContext);
+
+	unsigned long nextLandmarkId = seedId;
+	float		  maxDistance	 = 0.0f;
+
+	for(unsigned long id = 0; id < numberOfNodes; ++id)
+	{
+		if(m_searchContext.IsClosed(id) && m_searchContext.GetNodeData(id).m_movementCost > maxDistance)
+		{
+			maxDistance	   = m_searchContext.GetNodeData(id).m_movementCost;
+			nextLandmarkId = id;
+		}
+	}
+
+	// The distance from each node to the closest landmark placed so far
+	std::vector<float> minDistances(numberOfNodes, FLT_MAX);
+
+	for(unsigned int landmark = 0; landmark < m_maxLandmarks; ++landmark)
+	{
+		m_landmarks.push_back(nextLandmarkId);
+
+		// The traversal costs are symmetric, the distances from the landmark equal the ones to it
+		pathfinder.CalculateCostsInArea(m_pEnvironment->GetNodeById(nextLandmarkId), 0, 0, numberOfGridPartitions - 1, numberOfGridPartitions - 1, m_searchContext);
+
+		maxDistance = 0.0f;
+
+		for(unsigned long id = 0; id < numberOfNodes; ++id)
+		{
+			if(!m_searchContext.IsClosed(id))
+			{
+				continue;
+			}
+
+			float distance = m_searchContext.GetNodeData(id).m_movementCost;
+			m_distances[id * m_maxLandmarks + landmark] = distance;
+
+			if(distance < minDistances[id])
+			{
+				minDistances[id] = distance;
+			}
+
+			if(minDistances[id] > maxDistance)
+			{
+				maxDistance	   = minDistances[id];
+				nextLandmarkId = id;
+			}
+		}
+
+		if(maxDistance == 0.0f)
+		{
+			// Every reachable node is a landmark already
+			break;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a lower bound for the cost of the shortest path between two nodes.
+// Param1: The id of the first node.
+// Param2: The id of the second node.
+// Returns the largest lower bound provided by the landmarks, 0 if the table is outdated.
+//--------------------------------------------------------------------------------------
+float LandmarkTable::GetLowerBound(unsigned long nodeId, unsigned long targetId) const
+{
+	if(!IsUpToDate())
+	{
+		return 0.0f;
+	}
+
+	const float* pNodeDistances	  = &m_distances[nodeId * m_maxLandmarks];
+	const float* pTargetDistances = &m_distances[targetId * m_maxLandmarks];
+
+	float lowerBound = 0.0f;
+
+	for(unsigned int i = 0; i < m_landmarks.size(); ++i)
+	{
+		// Landmarks that cannot be reached from both nodes provide no bound
+		if(pNodeDistances[i] != FLT_MAX && pTargetDistances[i] != FLT_MAX)
+		{
+			float bound = fabs(pTargetDistances[i] - pNodeDistances[i]);
+
+			if(bound > lowerBound)
+			{
+				lowerBound = bound;
+			}
+		}
+	}
+
+	return lowerBound;
+}
+
+// Data access functions
+
+const std::vector<unsigned long>& LandmarkTable::GetLandmarks(void) const
+{
+	return m_landmarks;
+}
+
+bool LandmarkTable::IsUpToDate(void) const
+{
+	return m_isBuilt && m_obstacleVersion == m_pEnvironment->GetObstacleVersion();
+}
@@ -0,0 +1,46 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  LandmarkTable.h
+*  Holds the costs of the shortest paths from a small set of landmark nodes to all nodes of the
+*  grid. By the triangle inequality the difference between the distances of two nodes to a landmark
+*  is a lower bound for the distance between the nodes, which is used by the landmark (ALT) heuristic.
+*  Unlike straight line estimates the bounds account for walls between the nodes.
+*/
+
+#ifndef LANDMARK_TABLE_H
+#define LANDMARK_TABLE_H
+
+// Includes
+#include <vector>
+#include "SearchContext.h"
+
+// Forward declarations
+class TestEnvironment;
+class Pathfinder;
+
+class LandmarkTable
+{
+public:
+	LandmarkTable(void);
+	~LandmarkTable(void);
+
+	bool Initialise(const TestEnvironment* pTestEnvironment, unsigned int numberOfLandmarks);
+	void Update(const Pathfinder& pathfinder);
+	float GetLowerBound(unsigned long nodeId, unsigned long targetId) const;
+
+	// Data access functions
+
+	const std::vector<unsigned long>& GetLandmarks(void) const;
+	bool							  IsUpToDate(void) const;
+
+private:
+	const TestEnvironment*	   m_pEnvironment;		// The test environment, for the grid of which the distances are calculated
+	unsigned int			   m_maxLandmarks;		// The number of landmarks to place
+	std::vector<unsigned long> m_landmarks;			// The ids of the landmark nodes
+	std::vector<float>		   m_distances;			// The distances from each node to all landmarks (node-major, FLT_MAX if a landmark cannot be reached)
+	unsigned int			   m_obstacleVersion;	// The obstacle version of the test environment the distances were calculated for
+	bool					   m_isBuilt;			// Tells whether the distances were calculated since the grid was initialised
+	SearchContext			   m_searchContext;		// Used to calculate the distances from the landmarks
+};
+
+#endif // LANDMARK_TABLE_H
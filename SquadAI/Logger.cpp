@@ -12,6 +12,8 @@
 #include "Projectile.h"
 #include "TeamManoeuvre.h"
 #include "ObjectTypes.h"
+#include "PathCache.h"
+#include "PathfindingStatistics.h"
 
 Logger::Logger(void)
 {
@@ -83,6 +85,12 @@ void Logger::LogEvent(LogEventType type, void* pObject1, void* pObject2)
 	case TeamManoeuvrePreconditionCheckLogEvent:
 		LogManoeuvrePreconditionCheck(reinterpret_cast<EntityTeam*>(pObject1), reinterpret_cast<TeamManoeuvreType*>(pObject2));
 		break;
+	case PathCacheStatisticsLogEvent:
+		LogPathCacheStatistics(reinterpret_cast<PathCache*>(pObject1));
+		break;
+	case PathfindingStatisticsLogEvent:
+		LogPathfindingStatistics(reinterpret_cast<PathfindingStatistics*>(pObject1));
+		break;
 	}
 }
 
@@ -195,6 +203,82 @@ void Logger::LogManoeuvrePreconditionCheck(EntityTeam* team, TeamManoeuvreType*
 	}
 }
 
+//--------------------------------------------------------------------------------------
+// Writes a new entry to the log file that tells how many path requests were served by the
+// path cache of the pathfinder.
+// Param1: A pointer to the path cache of the pathfinder.
+//--------------------------------------------------------------------------------------
+void Logger::LogPathCacheStatistics(PathCache* pPathCache)
+{
+	if(m_out.is_open())
+	{
+		unsigned long lookups = pPathCache->GetHitCount() + pPathCache->GetMissCount();
+
+		m_out << '\n' << "Path cache served " << pPathCache->GetHitCount() << " of " << lookups << " path requests (" << pPathCache->GetMissCount() << " misses, " << pPathCache->GetSize() << " paths cached).";
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Writes the aggregated statistics of the queries answered by the pathfinder to the log file:
+// the totals, the totals of each caller tag and the distribution of the cost per query.
+// Param1: A pointer to the statistics of the pathfinder.
+//--------------------------------------------------------------------------------------
+void Logger::LogPathfindingStatistics(PathfindingStatistics* pStatistics)
+{
+	if(m_out.is_open())
+	{
+		PathQueryTotals totals = pStatistics->GetTotals();
+
+		m_out << '\n' << "Pathfinder answered " << totals.m_numberOfQueries << " queries (" << totals.m_numberOfFailedQueries << " failed, " << totals.m_numberOfCacheHits << " served by the path cache), "
+			  << "expanded " << totals.m_nodesExpanded << " nodes and spent " << totals.m_wallTime / 1000000.0 << " ms.";
+
+		std::map<std::string, PathQueryTotals> callerTotals;
+		pStatistics->GetCallerTotals(callerTotals);
+
+		for(std::map<std::string, PathQueryTotals>::const_iterator it = callerTotals.begin(); it != callerTotals.end(); ++it)
+		{
+			m_out << '\n' << "  " << it->first << ": " << it->second.m_numberOfQueries << " queries (" << it->second.m_numberOfFailedQueries << " failed, " << it->second.m_numberOfCacheHits << " cached), "
+				  << it->second.m_nodesExpanded << " nodes expanded, " << it->second.m_nodesTouched << " touched, largest open list " << it->second.m_maxOpenListPeak << ", "
+				  << it->second.m_wallTime / 1000000.0 << " ms (slowest query " << it->second.m_maxWallTime / 1000.0 << " us), " << it->second.m_numberOfWaypoints << " waypoints over a length of " << it->second.m_pathLength << '.';
+		}
+
+		unsigned long histogram[g_kNumberOfHistogramBuckets];
+
+		pStatistics->GetExpansionHistogram(histogram);
+		LogHistogram("Queries per number of expanded nodes:", histogram, g_kNumberOfHistogramBuckets);
+
+		pStatistics->GetWallTimeHistogram(histogram);
+		LogHistogram("Queries per wall time in nanoseconds:", histogram, g_kNumberOfHistogramBuckets);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Writes the non-empty buckets of a histogram with power of two bucket sizes to the log file.
+// Param1: The line to write ahead of the buckets.
+// Param2: The number of values per bucket, bucket 0 holds the value 0, bucket i > 0 the values in [2^(i-1), 2^i).
+// Param3: The number of buckets.
+//--------------------------------------------------------------------------------------
+void Logger::LogHistogram(const char* title, const unsigned long* pHistogram, unsigned int numberOfBuckets)
+{
+	m_out << '\n' << title;
+
+	for(unsigned int i = 0; i < numberOfBuckets; ++i)
+	{
+		if(pHistogram[i] == 0)
+		{
+			continue;
+		}
+
+		if(i == 0)
+		{
+			m_out << '\n' << "  0: " << pHistogram[i];
+		}else
+		{
+			m_out << '\n' << "  " << (1ULL << (i - 1)) << " - " << (1ULL << i) - 1 << ": " << pHistogram[i];
+		}
+	}
+}
+
 //--------------------------------------------------------------------------------------
 // Closes the log file.
 //--------------------------------------------------------------------------------------
@@ -18,6 +18,8 @@
 class Entity;
 class Behaviour;
 class Projectile;
+class PathCache;
+class PathfindingStatistics;
 enum EntityTeam;
 enum TeamManoeuvreType;
 
@@ -32,7 +34,9 @@ enum LogEventType
 	EntityKilledLogEvent,				// Called when an entity was killed
 	TeamManoeuvreInitLogEvent,				// Called when a team manoeuvre is initiated
 	TeamManoeuvreTerminateLogEvent,			// Called when a team manoeuvre is terminated
-	TeamManoeuvrePreconditionCheckLogEvent // Called when the preconditions of a team manoeuvre are checked
+	TeamManoeuvrePreconditionCheckLogEvent, // Called when the preconditions of a team manoeuvre are checked
+	PathCacheStatisticsLogEvent,			// Called at the end of a simulation to record how effective the path cache was
+	PathfindingStatisticsLogEvent			// Called at the end of a simulation to record what the path searches cost and who requested them
 };
 
 //--------------------------------------------------------------------------------------
@@ -61,6 +65,9 @@ private:
 	void LogManoeuvreInit(EntityTeam* team, TeamManoeuvreType* manoeuvre);
 	void LogManoeuvreTerminate(EntityTeam* team, TeamManoeuvreType* manoeuvre);
 	void LogManoeuvrePreconditionCheck(EntityTeam* team, TeamManoeuvreType* manoeuvre);
+	void LogPathCacheStatistics(PathCache* pPathCache);
+	void LogPathfindingStatistics(PathfindingStatistics* pStatistics);
+	void LogHistogram(const char* title, const unsigned long* pHistogram, unsigned int numberOfBuckets);
 
 	std::ofstream  m_out; // The out file stream that the logger uses to write messages to the file
 };
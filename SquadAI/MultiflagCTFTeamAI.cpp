@@ -179,7 +179,7 @@ void MultiflagCTFTeamAI::Update(float deltaTime)
 //--------------------------------------------------------------------------------------
 void MultiflagCTFTeamAI::PrepareForSimulation(void)
 {
-	
+	TeamAI::PrepareForSimulation();
 }
 
 //--------------------------------------------------------------------------------------
@@ -525,8 +525,31 @@ BehaviourStatus MultiflagCTFTeamAI::InitiateManoeuvre(TeamManoeuvreType manoeuvr
 			break;
 		}
 
-		// Sort the entities by distance to the current drop position of the enemy's flag
+		// Sort the entities by the costs of their paths to the position, walls can make an entity that is close
+		// in a straight line take much longer than others. Entities with equal costs (e.g. none of them can reach
+		// the position) remain sorted by straight-line distance.
 		std::sort(availableEntities.begin(), availableEntities.end(), Entity::CompareEntityByDistanceToTarget(sortPosition));
+
+		std::vector<XMFLOAT2> positions;
+		positions.reserve(availableEntities.size());
+
+		for(std::vector<Entity*>::const_iterator it = availableEntities.begin(); it != availableEntities.end(); ++it)
+		{
+			positions.push_back((*it)->GetPosition());
+		}
+
+		std::vector<float> pathCosts;
+		GetSearchContext().SetCallerTag(TeamManoeuvre::GetManoeuvreNameFromType(manoeuvre));
+		GetTestEnvironment()->GetPathfinder().CalculatePathCosts(sortPosition, positions, pathCosts, GetSearchContext());
+
+		std::unordered_map<unsigned long, float> pathCostMap;
+
+		for(unsigned int i = 0; i < availableEntities.size(); ++i)
+		{
+			pathCostMap.insert(std::pair<unsigned long, float>(availableEntities[i]->GetId(), pathCosts[i]));
+		}
+
+		std::stable_sort(availableEntities.begin(), availableEntities.end(), Entity::CompareEntityByPathCost(pathCostMap));
 		
 		// Start adding entities to the manoeuvre making sure that the closest ones are added first.
 		unsigned int addedEntities = 0;
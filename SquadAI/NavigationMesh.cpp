@@ -0,0 +1,215 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  NavigationMesh.cpp
+*  A navigation graph made up of axis-aligned rectangles covering the traversable nodes of the
+*  grid of a test environment. As the obstacles are placed on the grid, the free space decomposes
+*  into few large rectangles. Rectangles sharing an edge are connected by a portal, the segment
+*  along which the grid fields of both rectangles touch. Searches on the rectangles expand far
+*  fewer nodes than searches on the grid, the resulting corridor is smoothed by the funnel algorithm.
+*/
+
+// Includes
+#include "NavigationMesh.h"
+#include "TestEnvironment.h"
+
+NavigationMesh::NavigationMesh(void) : m_pEnvironment(nullptr),
+									   m_obstacleVersion(0),
+									   m_isBuilt(false)
+{
+}
+
+NavigationMesh::~NavigationMesh(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Initialises the navigation mesh for the current grid of a test environment. The rectangles
+// are built by the next update.
+// Param1: A pointer to the test environment, the grid of which should be covered.
+// Returns true if the navigation mesh was initialised successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool NavigationMesh::Initialise(const TestEnvironment* pTestEnvironment)
+{
+	if(!pTestEnvironment)
+	{
+		return false;
+	}
+
+	m_pEnvironment = pTestEnvironment;
+	m_rectangles.clear();
+	m_rectangleIndices.clear();
+	m_isBuilt = false;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Rebuilds the rectangles and portals if the obstacles changed since the last update.
+//--------------------------------------------------------------------------------------
+void NavigationMesh::Update(void)
+{
+	if(IsUpToDate())
+	{
+		return;
+	}
+
+	Decompose();
+	ConnectRectangles();
+
+	m_obstacleVersion = m_pEnvironment->GetObstacleVersion();
+	m_isBuilt		  = true;
+}
+
+//--------------------------------------------------------------------------------------
+// Covers the traversable nodes with rectangles. Starting at the first node that is not
+// covered yet, each rectangle is grown along the y axis as far as possible and then along
+// the x axis as long as the whole next column is traversable and not covered yet.
+//--------------------------------------------------------------------------------------
+void NavigationMesh::Decompose(void)
+{
+	unsigned int numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+
+	m_rectangles.clear();
+	m_rectangleIndices.assign(numberOfGridPartitions * numberOfGridPartitions, g_kNoRectangle);
+
+	for(unsigned int x = 0; x < numberOfGridPartitions; ++x)
+	{
+		for(unsigned int y = 0; y < numberOfGridPartitions; ++y)
+		{
+			if(m_pEnvironment->GetNode(x, y)->IsObstacle() || m_rectangleIndices[x * numberOfGridPartitions + y] != g_kNoRectangle)
+			{
+				continue;
+			}
+
+			// Grow the rectangle along the y axis
+			unsigned int maxY = y;
+
+			while(maxY + 1 < numberOfGridPartitions && !m_pEnvironment->GetNode(x, maxY + 1)->IsObstacle() &&
+				  m_rectangleIndices[x * numberOfGridPartitions + maxY + 1] == g_kNoRectangle)
+			{
+				++maxY;
+			}
+
+			// Grow the rectangle along the x axis
+			unsigned int maxX	   = x;
+			bool		 canExpand = true;
+
+			while(canExpand && maxX + 1 < numberOfGridPartitions)
+			{
+				for(unsigned int k = y; canExpand && k <= maxY; ++k)
+				{
+					canExpand = !m_pEnvironment->GetNode(maxX + 1, k)->IsObstacle() && m_rectangleIndices[(maxX + 1) * numberOfGridPartitions + k] == g_kNoRectangle;
+				}
+
+				if(canExpand)
+				{
+					++maxX;
+				}
+			}
+
+			// Mark the covered nodes
+			for(unsigned int i = x; i <= maxX; ++i)
+			{
+				for(unsigned int k = y; k <= maxY; ++k)
+				{
+					m_rectangleIndices[i * numberOfGridPartitions + k] = m_rectangles.size();
+				}
+			}
+
+			m_rectangles.push_back(NavigationRectangle(x, y, maxX, maxY));
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Creates the portals between all rectangles sharing an edge. Each pair of rectangles is
+// found from the rectangle on the lower side of the shared edge.
+//--------------------------------------------------------------------------------------
+void NavigationMesh::ConnectRectangles(void)
+{
+	for(unsigned int i = 0; i < m_rectangles.size(); ++i)
+	{
+		AddPortals(i, true);
+		AddPortals(i, false);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Creates the portals leading from a rectangle to the rectangles bordering its upper edge
+// along the x or the y axis. The portals are added to both rectangles.
+// Param1: The index of the rectangle.
+// Param2: True to connect the rectangles bordering the edge at the largest x coordinate, false for the
+//         edge at the largest y coordinate.
+//--------------------------------------------------------------------------------------
+void NavigationMesh::AddPortals(unsigned int rectangleIndex, bool isAlongX)
+{
+	unsigned int numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+
+	const NavigationRectangle& rectangle = m_rectangles[rectangleIndex];
+
+	// The row or column of nodes right behind the edge
+	unsigned int border = isAlongX ? rectangle.m_maxX + 1 : rectangle.m_maxY + 1;
+
+	if(border >= numberOfGridPartitions)
+	{
+		return;
+	}
+
+	unsigned int first = isAlongX ? rectangle.m_minY : rectangle.m_minX;
+	unsigned int last  = isAlongX ? rectangle.m_maxY : rectangle.m_maxX;
+
+	// Consecutive nodes behind the edge that belong to the same rectangle form a portal
+	unsigned int runStart	  = first;
+	unsigned int runRectangle = g_kNoRectangle;
+
+	for(unsigned int i = first; i <= last + 1; ++i)
+	{
+		unsigned int currentRectangle = g_kNoRectangle;
+
+		if(i <= last)
+		{
+			currentRectangle = isAlongX ? m_rectangleIndices[border * numberOfGridPartitions + i] : m_rectangleIndices[i * numberOfGridPartitions + border];
+		}
+
+		if(currentRectangle == runRectangle)
+		{
+			continue;
+		}
+
+		if(runRectangle != g_kNoRectangle)
+		{
+			// The portal lies halfway between the centres of the fields on both sides of the edge
+			float	 edge = static_cast<float>(border) - 0.5f;
+			XMFLOAT2 start(isAlongX ? edge : static_cast<float>(runStart), isAlongX ? static_cast<float>(runStart) : edge);
+			XMFLOAT2 end(isAlongX ? edge : static_cast<float>(i - 1), isAlongX ? static_cast<float>(i - 1) : edge);
+
+			m_rectangles[rectangleIndex].m_portals.push_back(NavigationPortal(runRectangle, start, end));
+			m_rectangles[runRectangle].m_portals.push_back(NavigationPortal(rectangleIndex, start, end));
+		}
+
+		runStart	 = i;
+		runRectangle = currentRectangle;
+	}
+}
+
+// Data access functions
+
+unsigned int NavigationMesh::GetRectangleIndex(unsigned long nodeId) const
+{
+	return m_rectangleIndices[nodeId];
+}
+
+const NavigationRectangle& NavigationMesh::GetRectangle(unsigned int rectangleIndex) const
+{
+	return m_rectangles[rectangleIndex];
+}
+
+unsigned int NavigationMesh::GetNumberOfRectangles(void) const
+{
+	return m_rectangles.size();
+}
+
+bool NavigationMesh::IsUpToDate(void) const
+{
+	return m_isBuilt && m_obstacleVersion == m_pEnvironment->GetObstacleVersion();
+}
@@ -0,0 +1,90 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  NavigationMesh.h
+*  A navigation graph made up of axis-aligned rectangles covering the traversable nodes of the
+*  grid of a test environment. As the obstacles are placed on the grid, the free space decomposes
+*  into few large rectangles. Rectangles sharing an edge are connected by a portal, the segment
+*  along which the grid fields of both rectangles touch. Searches on the rectangles expand far
+*  fewer nodes than searches on the grid, the resulting corridor is smoothed by the funnel algorithm.
+*/
+
+#ifndef NAVIGATION_MESH_H
+#define NAVIGATION_MESH_H
+
+// Includes
+#include <climits>
+#include <vector>
+#include <DirectXMath.h>
+
+// Forward declarations
+class TestEnvironment;
+
+using namespace DirectX;
+
+// The rectangle index of nodes that are blocked by obstacles
+const unsigned int g_kNoRectangle = UINT_MAX;
+
+//--------------------------------------------------------------------------------------
+// A connection between two adjacent rectangles of the navigation mesh. The end points are
+// given in grid coordinates and lie halfway between the centres of the grid fields on both
+// sides of the shared edge.
+//--------------------------------------------------------------------------------------
+struct NavigationPortal
+{
+	NavigationPortal(unsigned int rectangle, const XMFLOAT2& start, const XMFLOAT2& end) : m_rectangle(rectangle),
+																						  m_start(start),
+																						  m_end(end)
+	{}
+
+	unsigned int m_rectangle; // The index of the rectangle the portal leads to
+	XMFLOAT2	 m_start;	  // The end point of the portal with the smaller coordinate along the shared edge
+	XMFLOAT2	 m_end;		  // The end point of the portal with the larger coordinate along the shared edge
+};
+
+//--------------------------------------------------------------------------------------
+// A rectangle of traversable grid fields and the portals leading out of it.
+//--------------------------------------------------------------------------------------
+struct NavigationRectangle
+{
+	NavigationRectangle(unsigned int minX, unsigned int minY, unsigned int maxX, unsigned int maxY) : m_minX(minX),
+																									  m_minY(minY),
+																									  m_maxX(maxX),
+																									  m_maxY(maxY)
+	{}
+
+	unsigned int				  m_minX;	 // The smallest x coordinate of a grid field within the rectangle
+	unsigned int				  m_minY;	 // The smallest y coordinate of a grid field within the rectangle
+	unsigned int				  m_maxX;	 // The largest x coordinate of a grid field within the rectangle
+	unsigned int				  m_maxY;	 // The largest y coordinate of a grid field within the rectangle
+	std::vector<NavigationPortal> m_portals; // The portals leading to the adjacent rectangles
+};
+
+class NavigationMesh
+{
+public:
+	NavigationMesh(void);
+	~NavigationMesh(void);
+
+	bool Initialise(const TestEnvironment* pTestEnvironment);
+	void Update(void);
+
+	// Data access functions
+
+	unsigned int			   GetRectangleIndex(unsigned long nodeId) const;
+	const NavigationRectangle& GetRectangle(unsigned int rectangleIndex) const;
+	unsigned int			   GetNumberOfRectangles(void) const;
+	bool					   IsUpToDate(void) const;
+
+private:
+	void Decompose(void);
+	void ConnectRectangles(void);
+	void AddPortals(unsigned int rectangleIndex, bool isAlongX);
+
+	const TestEnvironment*			 m_pEnvironment;	 // The test environment, the grid of which is covered by the rectangles
+	std::vector<NavigationRectangle> m_rectangles;		 // The rectangles covering the traversable nodes
+	std::vector<unsigned int>		 m_rectangleIndices; // The index of the rectangle containing each node, g_kNoRectangle for obstacles
+	unsigned int					 m_obstacleVersion;	 // The obstacle version of the test environment the rectangles were built for
+	bool							 m_isBuilt;			 // Tells whether the rectangles were built since the grid was initialised
+};
+
+#endif // NAVIGATION_MESH_H
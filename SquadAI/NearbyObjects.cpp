@@ -0,0 +1,107 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  NearbyObjects.cpp
+*  A fixed-capacity buffer receiving the results of proximity queries. The callers keep the buffer
+*  and reuse it for every query, thus querying the objects around an entity does not allocate any
+*  memory. The results are only sorted by distance when a caller asks for it.
+*/
+
+// Includes
+#include "NearbyObjects.h"
+
+NearbyObjects::NearbyObjects(void) : m_size(0),
+									 m_isTruncated(false)
+{
+}
+
+NearbyObjects::~NearbyObjects(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Removes all objects from the buffer, to be called before it receives the results of
+// another query.
+//--------------------------------------------------------------------------------------
+void NearbyObjects::Clear(void)
+{
+	m_size		  = 0;
+	m_isTruncated = false;
+}
+
+//--------------------------------------------------------------------------------------
+// Adds an object to the buffer. When the buffer is full, the object replaces the farthest
+// one held if it is closer than that.
+// Param1: The object to add.
+// Param2: The squared distance between the object and the centre of the query.
+//--------------------------------------------------------------------------------------
+void NearbyObjects::Add(CollidableObject* pObject, float squareDistance)
+{
+	if(m_size < g_kNearbyObjectsCapacity)
+	{
+		m_objects[m_size].m_pObject		   = pObject;
+		m_objects[m_size].m_squareDistance = squareDistance;
+		++m_size;
+		return;
+	}
+
+	m_isTruncated = true;
+
+	unsigned int farthest = 0;
+
+	for(unsigned int i = 1; i < m_size; ++i)
+	{
+		if(m_objects[i].m_squareDistance > m_objects[farthest].m_squareDistance)
+		{
+			farthest = i;
+		}
+	}
+
+	if(squareDistance < m_objects[farthest].m_squareDistance)
+	{
+		m_objects[farthest].m_pObject		 = pObject;
+		m_objects[farthest].m_squareDistance = squareDistance;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Sorts the objects in the buffer by increasing distance. Insertion sort, the buffers are
+// small and mostly hold only a few objects.
+//--------------------------------------------------------------------------------------
+void NearbyObjects::SortByDistance(void)
+{
+	for(unsigned int i = 1; i < m_size; ++i)
+	{
+		NearbyObject current = m_objects[i];
+		unsigned int k		 = i;
+
+		while(k > 0 && m_objects[k - 1].m_squareDistance > current.m_squareDistance)
+		{
+			m_objects[k] = m_objects[k - 1];
+			--k;
+		}
+
+		m_objects[k] = current;
+	}
+}
+
+// Data access functions
+
+const NearbyObject& NearbyObjects::GetNearbyObject(unsigned int index) const
+{
+	return m_objects[index];
+}
+
+unsigned int NearbyObjects::GetSize(void) const
+{
+	return m_size;
+}
+
+bool NearbyObjects::IsEmpty(void) const
+{
+	return m_size == 0;
+}
+
+bool NearbyObjects::IsTruncated(void) const
+{
+	return m_isTruncated;
+}
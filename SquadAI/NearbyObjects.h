@@ -0,0 +1,74 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  NearbyObjects.h
+*  A fixed-capacity buffer receiving the results of proximity queries. The callers keep the buffer
+*  and reuse it for every query, thus querying the objects around an entity does not allocate any
+*  memory. The results are only sorted by distance when a caller asks for it.
+*/
+
+#ifndef NEARBY_OBJECTS_H
+#define NEARBY_OBJECTS_H
+
+// Includes
+#include "CollidableObject.h"
+#include "ObjectTypes.h"
+
+// The maximal number of results a buffer can hold, when more objects are found only the closest ones are kept
+const unsigned int g_kNearbyObjectsCapacity = 64;
+
+//--------------------------------------------------------------------------------------
+// An object found by a proximity query.
+//--------------------------------------------------------------------------------------
+struct NearbyObject
+{
+	NearbyObject(void) : m_pObject(nullptr),
+						 m_squareDistance(0.0f)
+	{}
+
+	CollidableObject* m_pObject;		// The object
+	float			  m_squareDistance; // The squared distance between the object and the centre of the query
+};
+
+//--------------------------------------------------------------------------------------
+// Determines which objects a proximity query returns.
+//--------------------------------------------------------------------------------------
+struct NearbyObjectsFilter
+{
+	NearbyObjectsFilter(void) : m_includeEntities(true),
+								m_includeObstacles(false),
+								m_team(None),
+								m_isAliveOnly(true),
+								m_excludedId(0)
+	{}
+
+	bool		  m_includeEntities;  // Whether the soldiers are included
+	bool		  m_includeObstacles; // Whether the obstacles are included
+	EntityTeam	  m_team;			  // Only soldiers of this team are included, None to include the soldiers of all teams
+	bool		  m_isAliveOnly;	  // Whether dead soldiers are left out
+	unsigned long m_excludedId;		  // The id of an object left out, usually the entity issuing the query, 0 for none
+};
+
+class NearbyObjects
+{
+public:
+	NearbyObjects(void);
+	~NearbyObjects(void);
+
+	void Clear(void);
+	void Add(CollidableObject* pObject, float squareDistance);
+	void SortByDistance(void);
+
+	// Data access functions
+
+	const NearbyObject& GetNearbyObject(unsigned int index) const;
+	unsigned int		GetSize(void) const;
+	bool				IsEmpty(void) const;
+	bool				IsTruncated(void) const;
+
+private:
+	NearbyObject m_objects[g_kNearbyObjectsCapacity]; // The objects found by the last query
+	unsigned int m_size;							  // The number of objects found by the last query
+	bool		 m_isTruncated;						  // Tells whether the last query found more objects than the buffer can hold
+};
+
+#endif // NEARBY_OBJECTS_H
@@ -8,17 +8,11 @@
 // Includes
 #include "Node.h"
 
-Node::Node() : m_nodeId(0),
-			   m_pParentNode(nullptr),
-			   m_gridPos(0.0f, 0.0f),
-			   m_worldPos(0.0f, 0.0f),
-			   m_isObstacle(false),
-			   m_pObstacle(nullptr),
-			   m_territoryOwner(EntityTeam(None)),
-			   m_isEntranceToBase(false),
-			   m_isAttackPosition(None),
-			   m_movementCost(0.0f),
-			   m_heuristicValue(0.0f)
+NodeProperties::NodeProperties(void) : m_worldPos(0.0f, 0.0f),
+									   m_pObstacle(nullptr),
+									   m_territoryOwner(EntityTeam(None)),
+									   m_isEntranceToBase(false),
+									   m_isAttackPosition(None)
 {
 	for(unsigned int i = 0; i < NumberOfDirections; ++i)
 	{
@@ -26,48 +20,33 @@ Node::Node() : m_nodeId(0),
 	}
 }
 
+Node::Node() : m_nodeId(0),
+			   m_gridPos(0.0f, 0.0f),
+			   m_pProperties(nullptr),
+			   m_isObstacle(false),
+			   m_moveMask(0)
+{
+}
+
 Node::~Node(void)
 {
 }
 
 //--------------------------------------------------------------------------------------
-// Update the text on the screen.
-// Param1: The current application data.
+// Initialises the node.
+// Param1: The unique identifier of the node.
+// Param2: The position of the node in grid space.
+// Param3: The position of the node in world space.
+// Param4: Tells whether the node is blocked by an obstacle.
+// Param5: The storage for the rarely accessed data of the node.
 //--------------------------------------------------------------------------------------
-void Node::Initialise(unsigned long id, const XMFLOAT2& gridPos, const XMFLOAT2& worldPos, bool isObstacle)
+void Node::Initialise(unsigned long id, const XMFLOAT2& gridPos, const XMFLOAT2& worldPos, bool isObstacle, NodeProperties* pProperties)
 {
 	m_nodeId = id;
 	m_gridPos = gridPos;
-	m_worldPos = worldPos;
 	m_isObstacle = isObstacle;
-}
-
-//--------------------------------------------------------------------------------------
-// Adds a node to this node's adjacent ones.
-// Param1: A pointer to the node to add to this node's adjacent ones.
-// Returns true if the node was added to the list of adjacent nodes, false if the passed in
-// node was invalid or already contained in the list.
-//--------------------------------------------------------------------------------------
-bool Node::AddAdjacentNode(Node* pNode)
-{
-	if(pNode == nullptr)
-	{
-		// Invalid pointer
-		return false;
-	}
-
-	for(std::vector<Node*>::iterator it = m_adjacentNodes.begin(); it != m_adjacentNodes.end(); ++it)
-	{
-		if((*it)->m_nodeId == pNode->m_nodeId)
-		{
-			// Node is already contained as an adjacent one
-			return false;
-		}
-	}
-
-	m_adjacentNodes.push_back(pNode);
-
-	return true;
+	m_pProperties = pProperties;
+	m_pProperties->m_worldPos = worldPos;
 }
 
 //--------------------------------------------------------------------------------------
@@ -75,15 +54,15 @@ bool Node::AddAdjacentNode(Node* pNode)
 //--------------------------------------------------------------------------------------
 void Node::Reset(void)
 {
-	m_isObstacle       = false;
-	m_pObstacle        = nullptr;
-	m_isEntranceToBase = false;
-	m_isAttackPosition = None;
-	m_territoryOwner   = None;
+	m_isObstacle                      = false;
+	m_pProperties->m_pObstacle        = nullptr;
+	m_pProperties->m_isEntranceToBase = false;
+	m_pProperties->m_isAttackPosition = None;
+	m_pProperties->m_territoryOwner   = None;
 
 	for(unsigned int i = 0; i < NumberOfDirections; ++i)
 	{
-		m_coverProvided[i] = false;
+		m_pProperties->m_coverProvided[i] = false;
 	}
 }
 
@@ -94,11 +73,6 @@ unsigned long Node::GetId(void) const
 	return m_nodeId;
 }
 
-const Node* Node::GetParent(void) const
-{
-	return m_pParentNode;
-}
-
 const XMFLOAT2& Node::GetGridPosition(void) const
 {
 	return m_gridPos;
@@ -106,7 +80,7 @@ const XMFLOAT2& Node::GetGridPosition(void) const
 
 const XMFLOAT2& Node::GetWorldPosition(void) const
 {
-	return m_worldPos;
+	return m_pProperties->m_worldPos;
 }
 
 bool Node::IsObstacle(void) const
@@ -116,47 +90,32 @@ bool Node::IsObstacle(void) const
 
 CollidableObject* Node::GetObstacle(void) 
 {
-	return m_pObstacle;
+	return m_pProperties->m_pObstacle;
 }
 
 bool Node::IsCovered(Direction direction) const
 {
-	return m_coverProvided[direction];
+	return m_pProperties->m_coverProvided[direction];
 }
 
 EntityTeam Node::GetTerritoryOwner(void) const
 {
-	return m_territoryOwner;
+	return m_pProperties->m_territoryOwner;
 }
 
 EntityTeam Node::GetAttackPosition(void) const
 {
-	return m_isAttackPosition;
+	return m_pProperties->m_isAttackPosition;
 }
 
 bool Node::IsEntranceToBase(void) const
 {
-	return m_isEntranceToBase;
+	return m_pProperties->m_isEntranceToBase;
 }
 
-const std::vector<Node*>& Node::GetAdjacentNodes(void) const
+unsigned char Node::GetMoveMask(void) const
 {
-	return m_adjacentNodes;
-}
-
-float Node::GetMovementCost(void) const
-{
-	return m_movementCost;
-}
-	
-float Node::GetHeurisitcValue(void) const
-{
-	return m_heuristicValue;
-}
-
-float Node::GetTotalEstimate(void) const
-{
-	return m_movementCost + m_heuristicValue;
+	return m_moveMask;
 }
 
 void Node::SetId(unsigned long id)
@@ -164,11 +123,6 @@ void Node::SetId(unsigned long id)
 	m_nodeId = id;
 }
 
-void Node::SetParent(Node* node)
-{
-	m_pParentNode = node;
-}
-
 void Node::SetGridPosition(const XMFLOAT2& gridPos)
 {
 	m_gridPos = gridPos;
@@ -176,42 +130,37 @@ void Node::SetGridPosition(const XMFLOAT2& gridPos)
 
 void Node::SetWorldPosition(const XMFLOAT2& worldPos)
 {
-	m_worldPos = worldPos;
+	m_pProperties->m_worldPos = worldPos;
 }
 
 void Node::SetObstacle(CollidableObject* pObstacle)
 {
-	m_pObstacle = pObstacle;
+	m_pProperties->m_pObstacle = pObstacle;
 
-	m_isObstacle = (m_pObstacle != nullptr);
+	m_isObstacle = (pObstacle != nullptr);
 }
 
 void Node::SetCovered(Direction direction, bool isCovered)
 {
-	m_coverProvided[direction] = isCovered;
+	m_pProperties->m_coverProvided[direction] = isCovered;
 }
 
 void Node::SetTerritoryOwner(EntityTeam team)
 {
-	m_territoryOwner = team;
+	m_pProperties->m_territoryOwner = team;
 }
 
 void Node::SetEntranceToBase(bool isEntrance)
 {
-	m_isEntranceToBase = isEntrance;
+	m_pProperties->m_isEntranceToBase = isEntrance;
 }
 
 void Node::SetAttackPosition(EntityTeam team)
 {
-	m_isAttackPosition = team;
+	m_pProperties->m_isAttackPosition = team;
 }
 
-void Node::SetMovementCost(float cost) 
-{
-	m_movementCost = cost;
-}
-	
-void Node::SetHeurisitcValue(float heuristicValue) 
+void Node::SetMoveMask(unsigned char moveMask)
 {
-	m_heuristicValue = heuristicValue;
+	m_moveMask = moveMask;
 }
\ No newline at end of file
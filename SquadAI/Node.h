@@ -16,6 +16,30 @@
 
 using namespace DirectX;
 
+// The number of moves leading from a node to its adjacent nodes
+const unsigned int g_kNumberOfMoves = 8;
+
+// The offsets in grid fields along the x and y axis for each move, bit i of the move mask of a node
+// is set if move i is legal
+const int g_kMoveOffsetX[g_kNumberOfMoves] = {-1, -1, -1, 1,  1, 1,  0, 0};
+const int g_kMoveOffsetY[g_kNumberOfMoves] = { 0, -1,  1, 0, -1, 1, -1, 1};
+
+//--------------------------------------------------------------------------------------
+// The data of a node that is rarely needed while searching the graph. The properties of all
+// nodes are stored in an array of their own, which keeps the nodes themselves small, so that
+// searches and line of sight checks touch less memory.
+//--------------------------------------------------------------------------------------
+struct NodeProperties
+{
+	NodeProperties(void);
+
+	XMFLOAT2		  m_worldPos;						   // The position of the node in world space
+	CollidableObject* m_pObstacle;					       // The obstacle placed on the node, null if there is no obstacle
+	bool		      m_coverProvided[NumberOfDirections]; // Tells whether the node is covered from some directions or is all in the open
+	EntityTeam        m_territoryOwner;					   // Tells whether the node is part of the base of a team
+	bool              m_isEntranceToBase;				   // Tells whether the node is an entrance node into a team base
+	EntityTeam        m_isAttackPosition;			       // Tells for which team the node is an attack position
+};
 
 class Node
 {
@@ -23,14 +47,12 @@ public:
 	Node(void);
 	~Node(void);
 
-	void Initialise(unsigned long id, const XMFLOAT2& gridPos, const XMFLOAT2& worldPos, bool isObstacle);
-	bool AddAdjacentNode(Node* pNode);
+	void Initialise(unsigned long id, const XMFLOAT2& gridPos, const XMFLOAT2& worldPos, bool isObstacle, NodeProperties* pProperties);
 
 	void Reset(void);
 
 	// Data access functions
 	unsigned long			  GetId(void) const;
-	const Node*				  GetParent(void) const;
 	const XMFLOAT2&			  GetGridPosition(void) const;
 	const XMFLOAT2&			  GetWorldPosition(void) const;
 	bool					  IsObstacle(void) const;
@@ -39,13 +61,9 @@ public:
 	EntityTeam				  GetTerritoryOwner(void) const;
 	EntityTeam                GetAttackPosition(void) const;
 	bool  		              IsEntranceToBase(void) const;
-	const std::vector<Node*>& GetAdjacentNodes(void) const;
-	float					  GetMovementCost(void) const;
-	float					  GetHeurisitcValue(void) const;
-	float					  GetTotalEstimate(void) const;
+	unsigned char			  GetMoveMask(void) const;
 
 	void SetId(unsigned long id);
-	void SetParent(Node* node);
 	void SetGridPosition(const XMFLOAT2& gridPos);
 	void SetWorldPosition(const XMFLOAT2& worldPos);
 	void SetObstacle(CollidableObject* pObstacle);
@@ -53,25 +71,14 @@ public:
 	void SetTerritoryOwner(EntityTeam team);
 	void SetEntranceToBase(bool isEntrance);
 	void SetAttackPosition(EntityTeam team);
-	void SetMovementCost(float cost);
-	void SetHeurisitcValue(float heuristicValue);
+	void SetMoveMask(unsigned char moveMask);
 
 private:
-	unsigned long	  m_nodeId;							   // Each node has a unique identifier associated to it for quick comparsion
-	Node*			  m_pParentNode;                       // The current parent node to this one
-	XMFLOAT2		  m_gridPos;					       // The position of the node in grid space and grid units
-	XMFLOAT2		  m_worldPos;						   // The position of the node in world space
-	bool			  m_isObstacle;					       // Tells whether this node is an obstacle or can be traversed
-	CollidableObject* m_pObstacle;					       // The obstacle placed on this node, null if there is no obstacle
-	bool		      m_coverProvided[NumberOfDirections]; // Tells whether this node is covered from some directions or is all in the open
-	EntityTeam        m_territoryOwner;					   // Tells whether this node is part of the base of a team
-	bool              m_isEntranceToBase;				   // Tells whether the node is an entrance node into a team base
-	EntityTeam        m_isAttackPosition;			       // Tells for which team this node is an attack position.
-
-	// Needed for pathfinding
-	std::vector<Node*> m_adjacentNodes;				   // The nodes in the graph that can be directly reached from this one
-	float			   m_movementCost;				   // The cost of a path from the start position to this node
-	float			   m_heuristicValue;			   // A heuristic value used as an estimate of the cost from this node to the target
+	unsigned long	  m_nodeId;		 // Each node has a unique identifier associated to it for quick comparsion
+	XMFLOAT2		  m_gridPos;	 // The position of the node in grid space and grid units
+	NodeProperties*	  m_pProperties; // The rarely accessed data of this node, stored apart from the node
+	bool			  m_isObstacle;	 // Tells whether this node is an obstacle or can be traversed
+	unsigned char	  m_moveMask;	 // The legal moves to the adjacent nodes, a move is legal if it neither leads onto an obstacle nor cuts its corner
 };
 
 #endif // NODE_H
\ No newline at end of file
@@ -0,0 +1,212 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  NodeHeap.cpp
+*  An indexed binary min-heap of graph node ids ordered by their total cost estimate.
+*  Used as the open list by the pathfinder. The search data of every node stores the 
+*  position of the node within the heap, which allows the cost of a node to be decreased
+*  without searching for it.
+*/
+
+// Includes
+#include "NodeHeap.h"
+
+NodeHeap::NodeHeap(void) : m_pNodeData(nullptr)
+{
+}
+
+NodeHeap::~NodeHeap(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Binds the heap to the search data of the nodes it will hold.
+// Param1: A pointer to the search data of all nodes, indexed by node id.
+//--------------------------------------------------------------------------------------
+void NodeHeap::Initialise(std::vector<SearchNodeData>* pNodeData)
+{
+	m_pNodeData = pNodeData;
+}
+
+//--------------------------------------------------------------------------------------
+// Adds a node to the heap.
+// Param1: The id of the node to add. The node must not be contained in the heap yet.
+//--------------------------------------------------------------------------------------
+void NodeHeap::Push(unsigned long id)
+{
+	m_nodes.push_back(id);
+	(*m_pNodeData)[id].m_heapIndex = m_nodes.size() - 1;
+	SiftUp(m_nodes.size() - 1);
+}
+
+//--------------------------------------------------------------------------------------
+// Removes the node with the smallest total estimate from the heap. The heap must not be empty.
+// Returns the id of the removed node.
+//--------------------------------------------------------------------------------------
+unsigned long NodeHeap::Pop(void)
+{
+	unsigned long top = m_nodes[0];
+
+	// Move the last node to the top and restore the heap property
+	unsigned long last = m_nodes.back();
+	m_nodes.pop_back();
+
+	if(!m_nodes.empty())
+	{
+		Place(last, 0);
+		SiftDown(0);
+	}
+
+	return top;
+}
+
+//--------------------------------------------------------------------------------------
+// Looks up the node with the smallest total estimate without removing it. The heap must not be empty.
+// Returns the id of the node at the top of the heap.
+//--------------------------------------------------------------------------------------
+unsigned long NodeHeap::Top(void) const
+{
+	return m_nodes[0];
+}
+
+//--------------------------------------------------------------------------------------
+// Restores the heap property after the total estimate of a node contained in the heap
+// was lowered.
+// Param1: The id of the node, whose cost was decreased.
+//--------------------------------------------------------------------------------------
+void NodeHeap::DecreaseKey(unsigned long id)
+{
+	SiftUp((*m_pNodeData)[id].m_heapIndex);
+}
+
+//--------------------------------------------------------------------------------------
+// Restores the heap property after the total estimates of any number of nodes contained in
+// the heap were changed.
+//--------------------------------------------------------------------------------------
+void NodeHeap::Rebuild(void)
+{
+	// Sift down all nodes that have children, starting with the last one
+	for(unsigned int index = m_nodes.size() / 2; index > 0; --index)
+	{
+		SiftDown(index - 1);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Removes all nodes from the heap. Keeps the allocated memory for the next search.
+//--------------------------------------------------------------------------------------
+void NodeHeap::Clear(void)
+{
+	m_nodes.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// Makes sure that the heap is able to hold a given number of nodes without reallocating.
+// Param1: The number of nodes the heap should be able to hold.
+//--------------------------------------------------------------------------------------
+void NodeHeap::Reserve(unsigned int capacity)
+{
+	m_nodes.reserve(capacity);
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the order of two nodes within the heap. Ties between nodes with the same total
+// estimate are broken in favour of the node closer to the target (smaller heuristic value).
+// Param1: The id of the first node.
+// Param2: The id of the second node.
+// Returns true if the first node should be placed above the second one.
+//--------------------------------------------------------------------------------------
+bool NodeHeap::IsLess(unsigned long id1, unsigned long id2) const
+{
+	const SearchNodeData& data1 = (*m_pNodeData)[id1];
+	const SearchNodeData& data2 = (*m_pNodeData)[id2];
+
+	if(data1.GetTotalEstimate() != data2.GetTotalEstimate())
+	{
+		return data1.GetTotalEstimate() < data2.GetTotalEstimate();
+	}
+
+	return data1.m_heuristicValue < data2.m_heuristicValue;
+}
+
+//--------------------------------------------------------------------------------------
+// Moves a node up the heap until its parent is no longer greater than the node itself.
+// Param1: The current index of the node to move.
+//--------------------------------------------------------------------------------------
+void NodeHeap::SiftUp(unsigned int index)
+{
+	unsigned long id = m_nodes[index];
+
+	while(index > 0)
+	{
+		unsigned int parentIndex = (index - 1) / 2;
+
+		if(!IsLess(id, m_nodes[parentIndex]))
+		{
+			break;
+		}
+
+		Place(m_nodes[parentIndex], index);
+		index = parentIndex;
+	}
+
+	Place(id, index);
+}
+
+//--------------------------------------------------------------------------------------
+// Moves a node down the heap until none of its children is smaller than the node itself.
+// Param1: The current index of the node to move.
+//--------------------------------------------------------------------------------------
+void NodeHeap::SiftDown(unsigned int index)
+{
+	unsigned long id = m_nodes[index];
+	unsigned int size = m_nodes.size();
+
+	while(2 * index + 1 < size)
+	{
+		unsigned int childIndex = 2 * index + 1;
+
+		// Pick the smaller of the two children
+		if((childIndex + 1 < size) && IsLess(m_nodes[childIndex + 1], m_nodes[childIndex]))
+		{
+			++childIndex;
+		}
+
+		if(!IsLess(m_nodes[childIndex], id))
+		{
+			break;
+		}
+
+		Place(m_nodes[childIndex], index);
+		index = childIndex;
+	}
+
+	Place(id, index);
+}
+
+//--------------------------------------------------------------------------------------
+// Stores a node at a certain position within the heap and updates its heap index.
+// Param1: The id of the node to store.
+// Param2: The index, at which to store the node.
+//--------------------------------------------------------------------------------------
+void NodeHeap::Place(unsigned long id, unsigned int index)
+{
+	m_nodes[index] = id;
+	(*m_pNodeData)[id].m_heapIndex = index;
+}
+
+// Data access functions
+
+bool NodeHeap::IsEmpty(void) const
+{
+	return m_nodes.empty();
+}
+
+unsigned int NodeHeap::GetSize(void) const
+{
+	return m_nodes.size();
+}
+
+unsigned long NodeHeap::GetNode(unsigned int index) const
+{
+	return m_nodes[index];
+}
@@ -0,0 +1,48 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  NodeHeap.h
+*  An indexed binary min-heap of graph node ids ordered by their total cost estimate.
+*  Used as the open list by the pathfinder. The search data of every node stores the 
+*  position of the node within the heap, which allows the cost of a node to be decreased
+*  without searching for it.
+*/
+
+#ifndef NODE_HEAP_H
+#define NODE_HEAP_H
+
+// Includes
+#include <vector>
+#include "PathfindingData.h"
+
+class NodeHeap
+{
+public:
+	NodeHeap(void);
+	~NodeHeap(void);
+
+	void		  Initialise(std::vector<SearchNodeData>* pNodeData);
+	void		  Push(unsigned long id);
+	unsigned long Pop(void);
+	unsigned long Top(void) const;
+	void		  DecreaseKey(unsigned long id);
+	void		  Rebuild(void);
+	void		  Clear(void);
+	void		  Reserve(unsigned int capacity);
+
+	// Data access functions
+
+	bool          IsEmpty(void) const;
+	unsigned int  GetSize(void) const;
+	unsigned long GetNode(unsigned int index) const;
+
+private:
+	bool IsLess(unsigned long id1, unsigned long id2) const;
+	void SiftUp(unsigned int index);
+	void SiftDown(unsigned int index);
+	void Place(unsigned long id, unsigned int index);
+
+	std::vector<SearchNodeData>* m_pNodeData; // The search data of all nodes, holds the costs and heap indices of the nodes
+	std::vector<unsigned long>   m_nodes;	  // The ids of the nodes currently stored in the heap, the first one has the smallest total estimate
+};
+
+#endif // NODE_HEAP_H
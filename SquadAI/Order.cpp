@@ -103,9 +103,11 @@ void AttackOrder::SetEnemyPosition(const XMFLOAT2& enemyPosition)
 // class MoveOrder
 //--------------------------------------------------------------------------------------
 
-MoveOrder::MoveOrder(unsigned long entityId, OrderType orderType, OrderPriority priority, const XMFLOAT2& targetPosition)
+MoveOrder::MoveOrder(unsigned long entityId, OrderType orderType, OrderPriority priority, const XMFLOAT2& targetPosition, float pathSuboptimality, PathfindingAlgorithm pathfindingAlgorithm)
 	: Order(entityId, orderType, priority),
-	  m_targetPosition(targetPosition)
+	  m_targetPosition(targetPosition),
+	  m_pathSuboptimality(pathSuboptimality),
+	  m_pathfindingAlgorithm(pathfindingAlgorithm)
 {
 }
 
@@ -125,11 +127,31 @@ std::vector<XMFLOAT2>* MoveOrder::GetPath(void)
 	return &m_path;
 }
 
+float MoveOrder::GetPathSuboptimality(void) const
+{
+	return m_pathSuboptimality;
+}
+
+PathfindingAlgorithm MoveOrder::GetPathfindingAlgorithm(void) const
+{
+	return m_pathfindingAlgorithm;
+}
+
 void MoveOrder::SetTargetPosition(const XMFLOAT2& targetPosition)
 {
 	m_targetPosition = targetPosition;
 }
 
+void MoveOrder::SetPathSuboptimality(float pathSuboptimality)
+{
+	m_pathSuboptimality = pathSuboptimality;
+}
+
+void MoveOrder::SetPathfindingAlgorithm(PathfindingAlgorithm pathfindingAlgorithm)
+{
+	m_pathfindingAlgorithm = pathfindingAlgorithm;
+}
+
 
 //--------------------------------------------------------------------------------------
 // class DefendOrder
@@ -11,6 +11,7 @@
 // Includes
 #include <DirectXMath.h>
 #include <vector>
+#include "PathfindingData.h"
 
 using namespace DirectX;
 
@@ -101,20 +102,26 @@ private:
 class MoveOrder : public Order
 {
 public:
-	MoveOrder(unsigned long entityId, OrderType orderType, OrderPriority priority, const XMFLOAT2& targetPosition);
+	MoveOrder(unsigned long entityId, OrderType orderType, OrderPriority priority, const XMFLOAT2& targetPosition, float pathSuboptimality = 0.0f, PathfindingAlgorithm pathfindingAlgorithm = AdaptiveAStar);
 	~MoveOrder(void);
 
 	// Data access functions
 
 	const XMFLOAT2&		   GetTargetPosition(void) const;
 	std::vector<XMFLOAT2>* GetPath(void);
+	float				   GetPathSuboptimality(void) const;
+	PathfindingAlgorithm   GetPathfindingAlgorithm(void) const;
 
 	void SetTargetPosition(const XMFLOAT2& targetPosition);
+	void SetPathSuboptimality(float pathSuboptimality);
+	void SetPathfindingAlgorithm(PathfindingAlgorithm pathfindingAlgorithm);
 	
 
 private:
-	XMFLOAT2              m_targetPosition; // The position, to which the entity should move
-	std::vector<XMFLOAT2> m_path;			// The path that the entity should follow (optional, can be empty -> entity will choose path itself)
+	XMFLOAT2              m_targetPosition;	   // The position, to which the entity should move
+	std::vector<XMFLOAT2> m_path;			   // The path that the entity should follow (optional, can be empty -> entity will choose path itself)
+	float				  m_pathSuboptimality; // How much longer than the shortest one the path of the entity may be (0.25 -> up to 25% longer), 0 for moves that have to be fast
+	PathfindingAlgorithm  m_pathfindingAlgorithm; // The algorithm used when the entity searches the path itself, HPA* or bidirectional A* for long cross-map moves
 };
 
 //--------------------------------------------------------------------------------------
@@ -0,0 +1,179 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  PathCache.cpp
+*  A least recently used cache for the results of path searches. Entities often request
+*  the same routes, for instance when a team is ordered to the same position, the cache
+*  allows them to share the result of a single search. The cached paths are immutable and
+*  shared between all holders. The cache is bound to a version of the obstacle layout of the
+*  test environment and discards all entries when the version changes.
+*/
+
+// Includes
+#include "PathCache.h"
+#include "ApplicationSettings.h"
+
+PathCache::PathCache(void) : m_capacity(g_kPathCacheCapacity),
+							 m_version(0),
+							 m_hits(0),
+							 m_misses(0)
+{
+}
+
+PathCache::~PathCache(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Looks up the result of a path search and marks it as most recently used.
+// Param1: The key identifying the search.
+// Param2: The current version of the obstacle layout of the test environment.
+// Param3: Will hold the cached path if one was found, nullptr if the search is known to
+//         have failed.
+// Returns true if the result of the search is cached, false otherwise.
+//--------------------------------------------------------------------------------------
+bool PathCache::Find(const PathCacheKey& key, unsigned int version, std::shared_ptr<const std::vector<XMFLOAT2>>& pPath)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	SetVersion(version);
+
+	std::unordered_map<PathCacheKey, std::list<CacheEntry>::iterator, PathCacheKeyHash>::iterator foundIt = m_lookup.find(key);
+
+	if(foundIt == m_lookup.end())
+	{
+		++m_misses;
+		return false;
+	}
+
+	// Move the entry to the front of the list
+	m_entries.splice(m_entries.begin(), m_entries, foundIt->second);
+
+	pPath = foundIt->second->second;
+
+	++m_hits;
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Adds the result of a path search to the cache. The least recently used entry is removed
+// if the cache is full.
+// Param1: The key identifying the search.
+// Param2: The version of the obstacle layout of the test environment the path was calculated for.
+// Param3: The path, nullptr if the search failed.
+//--------------------------------------------------------------------------------------
+void PathCache::Insert(const PathCacheKey& key, unsigned int version, const std::shared_ptr<const std::vector<XMFLOAT2>>& pPath)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	SetVersion(version);
+
+	if(m_capacity == 0)
+	{
+		return;
+	}
+
+	std::unordered_map<PathCacheKey, std::list<CacheEntry>::iterator, PathCacheKeyHash>::iterator foundIt = m_lookup.find(key);
+
+	if(foundIt != m_lookup.end())
+	{
+		// Another search stored the same path in the meantime, refresh it
+		foundIt->second->second = pPath;
+		m_entries.splice(m_entries.begin(), m_entries, foundIt->second);
+		return;
+	}
+
+	while(m_entries.size() >= m_capacity)
+	{
+		Evict();
+	}
+
+	m_entries.push_front(CacheEntry(key, pPath));
+	m_lookup.insert(std::pair<PathCacheKey, std::list<CacheEntry>::iterator>(key, m_entries.begin()));
+}
+
+//--------------------------------------------------------------------------------------
+// Removes all paths from the cache.
+//--------------------------------------------------------------------------------------
+void PathCache::Clear(void)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_entries.clear();
+	m_lookup.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// Resets the hit and miss counters.
+//--------------------------------------------------------------------------------------
+void PathCache::ResetStatistics(void)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_hits   = 0;
+	m_misses = 0;
+}
+
+//--------------------------------------------------------------------------------------
+// Discards all cached paths if they were calculated for another version of the obstacle
+// layout. The mutex has to be locked by the caller.
+// Param1: The current version of the obstacle layout.
+//--------------------------------------------------------------------------------------
+void PathCache::SetVersion(unsigned int version)
+{
+	if(version != m_version)
+	{
+		m_entries.clear();
+		m_lookup.clear();
+		m_version = version;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Removes the least recently used path from the cache. The mutex has to be locked by the caller.
+//--------------------------------------------------------------------------------------
+void PathCache::Evict(void)
+{
+	if(!m_entries.empty())
+	{
+		m_lookup.erase(m_entries.back().first);
+		m_entries.pop_back();
+	}
+}
+
+// Data access functions
+
+unsigned int PathCache::GetCapacity(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_capacity;
+}
+
+unsigned int PathCache::GetSize(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+unsigned long PathCache::GetHitCount(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_hits;
+}
+
+unsigned long PathCache::GetMissCount(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_misses;
+}
+
+void PathCache::SetCapacity(unsigned int capacity)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_capacity = capacity;
+
+	while(m_entries.size() > m_capacity)
+	{
+		Evict();
+	}
+}
@@ -0,0 +1,112 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  PathCache.h
+*  A least recently used cache for the results of path searches. Entities often request
+*  the same routes, for instance when a team is ordered to the same position, the cache
+*  allows them to share the result of a single search. The cached paths are immutable and
+*  shared between all holders. The cache is bound to a version of the obstacle layout of the
+*  test environment and discards all entries when the version changes.
+*/
+
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+// Includes
+#include <DirectXMath.h>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include "PathfindingData.h"
+
+using namespace DirectX;
+
+//--------------------------------------------------------------------------------------
+// Identifies a path search. Searches with identical keys produce identical paths as long
+// as the obstacles of the test environment do not change.
+//--------------------------------------------------------------------------------------
+struct PathCacheKey
+{
+	PathCacheKey(void) : m_startId(0),
+						 m_targetId(0),
+						 m_algorithm(AStar),
+						 m_heuristic(EuclideanDistance),
+						 m_suboptimality(0.0f)
+	{}
+
+	PathCacheKey(unsigned long startId, unsigned long targetId, PathfindingAlgorithm algorithm, Heuristic heuristic, float suboptimality, const TraversalWeights& weights) 
+		: m_startId(startId),
+		  m_targetId(targetId),
+		  m_algorithm(algorithm),
+		  m_heuristic(heuristic),
+		  m_suboptimality(suboptimality),
+		  m_weights(weights)
+	{}
+
+	bool operator==(const PathCacheKey& other) const
+	{
+		return m_startId == other.m_startId && m_targetId == other.m_targetId &&
+			   m_algorithm == other.m_algorithm && m_heuristic == other.m_heuristic &&
+			   m_suboptimality == other.m_suboptimality &&
+			   m_weights.m_horizontalCost == other.m_weights.m_horizontalCost &&
+			   m_weights.m_verticalCost == other.m_weights.m_verticalCost &&
+			   m_weights.m_diagonalCost == other.m_weights.m_diagonalCost;
+	}
+
+	unsigned long		 m_startId;		  // The id of the start node of the path
+	unsigned long		 m_targetId;	  // The id of the target node of the path
+	PathfindingAlgorithm m_algorithm;	  // The algorithm used to find the path
+	Heuristic			 m_heuristic;	  // The heuristic used to find the path
+	float				 m_suboptimality; // The suboptimality bound the path was calculated with
+	TraversalWeights	 m_weights;		  // The traversal weights in use when the path was calculated
+};
+
+//--------------------------------------------------------------------------------------
+// Hash function for path cache keys.
+//--------------------------------------------------------------------------------------
+struct PathCacheKeyHash
+{
+	size_t operator()(const PathCacheKey& key) const
+	{
+		// The weights and the suboptimality bound take few distinct values, the nodes and the algorithm are sufficient to spread the keys
+		return std::hash<unsigned long>()(key.m_startId * 2654435761UL ^ key.m_targetId) ^ (static_cast<size_t>(key.m_algorithm) << 24) ^ (static_cast<size_t>(key.m_heuristic) << 28);
+	}
+};
+
+class PathCache
+{
+public:
+	PathCache(void);
+	~PathCache(void);
+
+	bool Find(const PathCacheKey& key, unsigned int version, std::shared_ptr<const std::vector<XMFLOAT2>>& pPath);
+	void Insert(const PathCacheKey& key, unsigned int version, const std::shared_ptr<const std::vector<XMFLOAT2>>& pPath);
+	void Clear(void);
+	void ResetStatistics(void);
+
+	// Data access functions
+
+	unsigned int  GetCapacity(void) const;
+	unsigned int  GetSize(void) const;
+	unsigned long GetHitCount(void) const;
+	unsigned long GetMissCount(void) const;
+
+	void SetCapacity(unsigned int capacity);
+
+private:
+	typedef std::pair<PathCacheKey, std::shared_ptr<const std::vector<XMFLOAT2>>> CacheEntry;
+
+	void SetVersion(unsigned int version);
+	void Evict(void);
+
+	std::list<CacheEntry>																	 m_entries;	 // The cached paths, the most recently used one comes first
+	std::unordered_map<PathCacheKey, std::list<CacheEntry>::iterator, PathCacheKeyHash> m_lookup;	 // Maps keys to their entries for constant time lookup
+	unsigned int																			 m_capacity; // The maximal number of paths held by the cache
+	unsigned int																			 m_version;	 // The version of the obstacle layout that the cached paths are valid for
+	unsigned long																			 m_hits;	 // The number of lookups that found a cached path
+	unsigned long																			 m_misses;	 // The number of lookups that did not find a cached path
+	mutable std::mutex																		 m_mutex;	 // Synchronises access from concurrent searches
+};
+
+#endif // PATH_CACHE_H
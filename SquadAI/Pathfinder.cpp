@@ -5,10 +5,14 @@
 */
 
 // Includes
+#include <cfloat>
+#include <climits>
+#include <algorithm>
 #include "Pathfinder.h"
 #include "TestEnvironment.h"
+#include "ReservationTable.h"
 
-Pathfinder::Pathfinder(void)
+Pathfinder::Pathfinder(void) : m_pEnvironment(nullptr)
 {
 	
 }
@@ -23,7 +27,7 @@ Pathfinder::~Pathfinder(void)
 // Param1: A pointer to the test environment that the pathfinder should work with.
 // Returns true if the pathfinder could be initialised successfully, false otherwise.
 //--------------------------------------------------------------------------------------
-bool Pathfinder::Initialise(TestEnvironment* pTestEnvironment)
+bool Pathfinder::Initialise(const TestEnvironment* pTestEnvironment)
 {
 	if(!pTestEnvironment)
 	{
@@ -49,124 +53,1813 @@ void Pathfinder::UpdateWeights()
 }
 
 //--------------------------------------------------------------------------------------
-// Calculates a path consisting of 2D coordinates.
+// Calculates a path consisting of 2D coordinates. The results are cached, repeated requests
+// between the same grid fields are served without searching as long as the obstacles and
+// weights do not change.
 // Param1: Determines which algorithm to use for calculation of the path.
 // Param2: The heuristic to use to estimate costs from nodes to the target.
-// Param3: The start position of the path in world space.
-// Param4: The destination position of the path in world space.
-// Param5: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param3: The suboptimality bound epsilon, the cost of the path will be at most (1 + epsilon) times
+//         the cost of the shortest path. Larger values trade path quality for fewer expanded nodes,
+//         0 requests a shortest path.
+// Param4: The start position of the path in world space.
+// Param5: The destination position of the path in world space.
+// Param6: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param7: The search context holding the scratch data of the search. Concurrent searches
+//         must use different contexts.
 // Returns true if the path could be calculated successfully, false if no valid path exists or start
 // and destination are identical.
 //--------------------------------------------------------------------------------------
-bool Pathfinder::CalculatePath(PathfindingAlgorithm algorithm, Heuristic heuristic, const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition, std::vector<XMFLOAT2>& path)
+bool Pathfinder::CalculatePath(PathfindingAlgorithm algorithm, Heuristic heuristic, float suboptimality, const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const
+{
+	BeginQuery(context);
+
+	XMFLOAT2 startGridPosition;
+	XMFLOAT2 targetGridPosition;
+
+	m_pEnvironment->WorldToGridPosition(startPosition, startGridPosition);
+	m_pEnvironment->WorldToGridPosition(targetPosition, targetGridPosition);
+
+	if((startGridPosition.x < 0) || (targetGridPosition.x < 0) ||
+	   (startGridPosition.y < 0) || (targetGridPosition.y < 0) ||
+	   (startGridPosition.x >= m_pEnvironment->GetNumberOfGridPartitions()) || (targetGridPosition.x >= m_pEnvironment->GetNumberOfGridPartitions()) ||
+	   (startGridPosition.y >= m_pEnvironment->GetNumberOfGridPartitions()) || (targetGridPosition.y >= m_pEnvironment->GetNumberOfGridPartitions()))
+	{
+		// Start or target position lies outside of the test environment.
+		EndQuery(false, nullptr, context);
+		return false;
+	}
+
+	unsigned int numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+
+	PathCacheKey key(static_cast<unsigned long>(startGridPosition.x) * numberOfGridPartitions + static_cast<unsigned long>(startGridPosition.y),
+					 static_cast<unsigned long>(targetGridPosition.x) * numberOfGridPartitions + static_cast<unsigned long>(targetGridPosition.y),
+					 algorithm, heuristic, suboptimality, m_weights);
+
+	if(IsKnownUnreachable(key.m_startId, key.m_targetId))
+	{
+		// No need to search, the target lies in a different part of the grid
+		EndQuery(false, nullptr, context);
+		return false;
+	}
+
+	std::shared_ptr<const std::vector<XMFLOAT2>> pCachedPath;
+
+	if(m_pathCache.Find(key, m_pEnvironment->GetObstacleVersion(), pCachedPath))
+	{
+		context.GetQueryStatistics().m_isCacheHit = true;
+
+		if(!pCachedPath)
+		{
+			// The search is known to fail
+			EndQuery(false, nullptr, context);
+			return false;
+		}
+
+		// The caller modifies its path while following it, hand out a copy of the shared buffer
+		path.assign(pCachedPath->begin(), pCachedPath->end());
+		EndQuery(true, &path, context);
+		return true;
+	}
+
+	bool isPathFound = CalculatePathUncached(algorithm, heuristic, suboptimality, startGridPosition, targetGridPosition, path, context);
+
+	if(isPathFound)
+	{
+		pCachedPath = std::make_shared<const std::vector<XMFLOAT2>>(path);
+	}
+
+	m_pathCache.Insert(key, m_pEnvironment->GetObstacleVersion(), pCachedPath);
+
+	EndQuery(isPathFound, &path, context);
+	return isPathFound;
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a path consisting of 2D coordinates without consulting the path cache. A* and
+// jump point search honour the suboptimality bound by inflating the heuristic (weighted A*).
+// Adaptive and bidirectional A* rely on exact path costs and are replaced by weighted A*
+// when a suboptimal path is acceptable. HPA*, Theta* and the navigation mesh search ignore the bound.
+// Param1: The algorithm that should be used to calculate the path.
+// Param2: The heuristic to use to estimate costs from nodes to the target.
+// Param3: The suboptimality bound epsilon, 0 for a shortest path.
+// Param4: The start position of the path in grid fields.
+// Param5: The destination position of the path in grid fields.
+// Param6: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param7: The search context holding the scratch data of the search.
+// Returns true if the path could be calculated successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::CalculatePathUncached(PathfindingAlgorithm algorithm, Heuristic heuristic, float suboptimality, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const
+{
+	float heuristicWeight = 1.0f + suboptimality;
+
+	switch(algorithm)
+	{
+	case AStar:
+		return CalculatePathAStar(heuristic, heuristicWeight, startGridPosition, targetGridPosition, path, context);
+		break;
+	case JumpPointSearch:
+		if(m_weights.m_horizontalCost != m_weights.m_verticalCost)
+		{
+			// Jump point search relies on uniform costs for straight moves, use A* otherwise
+			return CalculatePathAStar(heuristic, heuristicWeight, startGridPosition, targetGridPosition, path, context);
+		}
+		return CalculatePathJumpPointSearch(heuristic, heuristicWeight, startGridPosition, targetGridPosition, path, context);
+		break;
+	case HierarchicalAStar:
+		return CalculatePathHierarchical(heuristic, startGridPosition, targetGridPosition, path, context);
+		break;
+	case AdaptiveAStar:
+		if(suboptimality > 0.0f)
+		{
+			// Heuristic values learned from suboptimal paths would overestimate
+			return CalculatePathAStar(heuristic, heuristicWeight, startGridPosition, targetGridPosition, path, context);
+		}
+		return CalculatePathAdaptiveAStar(heuristic, startGridPosition, targetGridPosition, path, context);
+		break;
+	case ThetaStar:
+		return CalculatePathThetaStar(heuristic, startGridPosition, targetGridPosition, path, context);
+		break;
+	case BidirectionalAStar:
+		if(suboptimality > 0.0f)
+		{
+			// The stopping condition of the bidirectional search requires consistent estimates
+			return CalculatePathAStar(heuristic, heuristicWeight, startGridPosition, targetGridPosition, path, context);
+		}
+		return CalculatePathBidirectional(heuristic, startGridPosition, targetGridPosition, path, context);
+		break;
+	case NavigationMeshAStar:
+		return CalculatePathNavigationMesh(heuristic, startGridPosition, targetGridPosition, path, context);
+		break;
+	default:
+		return false;
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Starts a time-sliced A* search for a path. The search expands at most as many nodes as 
+// the budget allows, a search that is not completed within the budget has to be continued
+// by calling ContinuePathSearch with the same search context in later frames. Results are
+// taken from and added to the path cache. HPA* and bidirectional A* cannot be suspended, they
+// run to completion once the budget is not used up and charge their expansions against it.
+// Param1: The algorithm to use, AdaptiveAStar to learn from earlier searches of the context, 
+//         HierarchicalAStar or BidirectionalAStar for long queries, A* is used for all other algorithms.
+// Param2: The heuristic to use to estimate costs from nodes to the target.
+// Param3: The suboptimality bound epsilon, the cost of the path will be at most (1 + epsilon) times
+//         the cost of the shortest path. Adaptive A* is only used for shortest paths (0).
+// Param4: The start position of the path in world space.
+// Param5: The destination position of the path in world space.
+// Param6: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param7: The search context holding the scratch data of the search, it has to be reserved
+//         for the search until it completes.
+// Param8: The maximal number of nodes to expand, reduced by the number of expanded nodes.
+// Returns SearchSucceeded if the path was found, SearchFailed if there is none and SearchPending
+// if the search has to be continued.
+//--------------------------------------------------------------------------------------
+PathSearchStatus Pathfinder::StartPathSearch(PathfindingAlgorithm algorithm, Heuristic heuristic, float suboptimality, const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition, std::vector<XMFLOAT2>& path, SearchContext& context, unsigned int& expansionBudget) const
 {
+	if(context.GetPendingSearch().m_isPending)
+	{
+		// The pending search is abandoned, record the effort spent on it so far
+		EndQuery(false, nullptr, context);
+	}
+
+	context.GetPendingSearch().m_isPending = false;
+
+	if((algorithm == HierarchicalAStar || algorithm == BidirectionalAStar) && expansionBudget == 0)
+	{
+		// The search cannot be suspended, wait for a frame with budget left before starting it
+		return SearchPending;
+	}
+
+	BeginQuery(context);
+
 	XMFLOAT2 startGridPosition;
 	XMFLOAT2 targetGridPosition;
 
-	m_pEnvironment->WorldToGridPosition(startPosition, startGridPosition);
-	m_pEnvironment->WorldToGridPosition(targetPosition, targetGridPosition);
+	m_pEnvironment->WorldToGridPosition(startPosition, startGridPosition);
+	m_pEnvironment->WorldToGridPosition(targetPosition, targetGridPosition);
+
+	if((startGridPosition.x < 0) || (targetGridPosition.x < 0) ||
+	   (startGridPosition.y < 0) || (targetGridPosition.y < 0) ||
+	   (startGridPosition.x >= m_pEnvironment->GetNumberOfGridPartitions()) || (targetGridPosition.x >= m_pEnvironment->GetNumberOfGridPartitions()) ||
+	   (startGridPosition.y >= m_pEnvironment->GetNumberOfGridPartitions()) || (targetGridPosition.y >= m_pEnvironment->GetNumberOfGridPartitions()))
+	{
+		// Start or target position lies outside of the test environment.
+		EndQuery(false, nullptr, context);
+		return SearchFailed;
+	}
+
+	const Node* pStartNode  = m_pEnvironment->GetNode(static_cast<unsigned int>(startGridPosition.x), static_cast<unsigned int>(startGridPosition.y));
+	const Node* pTargetNode = m_pEnvironment->GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y));
+
+	if(IsKnownUnreachable(pStartNode->GetId(), pTargetNode->GetId()))
+	{
+		EndQuery(false, nullptr, context);
+		return SearchFailed;
+	}
+
+	if((algorithm != AdaptiveAStar && algorithm != HierarchicalAStar && algorithm != BidirectionalAStar) ||
+	   (algorithm != HierarchicalAStar && suboptimality > 0.0f))
+	{
+		algorithm = AStar;
+	}
+
+	std::shared_ptr<const std::vector<XMFLOAT2>> pCachedPath;
+
+	if(m_pathCache.Find(PathCacheKey(pStartNode->GetId(), pTargetNode->GetId(), algorithm, heuristic, suboptimality, m_weights), m_pEnvironment->GetObstacleVersion(), pCachedPath))
+	{
+		context.GetQueryStatistics().m_isCacheHit = true;
+
+		if(!pCachedPath)
+		{
+			EndQuery(false, nullptr, context);
+			return SearchFailed;
+		}
+
+		path.assign(pCachedPath->begin(), pCachedPath->end());
+		EndQuery(true, &path, context);
+		return SearchSucceeded;
+	}
+
+	if(algorithm == HierarchicalAStar || algorithm == BidirectionalAStar)
+	{
+		bool isPathFound = CalculatePathUncached(algorithm, heuristic, suboptimality, startGridPosition, targetGridPosition, path, context);
+
+		if(isPathFound)
+		{
+			pCachedPath = std::make_shared<const std::vector<XMFLOAT2>>(path);
+		}
+
+		m_pathCache.Insert(PathCacheKey(pStartNode->GetId(), pTargetNode->GetId(), algorithm, heuristic, suboptimality, m_weights), m_pEnvironment->GetObstacleVersion(), pCachedPath);
+
+		EndQuery(isPathFound, &path, context);
+
+		// The search may have exceeded the remaining budget, it is used up in that case
+		expansionBudget -= std::min<unsigned long>(expansionBudget, context.GetQueryStatistics().m_nodesExpanded);
+
+		return isPathFound ? SearchSucceeded : SearchFailed;
+	}
+
+	if(algorithm == AdaptiveAStar)
+	{
+		StartAdaptiveSearch(heuristic, pStartNode, pTargetNode, context);
+	}else
+	{
+		StartSearch(heuristic, 1.0f + suboptimality, pStartNode, pTargetNode, context);
+	}
+
+	PendingSearch& pendingSearch    = context.GetPendingSearch();
+	pendingSearch.m_isPending       = true;
+	pendingSearch.m_startId         = pStartNode->GetId();
+	pendingSearch.m_targetId        = pTargetNode->GetId();
+	pendingSearch.m_algorithm       = algorithm;
+	pendingSearch.m_heuristic       = heuristic;
+	pendingSearch.m_suboptimality   = suboptimality;
+	pendingSearch.m_obstacleVersion = m_pEnvironment->GetObstacleVersion();
+
+	// The first slice of the search is measured by ContinuePathSearch
+	SuspendQuery(context);
+
+	return ContinuePathSearch(path, context, expansionBudget);
+}
+
+//--------------------------------------------------------------------------------------
+// Continues a time-sliced search started by StartPathSearch.
+// Param1: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param2: The search context holding the scratch data of the search.
+// Param3: The maximal number of nodes to expand, reduced by the number of expanded nodes.
+// Returns SearchSucceeded if the path was found, SearchFailed if there is none or no search
+// is pending in the context and SearchPending if the search has to be continued again.
+//--------------------------------------------------------------------------------------
+PathSearchStatus Pathfinder::ContinuePathSearch(std::vector<XMFLOAT2>& path, SearchContext& context, unsigned int& expansionBudget) const
+{
+	PendingSearch& pendingSearch = context.GetPendingSearch();
+
+	if(!pendingSearch.m_isPending)
+	{
+		return SearchFailed;
+	}
+
+	ResumeQuery(context);
+
+	const Node* pStartNode  = m_pEnvironment->GetNodeById(pendingSearch.m_startId);
+	const Node* pTargetNode = m_pEnvironment->GetNodeById(pendingSearch.m_targetId);
+
+	if(pendingSearch.m_obstacleVersion != m_pEnvironment->GetObstacleVersion())
+	{
+		// The obstacles changed since the search was started, start over
+		PendingSearch restartedSearch = pendingSearch;
+
+		if(pendingSearch.m_algorithm == AdaptiveAStar)
+		{
+			StartAdaptiveSearch(pendingSearch.m_heuristic, pStartNode, pTargetNode, context);
+		}else
+		{
+			StartSearch(pendingSearch.m_heuristic, 1.0f + pendingSearch.m_suboptimality, pStartNode, pTargetNode, context);
+		}
+
+		restartedSearch.m_obstacleVersion = m_pEnvironment->GetObstacleVersion();
+		pendingSearch = restartedSearch;
+	}
+
+	unsigned int maxIndex = m_pEnvironment->GetNumberOfGridPartitions() - 1;
+
+	PathSearchStatus status = ExpandSearch(pendingSearch.m_heuristic, 1.0f + pendingSearch.m_suboptimality, pTargetNode, 0, 0, maxIndex, maxIndex, context, expansionBudget);
+
+	if(status == SearchPending)
+	{
+		SuspendQuery(context);
+		return SearchPending;
+	}
+
+	pendingSearch.m_isPending = false;
+
+	context.EndAdaptiveSearch((status == SearchSucceeded) ? context.GetNodeData(pTargetNode->GetId()).m_movementCost : FLT_MAX);
+
+	std::shared_ptr<const std::vector<XMFLOAT2>> pCachedPath;
+
+	if(status == SearchSucceeded)
+	{
+		ConstructPath(pTargetNode, context, path);
+		pCachedPath = std::make_shared<const std::vector<XMFLOAT2>>(path);
+	}
+
+	m_pathCache.Insert(PathCacheKey(pendingSearch.m_startId, pendingSearch.m_targetId, pendingSearch.m_algorithm, pendingSearch.m_heuristic, pendingSearch.m_suboptimality, m_weights), pendingSearch.m_obstacleVersion, pCachedPath);
+
+	EndQuery(status == SearchSucceeded, &path, context);
+	return status;
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a path consisting of 2D coordinates using the A* algorithm. A heuristic weight
+// greater than 1 turns the search into weighted A*, which expands fewer nodes and finds a 
+// path costing at most the weight times the cost of the shortest one.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The factor, by which the heuristic values are multiplied (1 + epsilon).
+// Param3: The start position of the path in grid fields.
+// Param4: The destination position of the patch in grid fields.
+// Param5: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param6: The search context holding the scratch data of the search.
+// Returns true if the path could be calculated successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::CalculatePathAStar(Heuristic heuristic, float heuristicWeight, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const
+{
+	const Node* pStartNode  = m_pEnvironment->GetNode(static_cast<unsigned int>(startGridPosition.x), static_cast<unsigned int>(startGridPosition.y));
+	const Node* pTargetNode = m_pEnvironment->GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y));
+
+	unsigned int maxIndex = m_pEnvironment->GetNumberOfGridPartitions() - 1;
+
+	if(SearchArea(heuristic, heuristicWeight, pStartNode, pTargetNode, 0, 0, maxIndex, maxIndex, context))
+	{
+		// Construct the path
+		ConstructPath(pTargetNode, context, path);
+		return true;
+	}
+
+	return false;
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a path consisting of 2D coordinates using moving target adaptive A* (MT-Adaptive A*).
+// The search learns more informed heuristic values from the previous adaptive searches of the 
+// same context, which makes repeated searches for a target that moves only a little at a time 
+// (e.g. a chased enemy) expand far fewer nodes than plain A*. The paths are as short as the ones
+// found by A*.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The start position of the path in grid fields.
+// Param3: The destination position of the patch in grid fields.
+// Param4: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param5: The search context holding the scratch data of the search as well as the learned 
+//         heuristic values.
+// Returns true if the path could be calculated successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::CalculatePathAdaptiveAStar(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const
+{
+	const Node* pStartNode  = m_pEnvironment->GetNode(static_cast<unsigned int>(startGridPosition.x), static_cast<unsigned int>(startGridPosition.y));
+	const Node* pTargetNode = m_pEnvironment->GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y));
+
+	unsigned int maxIndex		 = m_pEnvironment->GetNumberOfGridPartitions() - 1;
+	unsigned int expansionBudget = UINT_MAX;
+
+	StartAdaptiveSearch(heuristic, pStartNode, pTargetNode, context);
+
+	if(ExpandSearch(heuristic, 1.0f, pTargetNode, 0, 0, maxIndex, maxIndex, context, expansionBudget) == SearchSucceeded)
+	{
+		context.EndAdaptiveSearch(context.GetNodeData(pTargetNode->GetId()).m_movementCost);
+		ConstructPath(pTargetNode, context, path);
+		return true;
+	}
+
+	context.EndAdaptiveSearch(FLT_MAX);
+	return false;
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates the costs of the shortest paths from a node to all nodes within a rectangular
+// area of the grid that can be reached without leaving the area. The costs are left in the
+// search context, nodes that could not be reached are not closed.
+// Param1: The node to start from, has to lie within the area.
+// Param2: The smallest x-coordinate of the grid fields within the area.
+// Param3: The smallest y-coordinate of the grid fields within the area.
+// Param4: The greatest x-coordinate of the grid fields within the area.
+// Param5: The greatest y-coordinate of the grid fields within the area.
+// Param6: The search context that will hold the costs.
+//--------------------------------------------------------------------------------------
+void Pathfinder::CalculateCostsInArea(const Node* pStartNode, unsigned int minX, unsigned int minY, unsigned int maxX, unsigned int maxY, SearchContext& context) const
+{
+	BeginQuery(context);
+
+	SearchArea(EuclideanDistance, 1.0f, pStartNode, nullptr, minX, minY, maxX, maxY, context);
+
+	EndQuery(true, nullptr, context);
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a path to the closest of several targets in a single search. The search is guided
+// by the octile distance to the closest target, the first target it closes is the nearest one by
+// path cost, which can differ from the one closest in a straight line when walls are in the way.
+// Param1: The start position of the path in world space.
+// Param2: The target positions in world space.
+// Param3: A vector that will hold the path to the closest target.
+// Param4: Will hold the index of the closest target within the target positions.
+// Param5: The search context holding the scratch data of the search.
+// Returns true if a path to one of the targets was found, false if none of them can be reached.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::CalculatePathToNearest(const XMFLOAT2& startPosition, const std::vector<XMFLOAT2>& targetPositions, std::vector<XMFLOAT2>& path, unsigned int& targetIndex, SearchContext& context) const
+{
+	BeginQuery(context);
+
+	const Node* pStartNode = GetNodeAt(startPosition);
+
+	if(!pStartNode)
+	{
+		EndQuery(false, nullptr, context);
+		return false;
+	}
+
+	std::vector<unsigned long> targetIds;
+	
+	if(GetReachableTargets(pStartNode, targetPositions, targetIds) == 0 || SearchTargets(pStartNode, targetIds, 1, context) == 0)
+	{
+		EndQuery(false, nullptr, context);
+		return false;
+	}
+
+	for(unsigned int i = 0; i < targetIds.size(); ++i)
+	{
+		// The search stopped as soon as the first target was closed
+		if(targetIds[i] != ULONG_MAX && context.IsClosed(targetIds[i]))
+		{
+			targetIndex = i;
+			ConstructPath(m_pEnvironment->GetNodeById(targetIds[i]), context, path);
+			EndQuery(true, &path, context);
+			return true;
+		}
+	}
+
+	EndQuery(false, nullptr, context);
+	return false;
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates the costs of the shortest paths from one position to several others in a single
+// search. Traversal costs are symmetric, the costs equal those of the paths leading from the
+// other positions to the source, e.g. from a number of soldiers to a common target.
+// Param1: The source position in world space.
+// Param2: The positions in world space, to which to calculate the path costs.
+// Param3: A vector that will hold the path cost for each of the positions, FLT_MAX for positions
+//         that cannot be reached.
+// Param4: The search context holding the scratch data of the search.
+//--------------------------------------------------------------------------------------
+void Pathfinder::CalculatePathCosts(const XMFLOAT2& sourcePosition, const std::vector<XMFLOAT2>& targetPositions, std::vector<float>& costs, SearchContext& context) const
+{
+	BeginQuery(context);
+
+	costs.assign(targetPositions.size(), FLT_MAX);
+
+	const Node* pSourceNode = GetNodeAt(sourcePosition);
+
+	if(!pSourceNode)
+	{
+		EndQuery(false, nullptr, context);
+		return;
+	}
+
+	std::vector<unsigned long> targetIds;
+	unsigned int numberOfReachableTargets = GetReachableTargets(pSourceNode, targetPositions, targetIds);
+
+	if(numberOfReachableTargets == 0)
+	{
+		EndQuery(false, nullptr, context);
+		return;
+	}
+
+	// The query succeeds if the costs to all reachable targets were found
+	bool isSuccessful = SearchTargets(pSourceNode, targetIds, numberOfReachableTargets, context) == numberOfReachableTargets;
+
+	for(unsigned int i = 0; i < targetIds.size(); ++i)
+	{
+		if(targetIds[i] != ULONG_MAX && context.IsClosed(targetIds[i]))
+		{
+			costs[i] = context.GetNodeData(targetIds[i]).m_movementCost;
+		}
+	}
+
+	EndQuery(isSuccessful, nullptr, context);
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a path that avoids the grid fields reserved by other entities of a team at the
+// time the entity would pass them (windowed hierarchical cooperative A*). The search runs in
+// space and time: each move to an adjacent node or waiting on the current node takes one time
+// step. Moves into fields reserved for the next step and swaps of fields with another entity
+// are not allowed. The search ends when it reaches the target, if no other entity reserved it
+// for the rest of the window, or when it reaches the end of the window. The rest of the path is
+// then calculated by A* without regard to the reservations, these parts are replanned later.
+// Param1: The id of the entity, for which the path is calculated. Its own reservations are ignored.
+// Param2: The start position of the path in world space.
+// Param3: The destination position of the path in world space.
+// Param4: The reservations of the team.
+// Param5: A vector that will hold the path consisting of one node for each time step, the entity
+//         has to wait for a time step wherever a node is repeated.
+// Param6: The search context holding the scratch data of the search. Its node data grows to cover
+//         every time step of the window, so it should not be shared with plain grid searches.
+// Returns true if the path could be calculated successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::CalculateCooperativePath(unsigned long entityId, const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition, const ReservationTable& reservationTable, std::vector<XMFLOAT2>& path, SearchContext& context) const
+{
+	BeginQuery(context);
+
+	const Node* pStartNode  = GetNodeAt(startPosition);
+	const Node* pTargetNode = GetNodeAt(targetPosition);
+
+	if(!pStartNode || !pTargetNode || pTargetNode->IsObstacle() || IsKnownUnreachable(pStartNode->GetId(), pTargetNode->GetId()))
+	{
+		EndQuery(false, nullptr, context);
+		return false;
+	}
+
+	unsigned int  window		= reservationTable.GetWindow();
+	unsigned long numberOfNodes = m_pEnvironment->GetNumberOfGridPartitions() * m_pEnvironment->GetNumberOfGridPartitions();
+
+	// A node of the search is a grid node at a time step, identified by step * numberOfNodes + grid node id
+	context.BeginSearch(numberOfNodes * (window + 1));
+	context.Open(pStartNode->GetId(), pStartNode->GetId(), 0.0f, CalculateOctileDistance(pStartNode, pTargetNode));
+
+	// Waiting costs as much as the cheapest move
+	float		  waitCost = std::min(m_weights.m_horizontalCost, m_weights.m_verticalCost);
+	unsigned long endId	   = ULONG_MAX;
+
+	while(endId == ULONG_MAX && !context.IsOpenListEmpty())
+	{
+		unsigned long currentId	  = context.CloseBest();
+		unsigned int  step		  = currentId / numberOfNodes;
+		const Node*	  pCurrentNode = m_pEnvironment->GetNodeById(currentId % numberOfNodes);
+
+		if(step == window)
+		{
+			// The rest of the path lies beyond the reservations
+			endId = currentId;
+			continue;
+		}
+
+		if(pCurrentNode == pTargetNode)
+		{
+			// The entity has to be able to stay at the target
+			bool isFree = true;
+
+			for(unsigned int i = step + 1; isFree && i < window; ++i)
+			{
+				unsigned long reservation = reservationTable.GetReservation(pTargetNode->GetId(), i);
+				isFree = (reservation == 0 || reservation == entityId);
+			}
+
+			if(isFree)
+			{
+				endId = currentId;
+				continue;
+			}
+		}
+
+		float currentCost = context.GetNodeData(currentId).m_movementCost;
+
+		unsigned int  currentX = static_cast<unsigned int>(pCurrentNode->GetGridPosition().x);
+		unsigned int  currentY = static_cast<unsigned int>(pCurrentNode->GetGridPosition().y);
+		unsigned char moveMask = pCurrentNode->GetMoveMask();
+
+		// Index 0 stands for waiting on the current node, the following ones for the moves to the adjacent nodes
+		for(unsigned int i = 0; i <= g_kNumberOfMoves; ++i)
+		{
+			if(i > 0 && !(moveMask & (1 << (i - 1))))
+			{
+				continue;
+			}
+
+			const Node* pNextNode = (i == 0) ? pCurrentNode : m_pEnvironment->GetNode(currentX + g_kMoveOffsetX[i - 1], currentY + g_kMoveOffsetY[i - 1]);
+
+			unsigned long occupant = reservationTable.GetReservation(pNextNode->GetId(), step + 1);
+
+			if(occupant != 0 && occupant != entityId)
+			{
+				continue;
+			}
+
+			// Entities must not pass through each other by swapping their fields
+			unsigned long oncoming = reservationTable.GetReservation(pNextNode->GetId(), step);
+
+			if(pNextNode != pCurrentNode && oncoming != 0 && oncoming != entityId && reservationTable.GetReservation(pCurrentNode->GetId(), step + 1) == oncoming)
+			{
+				continue;
+			}
+
+			unsigned long nextId = (step + 1) * numberOfNodes + pNextNode->GetId();
+
+			if(context.IsClosed(nextId))
+			{
+				continue;
+			}
+
+			float newCost = currentCost + ((pNextNode == pCurrentNode) ? waitCost : GetTraversalCost(pCurrentNode, pNextNode));
+
+			if(!context.IsVisited(nextId))
+			{
+				context.Open(nextId, currentId, newCost, CalculateOctileDistance(pNextNode, pTargetNode));
+			}else if(newCost < context.GetNodeData(nextId).m_movementCost)
+			{
+				context.UpdateParent(nextId, currentId, newCost);
+			}
+		}
+	}
+
+	if(endId == ULONG_MAX)
+	{
+		// The reservations of the other entities block all ways
+		EndQuery(false, nullptr, context);
+		return false;
+	}
+
+	// Collect the nodes of the path within the window
+	std::vector<XMFLOAT2> tempPath;
+	unsigned long		  currentId = endId;
+
+	tempPath.push_back(m_pEnvironment->GetNodeById(currentId % numberOfNodes)->GetWorldPosition());
+
+	// The start node is its own parent
+	while(context.GetNodeData(currentId).m_parentId != currentId)
+	{
+		currentId = context.GetNodeData(currentId).m_parentId;
+		tempPath.push_back(m_pEnvironment->GetNodeById(currentId % numberOfNodes)->GetWorldPosition());
+	}
+
+	path.assign(tempPath.rbegin(), tempPath.rend());
+
+	const Node* pEndNode = m_pEnvironment->GetNodeById(endId % numberOfNodes);
+
+	if(pEndNode != pTargetNode)
+	{
+		// Complete the path beyond the window, the search starts from the last node within it
+		std::vector<XMFLOAT2> remainingPath;
+
+		if(!CalculatePathAStar(OctileDistance, 1.0f, pEndNode->GetGridPosition(), pTargetNode->GetGridPosition(), remainingPath, context))
+		{
+			EndQuery(false, nullptr, context);
+			return false;
+		}
+
+		path.insert(path.end(), remainingPath.begin() + 1, remainingPath.end());
+	}
+
+	EndQuery(true, &path, context);
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Runs A* from the start node towards several targets at once until a given number of target
+// nodes was closed or all reachable nodes were expanded. The search is guided by the octile 
+// distance to the closest target that was not closed yet. Whenever a target is closed, the 
+// estimates of the open nodes are recalculated for the remaining targets. The estimates stay
+// consistent, thus every target is closed with the cost of the shortest path to it and the
+// targets are closed in the order of their path costs.
+// Param1: The node to start from.
+// Param2: The ids of the target nodes, entries set to ULONG_MAX are ignored. A node listed
+//         several times counts as several targets.
+// Param3: The number of targets to close before the search stops.
+// Param4: The search context holding the scratch data of the search.
+// Returns the number of targets that were closed.
+//--------------------------------------------------------------------------------------
+unsigned int Pathfinder::SearchTargets(const Node* pStartNode, const std::vector<unsigned long>& targetIds, unsigned int numberOfTargetsToClose, SearchContext& context) const
+{
+	// Closed targets are removed from this copy
+	std::vector<unsigned long> remainingTargetIds(targetIds);
+
+	context.BeginSearch(m_pEnvironment->GetNumberOfGridPartitions() * m_pEnvironment->GetNumberOfGridPartitions());
+	context.Open(pStartNode->GetId(), pStartNode->GetId(), 0.0f, CalculateNearestTargetDistance(pStartNode, remainingTargetIds));
+
+	unsigned int numberOfClosedTargets = 0;
+
+	while(!context.IsOpenListEmpty())
+	{
+		const Node* pCurrentNode = m_pEnvironment->GetNodeById(context.CloseBest());
+
+		// Only few targets are passed in, a linear search is cheaper than a lookup table
+		std::vector<unsigned long>::iterator foundIt = std::find(remainingTargetIds.begin(), remainingTargetIds.end(), pCurrentNode->GetId());
+
+		if(foundIt != remainingTargetIds.end())
+		{
+			for(; foundIt != remainingTargetIds.end(); foundIt = std::find(foundIt + 1, remainingTargetIds.end(), pCurrentNode->GetId()))
+			{
+				*foundIt = ULONG_MAX;
+				++numberOfClosedTargets;
+			}
+
+			if(numberOfClosedTargets >= numberOfTargetsToClose)
+			{
+				break;
+			}
+
+			// Let the open nodes estimate the costs to the remaining targets
+			for(unsigned int i = 0; i < context.GetOpenListSize(); ++i)
+			{
+				unsigned long openId = context.GetOpenNode(i);
+				context.SetHeuristicValue(openId, CalculateNearestTargetDistance(m_pEnvironment->GetNodeById(openId), remainingTargetIds));
+			}
+
+			context.ReorderOpenList();
+		}
+
+		float currentCost = context.GetNodeData(pCurrentNode->GetId()).m_movementCost;
+
+		unsigned int  currentX = static_cast<unsigned int>(pCurrentNode->GetGridPosition().x);
+		unsigned int  currentY = static_cast<unsigned int>(pCurrentNode->GetGridPosition().y);
+		unsigned char moveMask = pCurrentNode->GetMoveMask();
+
+		for(unsigned int move = 0; move < g_kNumberOfMoves; ++move)
+		{
+			// Only legal moves are set in the mask, these neither lead onto obstacles nor cut corners
+			if(!(moveMask & (1 << move)))
+			{
+				continue;
+			}
+
+			const Node* pAdjacentNode = m_pEnvironment->GetNode(currentX + g_kMoveOffsetX[move], currentY + g_kMoveOffsetY[move]);
+
+			unsigned long adjacentId = pAdjacentNode->GetId();
+			float		  newCost	 = currentCost + GetTraversalCost(pCurrentNode, pAdjacentNode);
+
+			if(!context.IsVisited(adjacentId))
+			{
+				context.Open(adjacentId, pCurrentNode->GetId(), newCost, CalculateNearestTargetDistance(pAdjacentNode, remainingTargetIds));
+			}else if(context.IsOpen(adjacentId) && newCost < context.GetNodeData(adjacentId).m_movementCost)
+			{
+				context.UpdateParent(adjacentId, pCurrentNode->GetId(), newCost);
+			}
+		}
+	}
+
+	return numberOfClosedTargets;
+}
+
+//--------------------------------------------------------------------------------------
+// Estimates the cost of the path from a node to the closest of several target nodes.
+// Param1: The node, for which to calculate the estimate.
+// Param2: The ids of the target nodes, entries set to ULONG_MAX are ignored.
+// Returns the smallest octile distance from the node to any of the targets.
+//--------------------------------------------------------------------------------------
+float Pathfinder::CalculateNearestTargetDistance(const Node* pNode, const std::vector<unsigned long>& targetIds) const
+{
+	float distance = FLT_MAX;
+
+	for(std::vector<unsigned long>::const_iterator it = targetIds.begin(); it != targetIds.end(); ++it)
+	{
+		if(*it != ULONG_MAX)
+		{
+			distance = std::min(distance, CalculateOctileDistance(pNode, m_pEnvironment->GetNodeById(*it)));
+		}
+	}
+
+	return distance;
+}
+
+//--------------------------------------------------------------------------------------
+// Looks up the nodes of several target positions and sorts out the ones that cannot be reached
+// from a start node, such that a search for them does not have to exhaust the grid.
+// Param1: The node a search for the targets starts from.
+// Param2: The target positions in world space.
+// Param3: A vector that will hold the id of the node of each target, ULONG_MAX for targets outside
+//         of the test environment, on obstacles or in a different part of the grid than the start.
+// Returns the number of targets that might be reachable.
+//--------------------------------------------------------------------------------------
+unsigned int Pathfinder::GetReachableTargets(const Node* pStartNode, const std::vector<XMFLOAT2>& targetPositions, std::vector<unsigned long>& targetIds) const
+{
+	unsigned int numberOfReachableTargets = 0;
+
+	targetIds.clear();
+	targetIds.reserve(targetPositions.size());
+
+	for(std::vector<XMFLOAT2>::const_iterator it = targetPositions.begin(); it != targetPositions.end(); ++it)
+	{
+		const Node* pTargetNode = GetNodeAt(*it);
+
+		if(!pTargetNode || (pTargetNode != pStartNode && pTargetNode->IsObstacle()) || IsKnownUnreachable(pStartNode->GetId(), pTargetNode->GetId()))
+		{
+			targetIds.push_back(ULONG_MAX);
+		}else
+		{
+			targetIds.push_back(pTargetNode->GetId());
+			++numberOfReachableTargets;
+		}
+	}
+
+	return numberOfReachableTargets;
+}
+
+//--------------------------------------------------------------------------------------
+// Looks up the node of the grid field containing a position.
+// Param1: The position in world space.
+// Returns the node, nullptr if the position lies outside of the test environment.
+//--------------------------------------------------------------------------------------
+const Node* Pathfinder::GetNodeAt(const XMFLOAT2& position) const
+{
+	XMFLOAT2 gridPosition;
+	m_pEnvironment->WorldToGridPosition(position, gridPosition);
+
+	if((gridPosition.x < 0) || (gridPosition.y < 0) ||
+	   (gridPosition.x >= m_pEnvironment->GetNumberOfGridPartitions()) || (gridPosition.y >= m_pEnvironment->GetNumberOfGridPartitions()))
+	{
+		return nullptr;
+	}
+
+	return m_pEnvironment->GetNode(static_cast<unsigned int>(gridPosition.x), static_cast<unsigned int>(gridPosition.y));
+}
+
+//--------------------------------------------------------------------------------------
+// Performs an A* search restricted to a rectangular area of the grid. Without a target node
+// the search degenerates to Dijkstra's algorithm and expands every reachable node of the area.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The factor, by which the heuristic values are multiplied, 1 for a shortest path.
+// Param3: The node to start from.
+// Param4: The target node, nullptr to expand the whole area.
+// Param5: The smallest x-coordinate of the grid fields within the area.
+// Param6: The smallest y-coordinate of the grid fields within the area.
+// Param7: The greatest x-coordinate of the grid fields within the area.
+// Param8: The greatest y-coordinate of the grid fields within the area.
+// Param9: The search context holding the scratch data of the search.
+// Returns true if the target node was reached, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::SearchArea(Heuristic heuristic, float heuristicWeight, const Node* pStartNode, const Node* pTargetNode, unsigned int minX, unsigned int minY, unsigned int maxX, unsigned int maxY, SearchContext& context) const
+{
+	StartSearch(heuristic, heuristicWeight, pStartNode, pTargetNode, context);
+
+	unsigned int expansionBudget = UINT_MAX;
+	return ExpandSearch(heuristic, heuristicWeight, pTargetNode, minX, minY, maxX, maxY, context, expansionBudget) == SearchSucceeded;
+}
+
+//--------------------------------------------------------------------------------------
+// Starts a new search in a search context by adding the start node to the open list.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The factor, by which the heuristic values are multiplied, 1 for a shortest path.
+// Param3: The node to start from.
+// Param4: The target node, nullptr to expand the whole area.
+// Param5: The search context holding the scratch data of the search.
+//--------------------------------------------------------------------------------------
+void Pathfinder::StartSearch(Heuristic heuristic, float heuristicWeight, const Node* pStartNode, const Node* pTargetNode, SearchContext& context) const
+{
+	// Start a new search, this invalidates the search data of all nodes at once
+	context.BeginSearch(m_pEnvironment->GetNumberOfGridPartitions() * m_pEnvironment->GetNumberOfGridPartitions());
+
+	// Add the start node to the open list, it is its own parent
+	context.Open(pStartNode->GetId(), pStartNode->GetId(), 0.0f, pTargetNode ? heuristicWeight * CalculateHeuristic(heuristic, pStartNode, pTargetNode) : 0.0f);
+}
+
+//--------------------------------------------------------------------------------------
+// Starts a new adaptive search in a search context. The search continues the series of adaptive
+// searches of the context if the obstacles did not change since the last one.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The node to start from.
+// Param3: The target node.
+// Param4: The search context holding the scratch data of the search.
+//--------------------------------------------------------------------------------------
+void Pathfinder::StartAdaptiveSearch(Heuristic heuristic, const Node* pStartNode, const Node* pTargetNode, SearchContext& context) const
+{
+	float targetHeuristicValue = 0.0f;
+
+	if(context.HasLearnedHeuristic(m_pEnvironment->GetObstacleVersion()) && context.GetAdaptiveTargetId() != pTargetNode->GetId())
+	{
+		// The target moved, estimate the distance between the old and the new target with the learned values
+		const Node* pPreviousTargetNode = m_pEnvironment->GetNodeById(context.GetAdaptiveTargetId());
+		targetHeuristicValue = context.GetAdaptiveHeuristic(pTargetNode->GetId(), CalculateHeuristic(heuristic, pTargetNode, pPreviousTargetNode));
+	}
+
+	context.BeginAdaptiveSearch(m_pEnvironment->GetNumberOfGridPartitions() * m_pEnvironment->GetNumberOfGridPartitions(), pTargetNode->GetId(), m_pEnvironment->GetObstacleVersion(), targetHeuristicValue);
+
+	// Add the start node to the open list, it is its own parent
+	context.Open(pStartNode->GetId(), pStartNode->GetId(), 0.0f, context.GetAdaptiveHeuristic(pStartNode->GetId(), CalculateHeuristic(heuristic, pStartNode, pTargetNode)));
+}
+
+//--------------------------------------------------------------------------------------
+// Expands nodes of a search started by StartSearch or StartAdaptiveSearch until the target is reached, the open list
+// is empty or the expansion budget is used up. The search can be resumed by calling the 
+// function again with the same context.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The factor, by which the heuristic values are multiplied, has to be 1 for adaptive searches.
+// Param3: The target node, nullptr to expand the whole area.
+// Param4: The smallest x-coordinate of the grid fields within the area.
+// Param5: The smallest y-coordinate of the grid fields within the area.
+// Param6: The greatest x-coordinate of the grid fields within the area.
+// Param7: The greatest y-coordinate of the grid fields within the area.
+// Param8: The search context holding the scratch data of the search.
+// Param9: The maximal number of nodes to expand, reduced by the number of expanded nodes.
+// Returns SearchSucceeded if the target node was reached, SearchFailed if it cannot be reached
+// and SearchPending if the budget was used up before either was determined.
+//--------------------------------------------------------------------------------------
+PathSearchStatus Pathfinder::ExpandSearch(Heuristic heuristic, float heuristicWeight, const Node* pTargetNode, unsigned int minX, unsigned int minY, unsigned int maxX, unsigned int maxY, SearchContext& context, unsigned int& expansionBudget) const
+{
+	while(!context.IsOpenListEmpty())
+	{
+		if(expansionBudget == 0)
+		{
+			return SearchPending;
+		}
+
+		--expansionBudget;
+
+		// Take the node with the smallest total estimate from the open list and close it
+		const Node* pCurrentNode = m_pEnvironment->GetNodeById(context.CloseBest());
+
+		if(pCurrentNode == pTargetNode)
+		{
+			// The target node was added to the closed list -> path found
+			return SearchSucceeded;
+		}
+
+		float currentCost = context.GetNodeData(pCurrentNode->GetId()).m_movementCost;
+
+		unsigned int  currentX = static_cast<unsigned int>(pCurrentNode->GetGridPosition().x);
+		unsigned int  currentY = static_cast<unsigned int>(pCurrentNode->GetGridPosition().y);
+		unsigned char moveMask = pCurrentNode->GetMoveMask();
+
+		// Process the nodes adjacent to the current node
+		for(unsigned int move = 0; move < g_kNumberOfMoves; ++move)
+		{
+			// Only legal moves are set in the mask, these neither lead onto obstacles nor cut corners
+			if(!(moveMask & (1 << move)))
+			{
+				continue;
+			}
+
+			const Node* pAdjacentNode = m_pEnvironment->GetNode(currentX + g_kMoveOffsetX[move], currentY + g_kMoveOffsetY[move]);
+
+			if(pAdjacentNode->GetGridPosition().x < minX || pAdjacentNode->GetGridPosition().x > maxX ||
+			   pAdjacentNode->GetGridPosition().y < minY || pAdjacentNode->GetGridPosition().y > maxY)
+			{
+				// The node lies outside of the search area
+				continue;
+			}
+
+			unsigned long adjacentId = pAdjacentNode->GetId();
+			float newCost = currentCost + GetTraversalCost(pCurrentNode, pAdjacentNode);
+
+			if(!context.IsVisited(adjacentId))
+			{
+				float heuristicValue = pTargetNode ? heuristicWeight * CalculateHeuristic(heuristic, pAdjacentNode, pTargetNode) : 0.0f;
+
+				if(context.IsAdaptiveSearch())
+				{
+					// Use the heuristic value learned during earlier searches, has to be read before the node is opened
+					heuristicValue = context.GetAdaptiveHeuristic(adjacentId, heuristicValue);
+				}
+
+				// The node was not visited during this search yet, add it to the open list with the current node as parent
+				context.Open(adjacentId, pCurrentNode->GetId(), newCost, heuristicValue);
+			}else if(context.IsOpen(adjacentId) && newCost < context.GetNodeData(adjacentId).m_movementCost)
+			{
+				// The node is already placed in the open list and the new path to it is shorter, update the node
+				context.UpdateParent(adjacentId, pCurrentNode->GetId(), newCost);
+			}
+		}
+	}
+
+	return SearchFailed;
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a path consisting of 2D coordinates using hierarchical A* (HPA*). The search
+// runs on the cluster graph of the test environment, which only contains the entrances
+// between clusters. The resulting abstract path is refined into a path of adjacent nodes by
+// searching the clusters it crosses. Paths are close to, but not always exactly, the shortest
+// ones. Short queries and queries made while the cluster graph is outdated use plain A*.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The start position of the path in grid fields.
+// Param3: The destination position of the patch in grid fields.
+// Param4: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param5: The search context holding the scratch data of the search.
+// Returns true if the path could be calculated successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::CalculatePathHierarchical(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const
+{
+	const ClusterGraph& clusterGraph = m_pEnvironment->GetClusterGraph();
+
+	unsigned int startX  = static_cast<unsigned int>(startGridPosition.x);
+	unsigned int startY  = static_cast<unsigned int>(startGridPosition.y);
+	unsigned int targetX = static_cast<unsigned int>(targetGridPosition.x);
+	unsigned int targetY = static_cast<unsigned int>(targetGridPosition.y);
+
+	if(!clusterGraph.IsUpToDate() ||
+	   (abs(static_cast<int>(startX / clusterGraph.GetClusterSize()) - static_cast<int>(targetX / clusterGraph.GetClusterSize())) <= 1 &&
+	    abs(static_cast<int>(startY / clusterGraph.GetClusterSize()) - static_cast<int>(targetY / clusterGraph.GetClusterSize())) <= 1))
+	{
+		// The cluster graph cannot be used or the target is close, a plain search is cheaper
+		return CalculatePathAStar(heuristic, 1.0f, startGridPosition, targetGridPosition, path, context);
+	}
+
+	const Node* pStartNode  = m_pEnvironment->GetNode(startX, startY);
+	const Node* pTargetNode = m_pEnvironment->GetNode(targetX, targetY);
+
+	if(pTargetNode->IsObstacle())
+	{
+		return false;
+	}
+
+	unsigned int startCluster  = clusterGraph.GetClusterIndex(startX, startY);
+	unsigned int targetCluster = clusterGraph.GetClusterIndex(targetX, targetY);
+
+	const std::vector<unsigned long>& startEntrances  = clusterGraph.GetEntrances(startCluster);
+	const std::vector<unsigned long>& targetEntrances = clusterGraph.GetEntrances(targetCluster);
+
+	// Determine the costs from the start to the entrances of its cluster and from the entrances
+	// of the target cluster to the target (costs are symmetric). The area searches are part of this
+	// query, they are not recorded as queries of their own.
+
+	unsigned int minX, minY, maxX, maxY;
+
+	std::vector<float> startCosts(startEntrances.size(), FLT_MAX);
+	clusterGraph.GetClusterBounds(startCluster, minX, minY, maxX, maxY);
+	SearchArea(EuclideanDistance, 1.0f, pStartNode, nullptr, minX, minY, maxX, maxY, context);
+
+	for(unsigned int i = 0; i < startEntrances.size(); ++i)
+	{
+		if(context.IsClosed(startEntrances[i]))
+		{
+			startCosts[i] = context.GetNodeData(startEntrances[i]).m_movementCost;
+		}
+	}
+
+	std::vector<float> targetCosts(targetEntrances.size(), FLT_MAX);
+	clusterGraph.GetClusterBounds(targetCluster, minX, minY, maxX, maxY);
+	SearchArea(EuclideanDistance, 1.0f, pTargetNode, nullptr, minX, minY, maxX, maxY, context);
+
+	for(unsigned int i = 0; i < targetEntrances.size(); ++i)
+	{
+		if(context.IsClosed(targetEntrances[i]))
+		{
+			targetCosts[i] = context.GetNodeData(targetEntrances[i]).m_movementCost;
+		}
+	}
+
+	// Search the abstract graph made up of the start, the target and the entrances of all clusters
+
+	context.BeginSearch(m_pEnvironment->GetNumberOfGridPartitions() * m_pEnvironment->GetNumberOfGridPartitions());
+	context.Open(pStartNode->GetId(), pStartNode->GetId(), 0.0f, CalculateHeuristic(heuristic, pStartNode, pTargetNode));
+
+	bool found = false;
+
+	while(!context.IsOpenListEmpty())
+	{
+		unsigned long currentId = context.CloseBest();
+
+		if(currentId == pTargetNode->GetId())
+		{
+			found = true;
+			break;
+		}
+
+		const Node*  pCurrentNode	= m_pEnvironment->GetNodeById(currentId);
+		unsigned int currentX		= static_cast<unsigned int>(pCurrentNode->GetGridPosition().x);
+		unsigned int currentY		= static_cast<unsigned int>(pCurrentNode->GetGridPosition().y);
+		unsigned int currentCluster = clusterGraph.GetClusterIndex(currentX, currentY);
+		int			 entranceIndex  = clusterGraph.GetEntranceIndex(currentId);
+		float		 currentCost	= context.GetNodeData(currentId).m_movementCost;
+
+		if(currentId == pStartNode->GetId())
+		{
+			// Move from the start to the entrances of its cluster
+			for(unsigned int i = 0; i < startEntrances.size(); ++i)
+			{
+				if(startCosts[i] < FLT_MAX)
+				{
+					UpdateAbstractNode(heuristic, startEntrances[i], currentId, currentCost + startCosts[i], pTargetNode, context);
+				}
+			}
+		}else if(entranceIndex >= 0)
+		{
+			// Move to the other entrances of the cluster
+			const std::vector<unsigned long>& entrances = clusterGraph.GetEntrances(currentCluster);
+
+			for(unsigned int i = 0; i < entrances.size(); ++i)
+			{
+				float distance = clusterGraph.GetDistance(currentCluster, entranceIndex, i);
+
+				if(distance < FLT_MAX && static_cast<int>(i) != entranceIndex)
+				{
+					UpdateAbstractNode(heuristic, entrances[i], currentId, currentCost + distance, pTargetNode, context);
+				}
+			}
+		}
+
+		if(entranceIndex >= 0)
+		{
+			// Cross the border to entrances of adjacent clusters
+			int directionsX[4] = {-1, 1, 0, 0};
+			int directionsY[4] = { 0, 0,-1, 1};
+
+			for(unsigned int i = 0; i < 4; ++i)
+			{
+				int x = static_cast<int>(currentX) + directionsX[i];
+				int y = static_cast<int>(currentY) + directionsY[i];
+
+				if(IsTraversable(x, y) && clusterGraph.GetClusterIndex(x, y) != currentCluster && clusterGraph.GetEntranceIndex(m_pEnvironment->GetNode(x, y)->GetId()) >= 0)
+				{
+					UpdateAbstractNode(heuristic, m_pEnvironment->GetNode(x, y)->GetId(), currentId, currentCost + GetTraversalCost(pCurrentNode, m_pEnvironment->GetNode(x, y)), pTargetNode, context);
+				}
+			}
+
+			if(currentCluster == targetCluster && targetCosts[entranceIndex] < FLT_MAX)
+			{
+				// Move from the entrance to the target
+				UpdateAbstractNode(heuristic, pTargetNode->GetId(), currentId, currentCost + targetCosts[entranceIndex], pTargetNode, context);
+			}
+		}
+	}
+
+	if(!found)
+	{
+		return false;
+	}
+
+	// Extract the abstract path before the search context is reused for the refinement
+
+	std::vector<unsigned long> abstractPath;
+
+	unsigned long currentId = pTargetNode->GetId();
+	abstractPath.push_back(currentId);
+
+	while(context.GetNodeData(currentId).m_parentId != currentId)
+	{
+		currentId = context.GetNodeData(currentId).m_parentId;
+		abstractPath.push_back(currentId);
+	}
+
+	// Refine the abstract path, consecutive nodes are either connected within a cluster or adjacent
+
+	path.clear();
+	path.push_back(pStartNode->GetWorldPosition());
+
+	std::vector<XMFLOAT2> segment;
+
+	for(std::vector<unsigned long>::reverse_iterator it = abstractPath.rbegin(); (it + 1) != abstractPath.rend(); ++it)
+	{
+		const Node* pFromNode = m_pEnvironment->GetNodeById(*it);
+		const Node* pToNode	  = m_pEnvironment->GetNodeById(*(it + 1));
+
+		unsigned int fromCluster = clusterGraph.GetClusterIndex(static_cast<unsigned int>(pFromNode->GetGridPosition().x), static_cast<unsigned int>(pFromNode->GetGridPosition().y));
+		unsigned int toCluster	 = clusterGraph.GetClusterIndex(static_cast<unsigned int>(pToNode->GetGridPosition().x), static_cast<unsigned int>(pToNode->GetGridPosition().y));
+
+		if(fromCluster == toCluster)
+		{
+			clusterGraph.GetClusterBounds(fromCluster, minX, minY, maxX, maxY);
+
+			if(!SearchArea(heuristic, 1.0f, pFromNode, pToNode, minX, minY, maxX, maxY, context))
+			{
+				// Cannot happen as long as the cluster graph is up to date
+				return false;
+			}
+
+			ConstructPath(pToNode, context, segment);
+
+			// The first node of the segment is already part of the path
+			path.insert(path.end(), segment.begin() + 1, segment.end());
+		}else
+		{
+			path.push_back(pToNode->GetWorldPosition());
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Adds a node of the abstract graph to the open list or updates it if a cheaper path to it
+// was found.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The id of the node.
+// Param3: The id of the node, from which the node is reached.
+// Param4: The cost of the path from the start to the node.
+// Param5: The target node of the search.
+// Param6: The search context holding the scratch data of the search.
+//--------------------------------------------------------------------------------------
+void Pathfinder::UpdateAbstractNode(Heuristic heuristic, unsigned long id, unsigned long parentId, float movementCost, const Node* pTargetNode, SearchContext& context) const
+{
+	if(!context.IsVisited(id))
+	{
+		context.Open(id, parentId, movementCost, CalculateHeuristic(heuristic, m_pEnvironment->GetNodeById(id), pTargetNode));
+	}else if(context.IsOpen(id) && movementCost < context.GetNodeData(id).m_movementCost)
+	{
+		context.UpdateParent(id, parentId, movementCost);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a path consisting of 2D coordinates using bidirectional A*. A forward search
+// from the start and a backward search from the target are run at the same time, always 
+// expanding the side with the smaller open list. Both sides use the average of the estimates
+// towards either end (see CalculateBidirectionalPotential), which lets the searches stop as
+// soon as the smallest estimates on both open lists add up to the cost of the best path found
+// where they met. The path is as short as the one found by A*, while long queries avoid the 
+// wide frontier a single search builds up near the target. Relies on symmetric traversal 
+// costs and a consistent heuristic.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The start position of the path in grid fields.
+// Param3: The destination position of the patch in grid fields.
+// Param4: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param5: The search context holding the scratch data of the search, the backward search
+//         uses its backward context.
+// Returns true if the path could be calculated successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::CalculatePathBidirectional(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const
+{
+	const Node* pStartNode  = m_pEnvironment->GetNode(static_cast<unsigned int>(startGridPosition.x), static_cast<unsigned int>(startGridPosition.y));
+	const Node* pTargetNode = m_pEnvironment->GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y));
+
+	if(pStartNode != pTargetNode && pTargetNode->IsObstacle())
+	{
+		// A* never enters an obstacle, unlike a backward search leaving it
+		return false;
+	}
+
+	SearchContext& backwardContext = context.GetBackwardContext();
+
+	context.BeginSearch(m_pEnvironment->GetNumberOfGridPartitions() * m_pEnvironment->GetNumberOfGridPartitions());
+	backwardContext.BeginSearch(m_pEnvironment->GetNumberOfGridPartitions() * m_pEnvironment->GetNumberOfGridPartitions());
+
+	context.Open(pStartNode->GetId(), pStartNode->GetId(), 0.0f, CalculateBidirectionalPotential(heuristic, pStartNode, pStartNode, pTargetNode));
+	backwardContext.Open(pTargetNode->GetId(), pTargetNode->GetId(), 0.0f, CalculateBidirectionalPotential(heuristic, pTargetNode, pTargetNode, pStartNode));
+
+	// The cost of the shortest path found so far and the node, at which its halves meet
+	float		  bestCost  = (pStartNode == pTargetNode) ? 0.0f : FLT_MAX;
+	unsigned long meetingId = pStartNode->GetId();
+
+	while(!context.IsOpenListEmpty() && !backwardContext.IsOpenListEmpty())
+	{
+		// The potentials of both sides cancel out, a path passing from the frontier of one side to the
+		// frontier of the other one costs at least the sum of the smallest total estimates on both lists
+		if(context.GetNodeData(context.GetBest()).GetTotalEstimate() + backwardContext.GetNodeData(backwardContext.GetBest()).GetTotalEstimate() >= bestCost)
+		{
+			break;
+		}
+
+		if(context.GetOpenListSize() <= backwardContext.GetOpenListSize())
+		{
+			ExpandBidirectional(heuristic, pStartNode, pTargetNode, context, backwardContext, bestCost, meetingId);
+		}else
+		{
+			ExpandBidirectional(heuristic, pTargetNode, pStartNode, backwardContext, context, bestCost, meetingId);
+		}
+	}
+
+	if(bestCost == FLT_MAX)
+	{
+		return false;
+	}
+
+	// Walk from the meeting node back to the start, then reverse that part in place and
+	// append the walk from the meeting node to the target
+	path.clear();
+
+	unsigned long currentId = meetingId;
+	path.push_back(m_pEnvironment->GetNodeById(currentId)->GetGridPosition());
+
+	while(context.GetNodeData(currentId).m_parentId != currentId)
+	{
+		currentId = context.GetNodeData(currentId).m_parentId;
+		path.push_back(m_pEnvironment->GetNodeById(currentId)->GetGridPosition());
+	}
+
+	std::reverse(path.begin(), path.end());
+
+	currentId = meetingId;
+
+	while(backwardContext.GetNodeData(currentId).m_parentId != currentId)
+	{
+		currentId = backwardContext.GetNodeData(currentId).m_parentId;
+		path.push_back(m_pEnvironment->GetNodeById(currentId)->GetGridPosition());
+	}
+
+	FinalisePath(path);
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Expands the best node of one side of a bidirectional search and checks whether the nodes
+// it reaches were visited by the other side, which yields a complete path.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The node this side started from, the target node of the path for the backward search.
+// Param3: The node this side searches for, the start node of the path for the backward search.
+// Param4: The search context of this side.
+// Param5: The search context of the other side.
+// Param6: The cost of the shortest path found so far, updated if a shorter one is found.
+// Param7: The node, at which the shortest path found so far passes from one side to the other.
+//--------------------------------------------------------------------------------------
+void Pathfinder::ExpandBidirectional(Heuristic heuristic, const Node* pSourceNode, const Node* pTargetNode, SearchContext& context, const SearchContext& otherContext, float& bestCost, unsigned long& meetingId) const
+{
+	const Node* pCurrentNode = m_pEnvironment->GetNodeById(context.CloseBest());
+	float		currentCost	 = context.GetNodeData(pCurrentNode->GetId()).m_movementCost;
+
+	unsigned int  currentX = static_cast<unsigned int>(pCurrentNode->GetGridPosition().x);
+	unsigned int  currentY = static_cast<unsigned int>(pCurrentNode->GetGridPosition().y);
+	unsigned char moveMask = pCurrentNode->GetMoveMask();
+
+	for(unsigned int move = 0; move < g_kNumberOfMoves; ++move)
+	{
+		// Only legal moves are set in the mask, these neither lead onto obstacles nor cut corners
+		if(!(moveMask & (1 << move)))
+		{
+			continue;
+		}
+
+		const Node* pAdjacentNode = m_pEnvironment->GetNode(currentX + g_kMoveOffsetX[move], currentY + g_kMoveOffsetY[move]);
+
+		unsigned long adjacentId = pAdjacentNode->GetId();
+		float		  newCost	 = currentCost + GetTraversalCost(pCurrentNode, pAdjacentNode);
+
+		if(!context.IsVisited(adjacentId))
+		{
+			context.Open(adjacentId, pCurrentNode->GetId(), newCost, CalculateBidirectionalPotential(heuristic, pAdjacentNode, pSourceNode, pTargetNode));
+		}else if(context.IsOpen(adjacentId) && newCost < context.GetNodeData(adjacentId).m_movementCost)
+		{
+			context.UpdateParent(adjacentId, pCurrentNode->GetId(), newCost);
+		}else
+		{
+			continue;
+		}
+
+		if(otherContext.IsVisited(adjacentId) && newCost + otherContext.GetNodeData(adjacentId).m_movementCost < bestCost)
+		{
+			// The searches met, remember the shorter path
+			bestCost  = newCost + otherContext.GetNodeData(adjacentId).m_movementCost;
+			meetingId = adjacentId;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates the estimate used by one side of a bidirectional search. It is the average of 
+// the estimate towards the end this side searches for and the negated estimate towards the
+// end it started from. The estimates of both sides for a node add up to zero, which keeps
+// them consistent with each other.
+// Param1: The heuristic to use to estimate costs between nodes.
+// Param2: The node, for which to calculate the estimate.
+// Param3: The node the side started from.
+// Param4: The node the side searches for.
+// Returns the estimate for the node, can be negative.
+//--------------------------------------------------------------------------------------
+float Pathfinder::CalculateBidirectionalPotential(Heuristic heuristic, const Node* pNode, const Node* pSourceNode, const Node* pTargetNode) const
+{
+	return 0.5f * (CalculateHeuristic(heuristic, pNode, pTargetNode) - CalculateHeuristic(heuristic, pNode, pSourceNode));
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates an any-angle path consisting of 2D coordinates using Theta*. The search works
+// like A*, but a node reached from a node with a line of sight to its own parent is connected
+// to that parent directly. The line of sight is tested with the same corner-aware walk as the
+// straightened paths (see CheckStraightPathGrid), so the segments never cut obstacle corners.
+// The resulting paths consist of few long segments instead of one waypoint per grid field. Should be used with the Euclidean distance heuristic, the octile
+// distance overestimates the cost of any-angle paths.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The start position of the path in grid fields.
+// Param3: The destination position of the patch in grid fields.
+// Param4: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param5: The search context holding the scratch data of the search.
+// Returns true if the path could be calculated successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::CalculatePathThetaStar(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const
+{
+	const Node* pStartNode  = m_pEnvironment->GetNode(static_cast<unsigned int>(startGridPosition.x), static_cast<unsigned int>(startGridPosition.y));
+	const Node* pTargetNode = m_pEnvironment->GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y));
+
+	StartSearch(heuristic, 1.0f, pStartNode, pTargetNode, context);
+
+	while(!context.IsOpenListEmpty())
+	{
+		// Take the node with the smallest total estimate from the open list and close it
+		const Node* pCurrentNode = m_pEnvironment->GetNodeById(context.CloseBest());
+
+		if(pCurrentNode == pTargetNode)
+		{
+			// The target node was added to the closed list -> path found
+			ConstructPath(pTargetNode, context, path);
+			return true;
+		}
+
+		const SearchNodeData& currentData = context.GetNodeData(pCurrentNode->GetId());
+		const Node*			  pParentNode = m_pEnvironment->GetNodeById(currentData.m_parentId);
+		float				  currentCost = currentData.m_movementCost;
+		float				  parentCost  = context.GetNodeData(currentData.m_parentId).m_movementCost;
+
+		unsigned int  currentX = static_cast<unsigned int>(pCurrentNode->GetGridPosition().x);
+		unsigned int  currentY = static_cast<unsigned int>(pCurrentNode->GetGridPosition().y);
+		unsigned char moveMask = pCurrentNode->GetMoveMask();
+
+		// Process the nodes adjacent to the current node
+		for(unsigned int move = 0; move < g_kNumberOfMoves; ++move)
+		{
+			// Only legal moves are set in the mask, these neither lead onto obstacles nor cut corners
+			if(!(moveMask & (1 << move)))
+			{
+				continue;
+			}
+
+			const Node* pAdjacentNode = m_pEnvironment->GetNode(currentX + g_kMoveOffsetX[move], currentY + g_kMoveOffsetY[move]);
+
+			unsigned long adjacentId = pAdjacentNode->GetId();
+
+			if(context.IsClosed(adjacentId))
+			{
+				continue;
+			}
+
+			unsigned long parentId = pCurrentNode->GetId();
+			float		  newCost  = currentCost + GetTraversalCost(pCurrentNode, pAdjacentNode);
+
+			if(m_pEnvironment->CheckStraightPathGrid(static_cast<int>(pParentNode->GetGridPosition().x), static_cast<int>(pParentNode->GetGridPosition().y),
+													 static_cast<int>(pAdjacentNode->GetGridPosition().x), static_cast<int>(pAdjacentNode->GetGridPosition().y)))
+			{
+				// Skip the current node and connect the adjacent node to its parent directly
+				parentId = pParentNode->GetId();
+				newCost  = parentCost + GetStraightLineCost(pParentNode, pAdjacentNode);
+			}
+
+			if(!context.IsVisited(adjacentId))
+			{
+				context.Open(adjacentId, parentId, newCost, CalculateHeuristic(heuristic, pAdjacentNode, pTargetNode));
+			}else if(newCost < context.GetNodeData(adjacentId).m_movementCost)
+			{
+				context.UpdateParent(adjacentId, parentId, newCost);
+			}
+		}
+	}
+
+	return false;
+}
+
+//--------------------------------------------------------------------------------------
+// Calculates a path consisting of 2D coordinates on the navigation mesh. A* searches the
+// rectangles for a corridor leading to the target. Each rectangle is entered at the point of
+// the portal closest to the point the previous rectangle was entered at, the Euclidean distances
+// between these points are the movement costs. The distance from the target to the closest
+// point of a rectangle serves as heuristic. The funnel algorithm then pulls the path taut
+// within the corridor. Falls back to A* on the grid if the navigation mesh is outdated.
+// Param1: The heuristic to use if the search falls back to the grid.
+// Param2: The start position of the path in grid fields.
+// Param3: The destination position of the path in grid fields.
+// Param4: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param5: The search context holding the scratch data of the search.
+// Returns true if the path could be calculated successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::CalculatePathNavigationMesh(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const
+{
+	const NavigationMesh& navigationMesh = m_pEnvironment->GetNavigationMesh();
+
+	const Node* pStartNode  = m_pEnvironment->GetNode(static_cast<unsigned int>(startGridPosition.x), static_cast<unsigned int>(startGridPosition.y));
+	const Node* pTargetNode = m_pEnvironment->GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y));
+
+	if(pTargetNode->IsObstacle())
+	{
+		return false;
+	}
+
+	if(!navigationMesh.IsUpToDate() || pStartNode->IsObstacle())
+	{
+		// The rectangles do not match the obstacles or the start is not covered by any of them
+		return CalculatePathAStar(heuristic, 1.0f, startGridPosition, targetGridPosition, path, context);
+	}
+
+	unsigned int startRectangle  = navigationMesh.GetRectangleIndex(pStartNode->GetId());
+	unsigned int targetRectangle = navigationMesh.GetRectangleIndex(pTargetNode->GetId());
+
+	// The points, at which the rectangles visited by the search are entered
+	std::vector<XMFLOAT2> entryPoints(navigationMesh.GetNumberOfRectangles());
+
+	// Rectangles are indexed like nodes. There are never more rectangles than grid fields, so the
+	// context keeps the size of the grid and grid searches on it neither reallocate nor lose their data.
+	context.BeginSearch(std::max(navigationMesh.GetNumberOfRectangles(), m_pEnvironment->GetNumberOfGridPartitions() * m_pEnvironment->GetNumberOfGridPartitions()));
+
+	entryPoints[startRectangle] = startGridPosition;
+	context.Open(startRectangle, startRectangle, 0.0f, (startRectangle == targetRectangle) ? 0.0f : CalculateEuclideanDistance(startGridPosition, targetGridPosition));
+
+	bool found = false;
+
+	while(!found && !context.IsOpenListEmpty())
+	{
+		unsigned int currentRectangle = context.CloseBest();
+
+		if(currentRectangle == targetRectangle)
+		{
+			// The target rectangle was added to the closed list -> corridor found
+			found = true;
+			continue;
+		}
+
+		const NavigationRectangle& rectangle   = navigationMesh.GetRectangle(currentRectangle);
+		float					   currentCost = context.GetNodeData(currentRectangle).m_movementCost;
+
+		for(std::vector<NavigationPortal>::const_iterator it = rectangle.m_portals.begin(); it != rectangle.m_portals.end(); ++it)
+		{
+			if(context.IsClosed(it->m_rectangle))
+			{
+				continue;
+			}
+
+			// Enter the adjacent rectangle at the point of the portal closest to the current entry point
+			XMFLOAT2 entryPoint(std::min(std::max(entryPoints[currentRectangle].x, it->m_start.x), it->m_end.x),
+								std::min(std::max(entryPoints[currentRectangle].y, it->m_start.y), it->m_end.y));
+
+			float newCost		 = currentCost + CalculateEuclideanDistance(entryPoints[currentRectangle], entryPoint);
+			float heuristicValue = 0.0f;
+
+			if(it->m_rectangle == targetRectangle)
+			{
+				// The target can be reached in a straight line from any point of its rectangle
+				newCost += CalculateEuclideanDistance(entryPoint, targetGridPosition);
+			}else
+			{
+				const NavigationRectangle& adjacentRectangle = navigationMesh.GetRectangle(it->m_rectangle);
+
+				XMFLOAT2 closestPoint(std::min(std::max(targetGridPosition.x, static_cast<float>(adjacentRectangle.m_minX)), static_cast<float>(adjacentRectangle.m_maxX)),
+									  std::min(std::max(targetGridPosition.y, static_cast<float>(adjacentRectangle.m_minY)), static_cast<float>(adjacentRectangle.m_maxY)));
+
+				heuristicValue = CalculateEuclideanDistance(closestPoint, targetGridPosition);
+			}
+
+			if(!context.IsVisited(it->m_rectangle))
+			{
+				entryPoints[it->m_rectangle] = entryPoint;
+				context.Open(it->m_rectangle, currentRectangle, newCost, heuristicValue);
+			}else if(newCost < context.GetNodeData(it->m_rectangle).m_movementCost)
+			{
+				entryPoints[it->m_rectangle] = entryPoint;
+				context.UpdateParent(it->m_rectangle, currentRectangle, newCost);
+			}
+		}
+	}
+
+	if(!found)
+	{
+		return false;
+	}
+
+	// Collect the portals along the corridor from the target back to the start, the start and the
+	// target are added as portals of zero width. Each portal is stored as its left and its right end
+	// point as seen when moving towards the target. A portal is passed as the row or column of grid
+	// field centres on either side of the shared edge. Thus, the path between two consecutive portals
+	// stays within a rectangle or within the fields on both sides of an edge and never grazes the
+	// obstacles next to the edge.
+	std::vector<XMFLOAT2> portals;
+	portals.push_back(targetGridPosition);
+	portals.push_back(targetGridPosition);
+
+	unsigned int currentRectangle = targetRectangle;
+
+	while(context.GetNodeData(currentRectangle).m_parentId != currentRectangle)
+	{
+		unsigned int			   parentRectangle = context.GetNodeData(currentRectangle).m_parentId;
+		const NavigationRectangle& parent		   = navigationMesh.GetRectangle(parentRectangle);
+		const NavigationRectangle& current		   = navigationMesh.GetRectangle(currentRectangle);
+
+		std::vector<NavigationPortal>::const_iterator it = parent.m_portals.begin();
+
+		while(it->m_rectangle != currentRectangle)
+		{
+			++it;
+		}
+
+		// With the x axis pointing right and the y axis pointing up, the end point lies to the left when
+		// moving in positive direction along the x axis or in negative direction along the y axis
+		bool isAlongX	 = (current.m_minX > parent.m_maxX) || (parent.m_minX > current.m_maxX);
+		bool isForward	 = isAlongX ? (current.m_minX > parent.m_maxX) : (current.m_minY > parent.m_maxY);
+		bool isEndOnLeft = (isAlongX == isForward);
+
+		const XMFLOAT2& left  = isEndOnLeft ? it->m_end : it->m_start;
+		const XMFLOAT2& right = isEndOnLeft ? it->m_start : it->m_end;
+
+		// The offset from the edge to the centres of the fields of the current rectangle
+		float offsetX = isAlongX ? (isForward ? 0.5f : -0.5f) : 0.0f;
+		float offsetY = isAlongX ? 0.0f : (isForward ? 0.5f : -0.5f);
+
+		// Added in reverse order, the side of the current rectangle before the side of its parent and
+		// right before left
+		portals.push_back(XMFLOAT2(right.x + offsetX, right.y + offsetY));
+		portals.push_back(XMFLOAT2(left.x + offsetX, left.y + offsetY));
+		portals.push_back(XMFLOAT2(right.x - offsetX, right.y - offsetY));
+		portals.push_back(XMFLOAT2(left.x - offsetX, left.y - offsetY));
+
+		currentRectangle = parentRectangle;
+	}
+
+	portals.push_back(startGridPosition);
+	portals.push_back(startGridPosition);
+
+	std::reverse(portals.begin(), portals.end());
+
+	std::vector<XMFLOAT2> gridPath;
+	PullStringThroughPortals(portals, gridPath);
+
+	path.clear();
+
+	for(std::vector<XMFLOAT2>::const_iterator it = gridPath.begin(); it != gridPath.end(); ++it)
+	{
+		XMFLOAT2 worldPosition;
+		m_pEnvironment->GridToWorldPosition(*it, worldPosition);
+		path.push_back(worldPosition);
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Finds the shortest path through a sequence of portals using the funnel algorithm. The funnel
+// spanned by the current apex and the end points of the portals narrows with every portal. Once
+// a portal end point crosses over the other side of the funnel, that side's end point is a corner
+// of the path and becomes the new apex.
+// Param1: The left and right end points of the portals in the order they are passed, the first
+//         portal is the start and the last one the target of the path.
+// Param2: A vector that will hold the corners of the path including the start and the target.
+//--------------------------------------------------------------------------------------
+void Pathfinder::PullStringThroughPortals(const std::vector<XMFLOAT2>& portals, std::vector<XMFLOAT2>& path) const
+{
+	unsigned int numberOfPortals = portals.size() / 2;
+
+	XMFLOAT2	 apex		 = portals[0];
+	XMFLOAT2	 left		 = portals[0];
+	XMFLOAT2	 right		 = portals[1];
+	unsigned int apexIndex	 = 0;
+	unsigned int leftIndex	 = 0;
+	unsigned int rightIndex	 = 0;
+
+	path.clear();
+	path.push_back(apex);
+
+	for(unsigned int i = 1; i < numberOfPortals; ++i)
+	{
+		const XMFLOAT2& newLeft  = portals[2 * i];
+		const XMFLOAT2& newRight = portals[2 * i + 1];
+
+		// Try to narrow the funnel from the right
+		if(CalculateSignedArea(apex, right, newRight) >= 0.0f)
+		{
+			if((apex.x == right.x && apex.y == right.y) || CalculateSignedArea(apex, left, newRight) < 0.0f)
+			{
+				right	   = newRight;
+				rightIndex = i;
+			}else
+			{
+				// The right side crosses over the left one, the left end point is a corner of the path
+				apex	  = left;
+				apexIndex = leftIndex;
+				path.push_back(apex);
+
+				// Restart from the portal following the new apex
+				left	   = apex;
+				right	   = apex;
+				leftIndex  = apexIndex;
+				rightIndex = apexIndex;
+				i		   = apexIndex;
+				continue;
+			}
+		}
+
+		// Try to narrow the funnel from the left
+		if(CalculateSignedArea(apex, left, newLeft) <= 0.0f)
+		{
+			if((apex.x == left.x && apex.y == left.y) || CalculateSignedArea(apex, right, newLeft) > 0.0f)
+			{
+				left	  = newLeft;
+				leftIndex = i;
+			}else
+			{
+				// The left side crosses over the right one, the right end point is a corner of the path
+				apex	  = right;
+				apexIndex = rightIndex;
+				path.push_back(apex);
 
-	if((startGridPosition.x < 0) || (targetGridPosition.x < 0) && 
-	   (startGridPosition.x >= m_pEnvironment->GetNumberOfGridPartitions()) || (targetGridPosition.x >= m_pEnvironment->GetNumberOfGridPartitions()) &&
-	   (startGridPosition.y < 0) || (targetGridPosition.y < 0) && 
-	   (startGridPosition.y >= m_pEnvironment->GetNumberOfGridPartitions()) || (targetGridPosition.y >= m_pEnvironment->GetNumberOfGridPartitions()))
-	{
-		// Start or target position lies outside of the test environment.
-		return false;
+				// Restart from the portal following the new apex
+				left	   = apex;
+				right	   = apex;
+				leftIndex  = apexIndex;
+				rightIndex = apexIndex;
+				i		   = apexIndex;
+				continue;
+			}
+		}
 	}
 
-	switch(algorithm)
+	// Add the target unless it already is the last corner
+	const XMFLOAT2& target = portals.back();
+
+	if(path.back().x != target.x || path.back().y != target.y)
 	{
-	case AStar:
-		return CalculatePathAStar(heuristic, startGridPosition, targetGridPosition, path);
-		break;
-	default:
-		return false;
+		path.push_back(target);
 	}
+}
 
-	return true;
+//--------------------------------------------------------------------------------------
+// Calculates twice the signed area of the triangle spanned by an apex and two points.
+// Param1: The apex of the triangle.
+// Param2: The first point.
+// Param3: The second point.
+// Returns a positive value if the second point lies to the left of the line from the apex through
+// the first point, a negative value if it lies to the right and zero if all points are collinear.
+//--------------------------------------------------------------------------------------
+float Pathfinder::CalculateSignedArea(const XMFLOAT2& apex, const XMFLOAT2& first, const XMFLOAT2& second) const
+{
+	return (first.x - apex.x) * (second.y - apex.y) - (first.y - apex.y) * (second.x - apex.x);
 }
 
 //--------------------------------------------------------------------------------------
-// Calculates a path consisting of 2D coordinates using the A* algorithm.
+// Calculates a path consisting of 2D coordinates using jump point search. Instead of adding
+// all adjacent nodes to the open list, the search moves along straight and diagonal lines
+// until it encounters a node with a neighbour that cannot be reached optimally without
+// passing through it (a jump point). Only jump points are added to the open list. Follows
+// the same rules for cutting corners as the A* search.
 // Param1: The heuristic to use to estimate costs from nodes to the target.
-// Param2: The start position of the path in grid fields.
-// Param3: The destination position of the patch in grid fields.
-// Param4: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param2: The factor, by which the heuristic values are multiplied (1 + epsilon).
+// Param3: The start position of the path in grid fields.
+// Param4: The destination position of the patch in grid fields.
+// Param5: A vector that will hold the path consisting of a series of 2D coordinates.
+// Param6: The search context holding the scratch data of the search.
 // Returns true if the path could be calculated successfully, false otherwise.
 //--------------------------------------------------------------------------------------
-bool Pathfinder::CalculatePathAStar(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path)
+bool Pathfinder::CalculatePathJumpPointSearch(Heuristic heuristic, float heuristicWeight, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const
 {
-	// Reset all data structures used for this algorithm
-	m_openList.clear();
-	m_closedList.clear();
+	// Start a new search, this invalidates the search data of all nodes at once
+	context.BeginSearch(m_pEnvironment->GetNumberOfGridPartitions() * m_pEnvironment->GetNumberOfGridPartitions());
 
-	// Get the id of the target node
-	unsigned long targetId = m_pEnvironment->GetNodes()[static_cast<int>(targetGridPosition.x)][static_cast<int>(targetGridPosition.y)].GetId();
+	const Node* pStartNode  = m_pEnvironment->GetNode(static_cast<unsigned int>(startGridPosition.x), static_cast<unsigned int>(startGridPosition.y));
+	const Node* pTargetNode = m_pEnvironment->GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y));
 
-	// Prepare the start node
-	m_pEnvironment->GetNodes()[static_cast<int>(startGridPosition.x)][static_cast<int>(startGridPosition.y)].SetParent(nullptr);
-	UpdateCosts(heuristic, &m_pEnvironment->GetNodes()[static_cast<int>(startGridPosition.x)][static_cast<int>(startGridPosition.y)], &m_pEnvironment->GetNodes()[static_cast<int>(targetGridPosition.x)][static_cast<int>(targetGridPosition.y)]);
+	if(pTargetNode->IsObstacle())
+	{
+		// Jumps never end on an obstacle, A* would not find a path either
+		return false;
+	}
 
-	// Add the start node to the open list
-	m_openList.push_back(&m_pEnvironment->GetNodes()[static_cast<int>(startGridPosition.x)][static_cast<int>(startGridPosition.y)]);
+	// Add the start node to the open list, it is its own parent
+	context.Open(pStartNode->GetId(), pStartNode->GetId(), 0.0f, heuristicWeight * CalculateHeuristic(heuristic, pStartNode, pTargetNode));
 
 	// Tells whether the path was found or not
 	bool found = false;
 
-	while(!found && !m_openList.empty())
-	{
-		// Sort the open list according to the total estimates of the cost to move through each node
-		std::sort(m_openList.begin(), m_openList.end(), CompareNodeCosts());
+	// The directions, in which to look for jump points from the current node
+	int directionsX[8];
+	int directionsY[8];
 
-		// Take the first element from the open list (the one with the smallest total estimate)
-		Node* pCurrentNode = m_openList[0];
-		
-		// Move the current node to the closed list
-		m_closedList.push_back(pCurrentNode);
-		m_openList.erase(m_openList.begin());
+	while(!found && !context.IsOpenListEmpty())
+	{
+		// Take the node with the smallest total estimate from the open list and close it
+		const Node* pCurrentNode = m_pEnvironment->GetNodeById(context.CloseBest());
 
-		if(pCurrentNode->GetId() == targetId)
+		if(pCurrentNode == pTargetNode)
 		{
 			// The target node was added to the closed list -> path found
 			found = true;
 			break;
 		}
 
-		// Process the nodes adjacent to the current node
-		for(std::vector<Node*>::const_iterator it = pCurrentNode->GetAdjacentNodes().begin(); it != pCurrentNode->GetAdjacentNodes().end(); ++it)
+		float currentCost = context.GetNodeData(pCurrentNode->GetId()).m_movementCost;
+
+		unsigned int numberOfDirections = GetJumpDirections(pCurrentNode, context, directionsX, directionsY);
+
+		for(unsigned int i = 0; i < numberOfDirections; ++i)
 		{
-			// Only consider the node if it is traversable without cutting corners
-			if(!(*it)->IsObstacle() && !IsCuttingCorner(pCurrentNode, *it))
+			const Node* pJumpPoint = Jump(pCurrentNode, directionsX[i], directionsY[i], pTargetNode);
+
+			if(!pJumpPoint)
 			{
-				// Check if the node is already placed in the closed list
-				std::vector<Node*>::iterator closedIt = std::find_if(m_closedList.begin(), m_closedList.end(), FindNodeWithId((*it)->GetId()));
-				if(closedIt == m_closedList.end())
-				{
-					// Only consider node if it is not already on the closed list
-					std::vector<Node*>::iterator openIt = std::find_if(m_openList.begin(), m_openList.end(), FindNodeWithId((*it)->GetId()));
-					if(openIt == m_openList.end())
-					{
-						// If the node is not in the open list, add it to it
-						m_openList.push_back(*it);
-						// Makt the current node the parent
-						(*it)->SetParent(pCurrentNode);
-						// Update the costs of using this node to get to the target
-						UpdateCosts(heuristic, (*it), &(m_pEnvironment->GetNodes()[static_cast<int>(targetGridPosition.x)][static_cast<int>(targetGridPosition.y)]));
-					}else
-					{
-						// The node is already placed in the open list, check if the new path to it is shorter
-						float oldCost = (*it)->GetMovementCost();
-						float newCost = pCurrentNode->GetMovementCost() + GetTraversalCost(pCurrentNode, (*it));
-						
-						if(newCost < oldCost)
-						{
-							// The new path is shorter, update the node
-							(*it)->SetParent(pCurrentNode);
-							UpdateCosts(heuristic, (*it), &(m_pEnvironment->GetNodes()[static_cast<int>(targetGridPosition.x)][static_cast<int>(targetGridPosition.y)]));
-						}
-					}
-				}
+				// Nothing of interest in this direction
+				continue;
+			}
+
+			unsigned long jumpPointId = pJumpPoint->GetId();
+			float newCost = currentCost + CalculateOctileDistance(pCurrentNode, pJumpPoint);
+
+			if(!context.IsVisited(jumpPointId))
+			{
+				context.Open(jumpPointId, pCurrentNode->GetId(), newCost, heuristicWeight * CalculateHeuristic(heuristic, pJumpPoint, pTargetNode));
+			}else if(context.IsOpen(jumpPointId) && newCost < context.GetNodeData(jumpPointId).m_movementCost)
+			{
+				context.UpdateParent(jumpPointId, pCurrentNode->GetId(), newCost);
 			}
 		}
 	}
@@ -174,74 +1867,381 @@ bool Pathfinder::CalculatePathAStar(Heuristic heuristic, const XMFLOAT2& startGr
 	if(found)
 	{
 		// Construct the path
-		ConstructPath(&(m_pEnvironment->GetNodes()[static_cast<int>(targetGridPosition.x)][static_cast<int>(targetGridPosition.y)]), path);
+		ConstructJumpPointPath(pTargetNode, context, path);
 	}
 
 	return found;
 }
 
 //--------------------------------------------------------------------------------------
-// Builds the path from the given target node back to the start node.
-// Param1: The destination node of the path.
-// Param2: The vector that will hold the completed path.
+// Moves from a node in a given direction until a jump point is found or the way is blocked.
+// Param1: The node to start from.
+// Param2: The direction of the movement along the x-axis of the grid (-1, 0 or 1).
+// Param3: The direction of the movement along the y-axis of the grid (-1, 0 or 1).
+// Param4: The target node of the search, which is always considered a jump point.
+// Returns the jump point found in the given direction, nullptr if there is none.
 //--------------------------------------------------------------------------------------
-void Pathfinder::ConstructPath(Node* pTargetNode, std::vector<XMFLOAT2>& path)
+const Node* Pathfinder::Jump(const Node* pNode, int directionX, int directionY, const Node* pTargetNode) const
 {
-	// Note: Consider using another container for the path, maybe list or queue.
+	int x = static_cast<int>(pNode->GetGridPosition().x);
+	int y = static_cast<int>(pNode->GetGridPosition().y);
 
-	std::vector<XMFLOAT2> tempPath;
+	bool isDiagonal = (directionX != 0) && (directionY != 0);
+
+	while(true)
+	{
+		if(isDiagonal && (!IsTraversable(x + directionX, y) || !IsTraversable(x, y + directionY)))
+		{
+			// The diagonal move would cut a corner
+			return nullptr;
+		}
+
+		x += directionX;
+		y += directionY;
+
+		if(!IsTraversable(x, y))
+		{
+			return nullptr;
+		}
+
+		const Node* pCurrentNode = m_pEnvironment->GetNode(x, y);
+
+		if(pCurrentNode == pTargetNode)
+		{
+			return pCurrentNode;
+		}
+
+		if(isDiagonal)
+		{
+			// Stop when one of the straight moves leaving this node leads to a jump point
+			if(Jump(pCurrentNode, directionX, 0, pTargetNode) || Jump(pCurrentNode, 0, directionY, pTargetNode))
+			{
+				return pCurrentNode;
+			}
+		}else if(directionX != 0)
+		{
+			// Stop if a node to the side could not be reached diagonally from the previous node (forced neighbour)
+			if((IsTraversable(x, y - 1) && !IsTraversable(x - directionX, y - 1)) ||
+			   (IsTraversable(x, y + 1) && !IsTraversable(x - directionX, y + 1)))
+			{
+				return pCurrentNode;
+			}
+		}else
+		{
+			if((IsTraversable(x - 1, y) && !IsTraversable(x - 1, y - directionY)) ||
+			   (IsTraversable(x + 1, y) && !IsTraversable(x + 1, y - directionY)))
+			{
+				return pCurrentNode;
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the directions, in which the jump point search should look for jump points 
+// when expanding a node. Directions that can be covered more cheaply from the parent node
+// are pruned.
+// Param1: The node being expanded.
+// Param2: The search context holding the parent of the node.
+// Param3: Array that will hold the x-components of the directions.
+// Param4: Array that will hold the y-components of the directions.
+// Returns the number of directions written to the arrays.
+//--------------------------------------------------------------------------------------
+unsigned int Pathfinder::GetJumpDirections(const Node* pNode, const SearchContext& context, int directionsX[8], int directionsY[8]) const
+{
+	unsigned int numberOfDirections = 0;
+
+	int x = static_cast<int>(pNode->GetGridPosition().x);
+	int y = static_cast<int>(pNode->GetGridPosition().y);
 
-	const Node* pCurrentNode = pTargetNode;
+	unsigned long parentId = context.GetNodeData(pNode->GetId()).m_parentId;
 
-	while(pCurrentNode != nullptr)
+	if(parentId == pNode->GetId())
 	{
-		tempPath.push_back(pCurrentNode->GetWorldPosition());
-		pCurrentNode = pCurrentNode->GetParent();
+		// The start node has no parent, search in all directions
+		for(int i = -1; i <= 1; ++i)
+		{
+			for(int k = -1; k <= 1; ++k)
+			{
+				if((i != 0) || (k != 0))
+				{
+					directionsX[numberOfDirections] = i;
+					directionsY[numberOfDirections] = k;
+					++numberOfDirections;
+				}
+			}
+		}
+
+		return numberOfDirections;
 	}
 
-	// Make sure the path is initially empty
-	path.clear();
+	// Determine the direction of travel from the parent to this node
+	const Node* pParentNode = m_pEnvironment->GetNodeById(parentId);
+	int dx = (x > pParentNode->GetGridPosition().x) ? 1 : ((x < pParentNode->GetGridPosition().x) ? -1 : 0);
+	int dy = (y > pParentNode->GetGridPosition().y) ? 1 : ((y < pParentNode->GetGridPosition().y) ? -1 : 0);
+
+	if((dx != 0) && (dy != 0))
+	{
+		// Diagonal: continue diagonally and along both straight components
+		bool isNextXTraversable = IsTraversable(x + dx, y);
+		bool isNextYTraversable = IsTraversable(x, y + dy);
+
+		if(isNextXTraversable)
+		{
+			directionsX[numberOfDirections] = dx;
+			directionsY[numberOfDirections] = 0;
+			++numberOfDirections;
+		}
+		if(isNextYTraversable)
+		{
+			directionsX[numberOfDirections] = 0;
+			directionsY[numberOfDirections] = dy;
+			++numberOfDirections;
+		}
+		if(isNextXTraversable && isNextYTraversable)
+		{
+			directionsX[numberOfDirections] = dx;
+			directionsY[numberOfDirections] = dy;
+			++numberOfDirections;
+		}
+	}else
+	{
+		// Straight: continue straight, turn to the sides and move diagonally forward where possible
+		int sideX = (dx == 0) ? 1 : 0;
+		int sideY = (dy == 0) ? 1 : 0;
+
+		bool isNextTraversable	  = IsTraversable(x + dx, y + dy);
+		bool isPositiveTraversable = IsTraversable(x + sideX, y + sideY);
+		bool isNegativeTraversable = IsTraversable(x - sideX, y - sideY);
+
+		if(isNextTraversable)
+		{
+			directionsX[numberOfDirections] = dx;
+			directionsY[numberOfDirections] = dy;
+			++numberOfDirections;
+
+			if(isPositiveTraversable)
+			{
+				directionsX[numberOfDirections] = dx + sideX;
+				directionsY[numberOfDirections] = dy + sideY;
+				++numberOfDirections;
+			}
+			if(isNegativeTraversable)
+			{
+				directionsX[numberOfDirections] = dx - sideX;
+				directionsY[numberOfDirections] = dy - sideY;
+				++numberOfDirections;
+			}
+		}
+		if(isPositiveTraversable)
+		{
+			directionsX[numberOfDirections] = sideX;
+			directionsY[numberOfDirections] = sideY;
+			++numberOfDirections;
+		}
+		if(isNegativeTraversable)
+		{
+			directionsX[numberOfDirections] = -sideX;
+			directionsY[numberOfDirections] = -sideY;
+			++numberOfDirections;
+		}
+	}
+
+	return numberOfDirections;
+}
+
+//--------------------------------------------------------------------------------------
+// Builds the path from the given target node back to the start node for a jump point 
+// search. The nodes between consecutive jump points are added to the path as well, such 
+// that the path has the same format as the one produced by A*.
+// Param1: The destination node of the path.
+// Param2: The search context holding the parent information determined by the search.
+// Param3: The vector that will hold the completed path.
+//--------------------------------------------------------------------------------------
+void Pathfinder::ConstructJumpPointPath(const Node* pTargetNode, const SearchContext& context, std::vector<XMFLOAT2>& path) const
+{
+	std::vector<XMFLOAT2> tempPath;
+
+	unsigned long currentId = pTargetNode->GetId();
+
+	tempPath.push_back(pTargetNode->GetGridPosition());
+
+	// The start node is its own parent
+	while(context.GetNodeData(currentId).m_parentId != currentId)
+	{
+		unsigned long parentId = context.GetNodeData(currentId).m_parentId;
+
+		int x = static_cast<int>(m_pEnvironment->GetNodeById(currentId)->GetGridPosition().x);
+		int y = static_cast<int>(m_pEnvironment->GetNodeById(currentId)->GetGridPosition().y);
+		int parentX = static_cast<int>(m_pEnvironment->GetNodeById(parentId)->GetGridPosition().x);
+		int parentY = static_cast<int>(m_pEnvironment->GetNodeById(parentId)->GetGridPosition().y);
+
+		// Jump points are connected by straight or diagonal lines, add every node on the line
+		while((x != parentX) || (y != parentY))
+		{
+			x += (parentX > x) ? 1 : ((parentX < x) ? -1 : 0);
+			y += (parentY > y) ? 1 : ((parentY < y) ? -1 : 0);
+
+			tempPath.push_back(m_pEnvironment->GetNode(x, y)->GetGridPosition());
+		}
+
+		currentId = parentId;
+	}
 
 	// Change the order of the path
+	path.assign(tempPath.rbegin(), tempPath.rend());
 
-	for(std::vector<XMFLOAT2>::reverse_iterator it = tempPath.rbegin(); it != tempPath.rend(); ++it)
+	FinalisePath(path);
+}
+
+//--------------------------------------------------------------------------------------
+// Builds the path from the given target node back to the start node. The nodes are written
+// from the back of the path to its front, which puts them into the right order right away.
+// Param1: The destination node of the path.
+// Param2: The search context holding the parent information determined by the search.
+// Param3: The vector that will hold the completed path.
+//--------------------------------------------------------------------------------------
+void Pathfinder::ConstructPath(const Node* pTargetNode, const SearchContext& context, std::vector<XMFLOAT2>& path) const
+{
+	unsigned long currentId		= pTargetNode->GetId();
+	unsigned int  numberOfNodes = 1;
+
+	// The start node is its own parent
+	while(context.GetNodeData(currentId).m_parentId != currentId)
+	{
+		currentId = context.GetNodeData(currentId).m_parentId;
+		++numberOfNodes;
+	}
+
+	path.resize(numberOfNodes);
+
+	currentId = pTargetNode->GetId();
+
+	for(unsigned int i = numberOfNodes; i > 0; --i)
 	{
-		path.push_back(*it);
+		path[i - 1] = m_pEnvironment->GetNodeById(currentId)->GetGridPosition();
+		currentId	= context.GetNodeData(currentId).m_parentId;
 	}
+
+	FinalisePath(path);
 }
 
 //--------------------------------------------------------------------------------------
-// Updates the cost to move to the provided node as well as the estimated cost from
-// the node to the target.
-// Param1: The heuristic to use to estimate costs from nodes to the target.
-// Param2: The node that should be updated.
-// Param3: The target node.
+// Removes the waypoints that are not needed to follow a path according to the pathfinding
+// settings and turns the remaining ones into world space positions.
+// Param1: The path consisting of grid space positions, will hold the world space positions.
 //--------------------------------------------------------------------------------------
-void Pathfinder::UpdateCosts(Heuristic heuristic, Node* pStartNode, Node* pTargetNode)
+void Pathfinder::FinalisePath(std::vector<XMFLOAT2>& path) const
 {
-	if(pStartNode->GetParent() == nullptr)
+	if(g_kRemoveCollinearWaypoints)
 	{
-		// Start node
-		pStartNode->SetMovementCost(0.0f);
-	}else
+		RemoveCollinearWaypoints(path);
+	}
+
+	if(g_kStraightenPaths)
+	{
+		StraightenPath(path);
+	}
+
+	for(std::vector<XMFLOAT2>::iterator it = path.begin(); it != path.end(); ++it)
+	{
+		XMFLOAT2 gridPosition = *it;
+		m_pEnvironment->GridToWorldPosition(gridPosition, *it);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Removes the waypoints lying on a straight line between the previous and the next one. An
+// entity following the path moves along the same lines as before.
+// Param1: The path consisting of grid space positions.
+//--------------------------------------------------------------------------------------
+void Pathfinder::RemoveCollinearWaypoints(std::vector<XMFLOAT2>& path) const
+{
+	if(path.size() < 3)
+	{
+		return;
+	}
+
+	// The waypoints that are kept are moved to the front of the path
+	unsigned int numberOfWaypoints = 1;
+	XMFLOAT2	 previous		   = path[0];
+
+	for(unsigned int i = 1; i + 1 < path.size(); ++i)
 	{
-		// Take parent node's cost into account and add the cost to move to this node from the parent
-		pStartNode->SetMovementCost(pStartNode->GetParent()->GetMovementCost() + GetTraversalCost(pStartNode->GetParent(), pStartNode));
+		XMFLOAT2 incoming(path[i].x - previous.x, path[i].y - previous.y);
+		XMFLOAT2 outgoing(path[i + 1].x - path[i].x, path[i + 1].y - path[i].y);
+
+		previous = path[i];
+
+		// Grid positions are whole numbers, the test is exact
+		if(incoming.x * outgoing.y - incoming.y * outgoing.x != 0.0f || incoming.x * outgoing.x + incoming.y * outgoing.y <= 0.0f)
+		{
+			path[numberOfWaypoints] = path[i];
+			++numberOfWaypoints;
+		}
+	}
+
+	path[numberOfWaypoints] = path.back();
+	path.resize(numberOfWaypoints + 1);
+}
+
+//--------------------------------------------------------------------------------------
+// Skips the waypoints of a path that can be left out, because the next waypoint can be reached
+// in a straight line from the last one that is kept (string pulling). The straight lines only
+// cross free fields and do not cut corners (see CheckStraightPathGrid).
+// Param1: The path consisting of grid space positions.
+//--------------------------------------------------------------------------------------
+void Pathfinder::StraightenPath(std::vector<XMFLOAT2>& path) const
+{
+	if(path.size() < 3)
+	{
+		return;
 	}
 
-	// Note: It would be sufficient to calculate the heuristic estimate once for each node.
+	// The waypoints that are kept are moved to the front of the path
+	unsigned int numberOfWaypoints = 1;
+
+	for(unsigned int i = 1; i + 1 < path.size(); ++i)
+	{
+		const XMFLOAT2& last = path[numberOfWaypoints - 1];
+
+		if(!m_pEnvironment->CheckStraightPathGrid(static_cast<int>(last.x), static_cast<int>(last.y), static_cast<int>(path[i + 1].x), static_cast<int>(path[i + 1].y)))
+		{
+			// The waypoint is needed to get around an obstacle
+			path[numberOfWaypoints] = path[i];
+			++numberOfWaypoints;
+		}
+	}
 
-	// Calculate the heuristic estimate
+	path[numberOfWaypoints] = path.back();
+	path.resize(numberOfWaypoints + 1);
+}
 
+//--------------------------------------------------------------------------------------
+// Calculates the heuristic estimate of the cost to move from a node to the target.
+// Param1: The heuristic to use to estimate costs from nodes to the target.
+// Param2: The node, for which to calculate the estimate.
+// Param3: The target node.
+// Returns the estimated cost from the node to the target.
+//--------------------------------------------------------------------------------------
+float Pathfinder::CalculateHeuristic(Heuristic heuristic, const Node* pNode, const Node* pTargetNode) const
+{
 	float heuristicValue = 0.0f;
+
 	switch(heuristic)
 	{
 	case EuclideanDistance:
-		heuristicValue = CalculateEuclideanDistance(pStartNode->GetWorldPosition(), pTargetNode->GetWorldPosition());
+		heuristicValue = CalculateEuclideanDistance(pNode->GetWorldPosition(), pTargetNode->GetWorldPosition());
+		break;
+	case OctileDistance:
+		heuristicValue = CalculateOctileDistance(pNode, pTargetNode);
+		break;
+	case LandmarkDistance:
+		heuristicValue = std::max(CalculateOctileDistance(pNode, pTargetNode), m_pEnvironment->GetLandmarkTable().GetLowerBound(pNode->GetId(), pTargetNode->GetId()));
 		break;
 	}
 
-	pStartNode->SetHeurisitcValue(heuristicValue);
+	return heuristicValue;
 }
 
 //--------------------------------------------------------------------------------------
@@ -250,7 +2250,7 @@ void Pathfinder::UpdateCosts(Heuristic heuristic, Node* pStartNode, Node* pTarge
 // Param1: The start node.
 // Param2: The target node.
 //--------------------------------------------------------------------------------------
-float Pathfinder::GetTraversalCost(const Node* pStartNode, const Node* pTargetNode)
+float Pathfinder::GetTraversalCost(const Node* pStartNode, const Node* pTargetNode) const
 {
 	float movementCost = 0.0f;
 
@@ -273,13 +2273,29 @@ float Pathfinder::GetTraversalCost(const Node* pStartNode, const Node* pTargetNo
 	return movementCost;
 }
 
+//--------------------------------------------------------------------------------------
+// Calculates the cost of moving between two arbitrary nodes along the straight line 
+// connecting them. Matches the traversal cost for adjacent nodes.
+// Param1: The start node.
+// Param2: The target node.
+// Returns the cost of the movement.
+//--------------------------------------------------------------------------------------
+float Pathfinder::GetStraightLineCost(const Node* pStartNode, const Node* pTargetNode) const
+{
+	// Changes along the x-axis are vertical moves, along the y-axis horizontal ones (see GetTraversalCost)
+	float deltaX = (pTargetNode->GetGridPosition().x - pStartNode->GetGridPosition().x) * m_weights.m_verticalCost;
+	float deltaY = (pTargetNode->GetGridPosition().y - pStartNode->GetGridPosition().y) * m_weights.m_horizontalCost;
+
+	return sqrtf(deltaX * deltaX + deltaY * deltaY);
+}
+
 //--------------------------------------------------------------------------------------
 // Calculates the euclidean distance between a start and target position.
 // Param1: The start position in world space.
 // Param2: The target position in world space.
 // Returns the Euclidean distance in world space.
 //--------------------------------------------------------------------------------------
-float Pathfinder::CalculateEuclideanDistance(const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition)
+float Pathfinder::CalculateEuclideanDistance(const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition) const
 {
 	// Get the vector from the start to the target position
 	XMVECTOR targetVector = XMLoadFloat2(&targetPosition) - XMLoadFloat2(&startPosition);
@@ -292,29 +2308,127 @@ float Pathfinder::CalculateEuclideanDistance(const XMFLOAT2& startPosition, cons
 }
 
 //--------------------------------------------------------------------------------------
-// Checks for a pair of adjacent nodes whether an entity would cut the corner of an 
-// obstacle when moving from one node to the other.
+// Calculates the octile distance between two nodes, that is the cost of the shortest path
+// between them on a grid without obstacles. Takes the traversal weights into account.
 // Param1: The start node.
-// Param2: The adjacent target node.
-// Returns true if the path from the start to the target node would cut a corner.
+// Param2: The target node.
+// Returns the octile distance between the nodes.
+//--------------------------------------------------------------------------------------
+float Pathfinder::CalculateOctileDistance(const Node* pStartNode, const Node* pTargetNode) const
+{
+	float deltaX = fabs(pTargetNode->GetGridPosition().x - pStartNode->GetGridPosition().x);
+	float deltaY = fabs(pTargetNode->GetGridPosition().y - pStartNode->GetGridPosition().y);
+	float diagonalSteps = std::min(deltaX, deltaY);
+
+	// Changes along the x-axis are vertical moves, along the y-axis horizontal ones (see GetTraversalCost)
+	return diagonalSteps * m_weights.m_diagonalCost + (deltaX - diagonalSteps) * m_weights.m_verticalCost + (deltaY - diagonalSteps) * m_weights.m_horizontalCost;
+}
+
+//--------------------------------------------------------------------------------------
+// Starts recording the statistics of a query in its search context.
+// Param1: The search context used by the query.
+//--------------------------------------------------------------------------------------
+void Pathfinder::BeginQuery(SearchContext& context) const
+{
+	context.ResetQueryStatistics();
+
+	if(g_kCollectPathfindingStatistics)
+	{
+		context.StartQueryTimer(m_statistics.GetTime());
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Stops measuring the wall time of a time-sliced query until its search is continued.
+// Param1: The search context used by the query.
+//--------------------------------------------------------------------------------------
+void Pathfinder::SuspendQuery(SearchContext& context) const
+{
+	if(g_kCollectPathfindingStatistics)
+	{
+		context.StopQueryTimer(m_statistics.GetTime());
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Continues measuring the wall time of a time-sliced query.
+// Param1: The search context used by the query.
+//--------------------------------------------------------------------------------------
+void Pathfinder::ResumeQuery(SearchContext& context) const
+{
+	if(g_kCollectPathfindingStatistics)
+	{
+		context.StartQueryTimer(m_statistics.GetTime());
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Completes the statistics of a query and adds them to the aggregated statistics of the pathfinder.
+// Param1: True if the query found a path (or the costs it was asked for), false otherwise.
+// Param2: The path found by the query in world space, nullptr for queries that do not return a path.
+// Param3: The search context used by the query.
 //--------------------------------------------------------------------------------------
-bool Pathfinder::IsCuttingCorner(Node* pStartNode, Node* pTargetNode)
+void Pathfinder::EndQuery(bool isSuccessful, const std::vector<XMFLOAT2>* pPath, SearchContext& context) const
 {
-	// The corner of an obstacle will only be cut if the nodes are placed diagonally, check that first
-	if((pStartNode->GetGridPosition().x != pTargetNode->GetGridPosition().x) && (pStartNode->GetGridPosition().y != pTargetNode->GetGridPosition().y))
+	context.MergeBackwardQueryStatistics();
+
+	PathQueryStatistics& statistics = context.GetQueryStatistics();
+	statistics.m_isPathFound = isSuccessful;
+
+	if(isSuccessful && pPath && !pPath->empty())
 	{
-		// Determine the difference in grid fields between the two nodes
-		int x = static_cast<int>(pTargetNode->GetGridPosition().x - pStartNode->GetGridPosition().x);
-		int y = static_cast<int>(pTargetNode->GetGridPosition().y - pStartNode->GetGridPosition().y);
+		statistics.m_numberOfWaypoints = pPath->size();
 
-		if((m_pEnvironment->GetNodes()[static_cast<int>(pStartNode->GetGridPosition().x) + x][static_cast<int>(pStartNode->GetGridPosition().y)].IsObstacle()) ||
-		   (m_pEnvironment->GetNodes()[static_cast<int>(pStartNode->GetGridPosition().x)][static_cast<int>(pStartNode->GetGridPosition().y) + y].IsObstacle()))
+		for(unsigned int i = 1; i < pPath->size(); ++i)
 		{
-			return true;
+			statistics.m_pathLength += CalculateEuclideanDistance((*pPath)[i - 1], (*pPath)[i]);
 		}
 	}
 
-	return false;
+	if(g_kCollectPathfindingStatistics)
+	{
+		context.StopQueryTimer(m_statistics.GetTime());
+		m_statistics.Record(statistics);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Checks the connected components of the node graph to tell whether a search between two 
+// nodes is bound to fail, which is determined in constant time instead of expanding the
+// whole part of the grid reachable from the start node.
+// Param1: The id of the start node.
+// Param2: The id of the target node.
+// Returns true if the target cannot be reached from the start, false if it can or if that is unknown.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::IsKnownUnreachable(unsigned long startId, unsigned long targetId) const
+{
+	const ConnectedComponents& connectedComponents = m_pEnvironment->GetConnectedComponents();
+
+	if(startId == targetId || !connectedComponents.IsUpToDate() || connectedComponents.GetComponent(startId) == g_kNoComponent)
+	{
+		// Searches from an obstacle can still lead to its traversable neighbours
+		return false;
+	}
+
+	return !connectedComponents.AreConnected(startId, targetId);
+}
+
+//--------------------------------------------------------------------------------------
+// Checks whether a grid field lies within the test environment and is not blocked by an obstacle.
+// Param1: The x-coordinate of the grid field.
+// Param2: The y-coordinate of the grid field.
+// Returns true if the grid field can be traversed, false otherwise.
+//--------------------------------------------------------------------------------------
+bool Pathfinder::IsTraversable(int gridX, int gridY) const
+{
+	int numberOfGridPartitions = static_cast<int>(m_pEnvironment->GetNumberOfGridPartitions());
+
+	if((gridX < 0) || (gridY < 0) || (gridX >= numberOfGridPartitions) || (gridY >= numberOfGridPartitions))
+	{
+		return false;
+	}
+
+	return !m_pEnvironment->GetNode(gridX, gridY)->IsObstacle();
 }
 
 // Data access functions
@@ -334,6 +2448,16 @@ float Pathfinder::GetWeightDiagonal(void) const
 	return m_weights.m_diagonalCost;
 }
 
+PathCache& Pathfinder::GetPathCache(void)
+{
+	return m_pathCache;
+}
+
+PathfindingStatistics& Pathfinder::GetStatistics(void)
+{
+	return m_statistics;
+}
+
 void Pathfinder::SetWeightHorizontal(float weight)
 {
 	m_weights.m_horizontalCost = weight;
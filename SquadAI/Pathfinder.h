@@ -2,6 +2,9 @@
 *  Kevin Meergans, SquadAI, 2014
 *  Pathfinder.h
 *  The pathfinder class contains functions to calculate paths within a test environment.
+*  The pathfinder only reads the node graph of the test environment, all data specific to 
+*  a search is kept in a search context provided by the caller. Thus, paths can be calculated
+*  concurrently as long as every thread uses its own search context.
 */
 
 #ifndef PATHFINDER_H
@@ -12,58 +15,39 @@
 #include <vector>
 #include <algorithm>
 #include "Node.h"
+#include "SearchContext.h"
+#include "PathCache.h"
+#include "PathfindingStatistics.h"
 
 // Forward Declaration
 class TestEnvironment;
+class ReservationTable;
 
 using namespace DirectX;
 
-//--------------------------------------------------------------------------------------
-// Defines available algorithms to use for path calculation by the pathfinder class.
-//--------------------------------------------------------------------------------------
-enum PathfindingAlgorithm
-{
-	AStar // A* pathfinding algorithm
-};
-
-//--------------------------------------------------------------------------------------
-// Defines available heuristic functions to estimate costs from a node to the target.
-//--------------------------------------------------------------------------------------
-enum Heuristic
-{
-	EuclideanDistance // Euclidean distance heuristic, length of the straight line between the node and the target used as estimate
-};
-
-//--------------------------------------------------------------------------------------
-// Bundles the weights associated to different type of graph node traversal.
-//--------------------------------------------------------------------------------------
-struct TraversalWeights
-{
-	TraversalWeights(void) : m_horizontalCost(1.0f),
-							 m_verticalCost(1.0f),
-							 m_diagonalCost(1.0f)
-	{}
-
-	float m_horizontalCost; // The cost associated to the traversal of a graph node in horizontal direction
-	float m_verticalCost;   // The cost associated to the traversal of a graph node in vertical direction
-	float m_diagonalCost;   // The cost associated to the traversal of a graph node in diagonal direction
-};
-
 class Pathfinder
 {
 public:
 	Pathfinder(void);
 	~Pathfinder(void);
 
-	bool Initialise(TestEnvironment* pTestEnvironment);
+	bool Initialise(const TestEnvironment* pTestEnvironment);
 	void UpdateWeights(void);
-	bool CalculatePath(PathfindingAlgorithm algorithm, Heuristic heuristic, const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition, std::vector<XMFLOAT2>& path);
+	bool CalculatePath(PathfindingAlgorithm algorithm, Heuristic heuristic, float suboptimality, const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const;
+	PathSearchStatus StartPathSearch(PathfindingAlgorithm algorithm, Heuristic heuristic, float suboptimality, const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition, std::vector<XMFLOAT2>& path, SearchContext& context, unsigned int& expansionBudget) const;
+	PathSearchStatus ContinuePathSearch(std::vector<XMFLOAT2>& path, SearchContext& context, unsigned int& expansionBudget) const;
+	void CalculateCostsInArea(const Node* pStartNode, unsigned int minX, unsigned int minY, unsigned int maxX, unsigned int maxY, SearchContext& context) const;
+	bool CalculatePathToNearest(const XMFLOAT2& startPosition, const std::vector<XMFLOAT2>& targetPositions, std::vector<XMFLOAT2>& path, unsigned int& targetIndex, SearchContext& context) const;
+	void CalculatePathCosts(const XMFLOAT2& sourcePosition, const std::vector<XMFLOAT2>& targetPositions, std::vector<float>& costs, SearchContext& context) const;
+	bool CalculateCooperativePath(unsigned long entityId, const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition, const ReservationTable& reservationTable, std::vector<XMFLOAT2>& path, SearchContext& context) const;
 
 	// Data access functions
 
 	float GetWeightHorizontal(void) const;
 	float GetWeightVertical(void) const;
 	float GetWeightDiagonal(void) const;
+	PathCache& GetPathCache(void);
+	PathfindingStatistics& GetStatistics(void);
 
 	void SetWeightHorizontal(float weight);
 	void SetWeightVertical(float weight);
@@ -71,49 +55,50 @@ public:
 
 private:
 
-	bool  CalculatePathAStar(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path);
-	void  UpdateCosts(Heuristic heuristic, Node* pStartNode, Node* pTargetNode);
-	float GetTraversalCost(const Node* pStartNode, const Node* pTargetNode);
-	float CalculateEstimate(Node* pStartNode, Node* pTargetNode);
-	float CalculateEuclideanDistance(const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition);
-	void  ConstructPath(Node* pTargetNode, std::vector<XMFLOAT2>& path);
-	bool  IsCuttingCorner(Node* pStartNode, Node* pTargetNode);
-
-	TestEnvironment* m_pEnvironment; // A pointer to the test environment this pathfinder belongs to
-	TraversalWeights m_weights;      // The weights used to calculate distances in the graph
-
-	std::vector<Node*> m_openList;   // List of open nodes required for A* pathfinding
-	std::vector<Node*> m_closedList; // List of closed nodes required for A* pathfinding
-
-	//--------------------------------------------------------------------------------------
-	// Private comparator class used to determine which node to choose from the open list.
-	// Can be used to sort a container of pointers to nodes according to their respective
-	// combined cost (cost so far + heuristic estimate).
-	//--------------------------------------------------------------------------------------
-	class CompareNodeCosts
-	{
-	public:
-		bool operator()(const Node* pNode1, const Node* pNode2) 
-		{
-			return pNode1->GetTotalEstimate() < pNode2->GetTotalEstimate();
-		}
-    };
-
-	//--------------------------------------------------------------------------------------
-	// Private comparator class used to find a node with a certain id within a container.
-	//--------------------------------------------------------------------------------------
-	class FindNodeWithId
-	{
-	public:
-		FindNodeWithId(unsigned long id) : m_id(id){}
-		bool operator()(const Node* pNode) 
-		{
-			return pNode->GetId() == m_id;
-		}
-
-	private:
-		unsigned long m_id;
-    };
+	bool  CalculatePathUncached(PathfindingAlgorithm algorithm, Heuristic heuristic, float suboptimality, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const;
+	bool  CalculatePathAStar(Heuristic heuristic, float heuristicWeight, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const;
+	bool  SearchArea(Heuristic heuristic, float heuristicWeight, const Node* pStartNode, const Node* pTargetNode, unsigned int minX, unsigned int minY, unsigned int maxX, unsigned int maxY, SearchContext& context) const;
+	void  StartSearch(Heuristic heuristic, float heuristicWeight, const Node* pStartNode, const Node* pTargetNode, SearchContext& context) const;
+	void  StartAdaptiveSearch(Heuristic heuristic, const Node* pStartNode, const Node* pTargetNode, SearchContext& context) const;
+	bool  CalculatePathAdaptiveAStar(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const;
+	PathSearchStatus ExpandSearch(Heuristic heuristic, float heuristicWeight, const Node* pTargetNode, unsigned int minX, unsigned int minY, unsigned int maxX, unsigned int maxY, SearchContext& context, unsigned int& expansionBudget) const;
+	bool  CalculatePathHierarchical(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const;
+	void  UpdateAbstractNode(Heuristic heuristic, unsigned long id, unsigned long parentId, float movementCost, const Node* pTargetNode, SearchContext& context) const;
+	bool  CalculatePathBidirectional(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const;
+	void  ExpandBidirectional(Heuristic heuristic, const Node* pSourceNode, const Node* pTargetNode, SearchContext& context, const SearchContext& otherContext, float& bestCost, unsigned long& meetingId) const;
+	float CalculateBidirectionalPotential(Heuristic heuristic, const Node* pNode, const Node* pSourceNode, const Node* pTargetNode) const;
+	bool  CalculatePathNavigationMesh(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const;
+	void  PullStringThroughPortals(const std::vector<XMFLOAT2>& portals, std::vector<XMFLOAT2>& path) const;
+	float CalculateSignedArea(const XMFLOAT2& apex, const XMFLOAT2& first, const XMFLOAT2& second) const;
+	bool  CalculatePathThetaStar(Heuristic heuristic, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const;
+	bool  CalculatePathJumpPointSearch(Heuristic heuristic, float heuristicWeight, const XMFLOAT2& startGridPosition, const XMFLOAT2& targetGridPosition, std::vector<XMFLOAT2>& path, SearchContext& context) const;
+	const Node* Jump(const Node* pNode, int directionX, int directionY, const Node* pTargetNode) const;
+	unsigned int GetJumpDirections(const Node* pNode, const SearchContext& context, int directionsX[8], int directionsY[8]) const;
+	void  ConstructJumpPointPath(const Node* pTargetNode, const SearchContext& context, std::vector<XMFLOAT2>& path) const;
+	bool  IsTraversable(int gridX, int gridY) const;
+	float CalculateHeuristic(Heuristic heuristic, const Node* pNode, const Node* pTargetNode) const;
+	float GetTraversalCost(const Node* pStartNode, const Node* pTargetNode) const;
+	float GetStraightLineCost(const Node* pStartNode, const Node* pTargetNode) const;
+	float CalculateEuclideanDistance(const XMFLOAT2& startPosition, const XMFLOAT2& targetPosition) const;
+	float CalculateOctileDistance(const Node* pStartNode, const Node* pTargetNode) const;
+	void  ConstructPath(const Node* pTargetNode, const SearchContext& context, std::vector<XMFLOAT2>& path) const;
+	void  FinalisePath(std::vector<XMFLOAT2>& path) const;
+	void  RemoveCollinearWaypoints(std::vector<XMFLOAT2>& path) const;
+	void  StraightenPath(std::vector<XMFLOAT2>& path) const;
+	bool  IsKnownUnreachable(unsigned long startId, unsigned long targetId) const;
+	unsigned int SearchTargets(const Node* pStartNode, const std::vector<unsigned long>& targetIds, unsigned int numberOfTargetsToClose, SearchContext& context) const;
+	float		 CalculateNearestTargetDistance(const Node* pNode, const std::vector<unsigned long>& targetIds) const;
+	unsigned int GetReachableTargets(const Node* pStartNode, const std::vector<XMFLOAT2>& targetPositions, std::vector<unsigned long>& targetIds) const;
+	const Node*  GetNodeAt(const XMFLOAT2& position) const;
+	void		 BeginQuery(SearchContext& context) const;
+	void		 SuspendQuery(SearchContext& context) const;
+	void		 ResumeQuery(SearchContext& context) const;
+	void		 EndQuery(bool isSuccessful, const std::vector<XMFLOAT2>* pPath, SearchContext& context) const;
+
+	const TestEnvironment*		  m_pEnvironment; // A pointer to the test environment this pathfinder belongs to
+	TraversalWeights			  m_weights;	  // The weights used to calculate distances in the graph
+	mutable PathCache			  m_pathCache;	  // Holds the results of recent searches, shared by all callers
+	mutable PathfindingStatistics m_statistics;	  // Aggregates the statistics of all queries answered by the pathfinder
 };
 
 #endif // PATHFINDER_H
\ No newline at end of file
@@ -0,0 +1,139 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  PathfindingData.h
+*  Contains data structures used by the pathfinder and its search contexts.
+*/
+
+#ifndef PATHFINDING_DATA_H
+#define PATHFINDING_DATA_H
+
+//--------------------------------------------------------------------------------------
+// Defines available algorithms to use for path calculation by the pathfinder class.
+//--------------------------------------------------------------------------------------
+enum PathfindingAlgorithm
+{
+	AStar,			   // A* pathfinding algorithm
+	JumpPointSearch,   // Jump point search, A* variant for uniform cost grids that only expands jump points instead of all adjacent nodes
+	HierarchicalAStar, // Hierarchical A* (HPA*), searches the cluster graph of the environment and refines the result within the crossed clusters
+	AdaptiveAStar,	   // Moving target adaptive A* (MT-Adaptive A*), improves the heuristic with the results of the previous searches of the same search context
+	ThetaStar,		   // Theta*, any-angle A* variant that connects nodes to the parent of their predecessor if there is a line of sight between them
+	BidirectionalAStar, // Bidirectional A*, searches from the start and the target at the same time until the searches meet, finds paths as short as A*
+	NavigationMeshAStar // A* on the rectangles of the navigation mesh, the corridor of rectangles is turned into a path by the funnel algorithm
+};
+
+//--------------------------------------------------------------------------------------
+// Defines available heuristic functions to estimate costs from a node to the target.
+//--------------------------------------------------------------------------------------
+enum Heuristic
+{
+	EuclideanDistance, // Euclidean distance heuristic, length of the straight line between the node and the target used as estimate
+	OctileDistance,	   // Octile distance heuristic, cost of the shortest path between the node and the target on an empty 8-connected grid
+	LandmarkDistance   // Landmark (ALT) heuristic, lower bound derived from the distances to a set of landmarks, at least the octile distance
+};
+
+//--------------------------------------------------------------------------------------
+// Defines the possible outcomes of a time-sliced path search.
+//--------------------------------------------------------------------------------------
+enum PathSearchStatus
+{
+	SearchSucceeded, // A path to the target was found
+	SearchFailed,	 // There is no path to the target
+	SearchPending	 // The search ran out of node expansions for now and has to be continued later on
+};
+
+//--------------------------------------------------------------------------------------
+// Bundles the weights associated to different type of graph node traversal.
+//--------------------------------------------------------------------------------------
+struct TraversalWeights
+{
+	TraversalWeights(void) : m_horizontalCost(1.0f),
+							 m_verticalCost(1.0f),
+							 m_diagonalCost(1.0f)
+	{}
+
+	float m_horizontalCost; // The cost associated to the traversal of a graph node in horizontal direction
+	float m_verticalCost;   // The cost associated to the traversal of a graph node in vertical direction
+	float m_diagonalCost;   // The cost associated to the traversal of a graph node in diagonal direction
+};
+
+//--------------------------------------------------------------------------------------
+// Holds the search data associated to a single node of the graph during a search. The
+// data is only valid if its generation matches the current generation of the search
+// context it belongs to.
+//--------------------------------------------------------------------------------------
+struct SearchNodeData
+{
+	SearchNodeData(void) : m_parentId(0),
+						   m_movementCost(0.0f),
+						   m_heuristicValue(0.0f),
+						   m_generation(0),
+						   m_heapIndex(0),
+						   m_isClosed(false)
+	{}
+
+	float GetTotalEstimate(void) const
+	{
+		return m_movementCost + m_heuristicValue;
+	}
+
+	unsigned long m_parentId;       // The id of the current parent node of this one, the start node is its own parent
+	float		  m_movementCost;   // The cost of a path from the start position to this node
+	float		  m_heuristicValue; // A heuristic value used as an estimate of the cost from this node to the target
+	unsigned int  m_generation;	    // The search that last visited this node
+	unsigned int  m_heapIndex;	    // The position of the node within the open list heap while it is open
+	bool		  m_isClosed;	    // Tells whether the node is on the closed list of the search that last visited it (otherwise it is open)
+};
+
+//--------------------------------------------------------------------------------------
+// Holds the parameters of a time-sliced search that has not completed yet. The search data
+// of the visited nodes is kept in the search context.
+//--------------------------------------------------------------------------------------
+struct PendingSearch
+{
+	PendingSearch(void) : m_isPending(false),
+						  m_algorithm(AStar),
+						  m_startId(0),
+						  m_targetId(0),
+						  m_heuristic(EuclideanDistance),
+						  m_suboptimality(0.0f),
+						  m_obstacleVersion(0)
+	{}
+
+	bool				 m_isPending;		// Tells whether there is a search to continue
+	PathfindingAlgorithm m_algorithm;		// The algorithm used by the search, either A* or adaptive A*
+	unsigned long		 m_startId;			// The id of the start node of the search
+	unsigned long		 m_targetId;		// The id of the target node of the search
+	Heuristic			 m_heuristic;		// The heuristic used by the search
+	float				 m_suboptimality;	// The suboptimality bound of the search, 0 for a shortest path
+	unsigned int		 m_obstacleVersion; // The obstacle version of the test environment when the search was started
+};
+
+//--------------------------------------------------------------------------------------
+// Describes the cost and the result of a single query to the pathfinder. The search context
+// used by the query holds the record until the next query is started with it.
+//--------------------------------------------------------------------------------------
+struct PathQueryStatistics
+{
+	PathQueryStatistics(void) : m_pCallerTag(nullptr),
+								m_nodesExpanded(0),
+								m_nodesTouched(0),
+								m_openListPeak(0),
+								m_pathLength(0.0f),
+								m_numberOfWaypoints(0),
+								m_wallTime(0),
+								m_isPathFound(false),
+								m_isCacheHit(false)
+	{}
+
+	const char*		   m_pCallerTag;		// The name of the behaviour action or manoeuvre that issued the query, nullptr if the search context was not tagged
+	unsigned long	   m_nodesExpanded;		// The number of nodes that were closed
+	unsigned long	   m_nodesTouched;		// The number of nodes that were added to the open list
+	unsigned int	   m_openListPeak;		// The largest number of nodes held by the open list at the same time
+	float			   m_pathLength;		// The length of the resulting path in world space, 0 if no path was found
+	unsigned int	   m_numberOfWaypoints; // The number of waypoints of the resulting path, 0 if no path was found
+	unsigned long long m_wallTime;			// The time in nanoseconds spent on the query, summed up over all slices of a time-sliced search
+	bool			   m_isPathFound;		// Tells whether the query succeeded
+	bool			   m_isCacheHit;		// Tells whether the result was taken from the path cache
+};
+
+#endif // PATHFINDING_DATA_H
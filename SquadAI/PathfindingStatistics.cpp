@@ -0,0 +1,159 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  PathfindingStatistics.cpp
+*  Aggregates the statistics of the queries answered by the pathfinder, both in total and
+*  for each caller tag (the behaviour action or manoeuvre that issued the query). Histograms
+*  of the expanded nodes and the wall time per query show how the cost is distributed.
+*  The aggregates can be read at runtime and are written to the log at the end of a match.
+*/
+
+// Includes
+#include <windows.h>
+#include <algorithm>
+#include "PathfindingStatistics.h"
+
+PathfindingStatistics::PathfindingStatistics(void) : m_timerFrequency(0)
+{
+	LARGE_INTEGER frequency;
+
+	if(QueryPerformanceFrequency(&frequency))
+	{
+		m_timerFrequency = frequency.QuadPart;
+	}
+
+	Reset();
+}
+
+PathfindingStatistics::~PathfindingStatistics(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Adds the statistics of a completed query to the totals and histograms.
+// Param1: The statistics of the query.
+//--------------------------------------------------------------------------------------
+void PathfindingStatistics::Record(const PathQueryStatistics& query)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	AddToTotals(query, m_totals);
+	AddToTotals(query, m_callerTotals[query.m_pCallerTag ? query.m_pCallerTag : "Untagged"]);
+
+	++m_expansionHistogram[GetHistogramBucket(query.m_nodesExpanded)];
+	++m_wallTimeHistogram[GetHistogramBucket(query.m_wallTime)];
+}
+
+//--------------------------------------------------------------------------------------
+// Discards the statistics of all queries recorded so far, for instance at the start of a match.
+//--------------------------------------------------------------------------------------
+void PathfindingStatistics::Reset(void)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_totals = PathQueryTotals();
+	m_callerTotals.clear();
+
+	std::fill(m_expansionHistogram, m_expansionHistogram + g_kNumberOfHistogramBuckets, 0);
+	std::fill(m_wallTimeHistogram, m_wallTimeHistogram + g_kNumberOfHistogramBuckets, 0);
+}
+
+//--------------------------------------------------------------------------------------
+// Reads the high resolution timer, used to measure the wall time of the queries.
+// Returns the current time in nanoseconds.
+//--------------------------------------------------------------------------------------
+unsigned long long PathfindingStatistics::GetTime(void) const
+{
+	LARGE_INTEGER counter;
+
+	if(m_timerFrequency == 0 || !QueryPerformanceCounter(&counter))
+	{
+		return 0;
+	}
+
+	// Convert whole seconds and the remaining ticks separately to avoid overflowing
+	unsigned long long seconds = counter.QuadPart / m_timerFrequency;
+	unsigned long long ticks   = counter.QuadPart % m_timerFrequency;
+
+	return seconds * 1000000000ULL + ticks * 1000000000ULL / m_timerFrequency;
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the histogram bucket a value is counted in.
+// Param1: The value, e.g. the number of expanded nodes.
+// Returns the index of the bucket, the number of significant bits of the value.
+//--------------------------------------------------------------------------------------
+unsigned int PathfindingStatistics::GetHistogramBucket(unsigned long long value)
+{
+	unsigned int bucket = 0;
+
+	while(value != 0 && bucket < g_kNumberOfHistogramBuckets - 1)
+	{
+		value >>= 1;
+		++bucket;
+	}
+
+	return bucket;
+}
+
+//--------------------------------------------------------------------------------------
+// Adds the statistics of a query to accumulated statistics.
+// Param1: The statistics of the query.
+// Param2: The accumulated statistics to add the query to.
+//--------------------------------------------------------------------------------------
+void PathfindingStatistics::AddToTotals(const PathQueryStatistics& query, PathQueryTotals& totals)
+{
+	++totals.m_numberOfQueries;
+
+	if(!query.m_isPathFound)
+	{
+		++totals.m_numberOfFailedQueries;
+	}
+
+	if(query.m_isCacheHit)
+	{
+		++totals.m_numberOfCacheHits;
+	}
+
+	totals.m_nodesExpanded	   += query.m_nodesExpanded;
+	totals.m_nodesTouched	   += query.m_nodesTouched;
+	totals.m_pathLength		   += query.m_pathLength;
+	totals.m_numberOfWaypoints += query.m_numberOfWaypoints;
+	totals.m_wallTime		   += query.m_wallTime;
+
+	// Not using std::max, windows.h defines a macro of the same name
+	if(query.m_openListPeak > totals.m_maxOpenListPeak)
+	{
+		totals.m_maxOpenListPeak = query.m_openListPeak;
+	}
+
+	if(query.m_wallTime > totals.m_maxWallTime)
+	{
+		totals.m_maxWallTime = query.m_wallTime;
+	}
+}
+
+// Data access functions
+
+PathQueryTotals PathfindingStatistics::GetTotals(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_totals;
+}
+
+void PathfindingStatistics::GetCallerTotals(std::map<std::string, PathQueryTotals>& callerTotals) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	callerTotals = m_callerTotals;
+}
+
+void PathfindingStatistics::GetExpansionHistogram(unsigned long histogram[g_kNumberOfHistogramBuckets]) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::copy(m_expansionHistogram, m_expansionHistogram + g_kNumberOfHistogramBuckets, histogram);
+}
+
+void PathfindingStatistics::GetWallTimeHistogram(unsigned long histogram[g_kNumberOfHistogramBuckets]) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::copy(m_wallTimeHistogram, m_wallTimeHistogram + g_kNumberOfHistogramBuckets, histogram);
+}
@@ -0,0 +1,86 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  PathfindingStatistics.h
+*  Aggregates the statistics of the queries answered by the pathfinder, both in total and
+*  for each caller tag (the behaviour action or manoeuvre that issued the query). Histograms
+*  of the expanded nodes and the wall time per query show how the cost is distributed.
+*  The aggregates can be read at runtime and are written to the log at the end of a match.
+*/
+
+#ifndef PATHFINDING_STATISTICS_H
+#define PATHFINDING_STATISTICS_H
+
+// Includes
+#include <map>
+#include <string>
+#include <mutex>
+#include "PathfindingData.h"
+
+// The number of buckets of the histograms, bucket 0 counts the value 0, bucket i > 0 the values in [2^(i-1), 2^i),
+// the last bucket also counts all greater values
+const unsigned int g_kNumberOfHistogramBuckets = 32;
+
+//--------------------------------------------------------------------------------------
+// The accumulated statistics of a number of pathfinder queries.
+//--------------------------------------------------------------------------------------
+struct PathQueryTotals
+{
+	PathQueryTotals(void) : m_numberOfQueries(0),
+							m_numberOfFailedQueries(0),
+							m_numberOfCacheHits(0),
+							m_nodesExpanded(0),
+							m_nodesTouched(0),
+							m_maxOpenListPeak(0),
+							m_pathLength(0.0),
+							m_numberOfWaypoints(0),
+							m_wallTime(0),
+							m_maxWallTime(0)
+	{}
+
+	unsigned long	   m_numberOfQueries;		// The number of queries
+	unsigned long	   m_numberOfFailedQueries; // The number of queries that did not find a path
+	unsigned long	   m_numberOfCacheHits;		// The number of queries answered by the path cache
+	unsigned long long m_nodesExpanded;			// The number of nodes expanded by all queries
+	unsigned long long m_nodesTouched;			// The number of nodes added to the open list by all queries
+	unsigned int	   m_maxOpenListPeak;		// The largest open list of any of the queries
+	double			   m_pathLength;			// The summed up length of all paths found
+	unsigned long long m_numberOfWaypoints;		// The summed up number of waypoints of all paths found
+	unsigned long long m_wallTime;				// The time in nanoseconds spent on all queries
+	unsigned long long m_maxWallTime;			// The time in nanoseconds spent on the most expensive query
+};
+
+class PathfindingStatistics
+{
+public:
+	PathfindingStatistics(void);
+	~PathfindingStatistics(void);
+
+	void			   Record(const PathQueryStatistics& query);
+	void			   Reset(void);
+	unsigned long long GetTime(void) const;
+
+	static unsigned int GetHistogramBucket(unsigned long long value);
+
+	// Data access functions
+
+	PathQueryTotals GetTotals(void) const;
+	void			GetCallerTotals(std::map<std::string, PathQueryTotals>& callerTotals) const;
+	void			GetExpansionHistogram(unsigned long histogram[g_kNumberOfHistogramBuckets]) const;
+	void			GetWallTimeHistogram(unsigned long histogram[g_kNumberOfHistogramBuckets]) const;
+
+private:
+	// Holds a mutex, prevent copies
+	PathfindingStatistics(const PathfindingStatistics&);
+	PathfindingStatistics& operator=(const PathfindingStatistics&);
+
+	void AddToTotals(const PathQueryStatistics& query, PathQueryTotals& totals);
+
+	PathQueryTotals						   m_totals;										  // The statistics of all queries
+	std::map<std::string, PathQueryTotals> m_callerTotals;									  // The statistics of the queries of each caller tag
+	unsigned long						   m_expansionHistogram[g_kNumberOfHistogramBuckets]; // The number of queries per power of two of expanded nodes
+	unsigned long						   m_wallTimeHistogram[g_kNumberOfHistogramBuckets];  // The number of queries per power of two of nanoseconds spent
+	long long							   m_timerFrequency;								  // The number of ticks per second of the high resolution timer
+	mutable std::mutex					   m_mutex;											  // Synchronises recording from concurrent searches
+};
+
+#endif // PATHFINDING_STATISTICS_H
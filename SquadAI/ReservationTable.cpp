@@ -0,0 +1,141 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  ReservationTable.cpp
+*  A space-time reservation table shared by the members of a team for cooperative pathfinding
+*  (windowed hierarchical cooperative A*, WHCA*). Time is divided into steps, each as long as
+*  it takes a soldier to cross a grid field. A path planned cooperatively reserves the grid fields
+*  it occupies at each of the next steps, later searches of the team avoid these fields at the
+*  respective steps. Only a limited window of steps is covered, reservations expire as time passes.
+*/
+
+// Includes
+#include "ReservationTable.h"
+
+ReservationTable::ReservationTable(void) : m_numberOfNodes(0),
+										   m_window(0),
+										   m_timeStep(0.0f),
+										   m_currentStep(0),
+										   m_elapsedTime(0.0f)
+{
+}
+
+ReservationTable::~ReservationTable(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Initialises the reservation table for a grid and removes all reservations.
+// Param1: The number of nodes of the grid.
+// Param2: The number of time steps, for which grid fields can be reserved in advance.
+// Param3: The duration of a time step in seconds.
+//--------------------------------------------------------------------------------------
+void ReservationTable::Initialise(unsigned int numberOfNodes, unsigned int window, float timeStep)
+{
+	m_numberOfNodes = numberOfNodes;
+	m_window		= window;
+	m_timeStep		= timeStep;
+
+	m_reservations.assign(numberOfNodes * window, Reservation());
+
+	m_currentStep = 0;
+	m_elapsedTime = 0.0f;
+}
+
+//--------------------------------------------------------------------------------------
+// Advances the time of the table. Reservations for steps that have passed expire, the
+// space they occupied is reused for the steps entering the window.
+// Param1: The time in seconds passed since the last frame.
+//--------------------------------------------------------------------------------------
+void ReservationTable::Advance(float deltaTime)
+{
+	if(m_timeStep <= 0.0f)
+	{
+		return;
+	}
+
+	m_elapsedTime += deltaTime;
+
+	while(m_elapsedTime >= m_timeStep)
+	{
+		m_elapsedTime -= m_timeStep;
+		++m_currentStep;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Removes all reservations.
+//--------------------------------------------------------------------------------------
+void ReservationTable::Clear(void)
+{
+	m_reservations.assign(m_numberOfNodes * m_window, Reservation());
+
+	m_currentStep = 0;
+	m_elapsedTime = 0.0f;
+}
+
+//--------------------------------------------------------------------------------------
+// Reserves a grid field for an entity at a time step. Replaces any earlier reservation of
+// the field at that step.
+// Param1: The id of the node to reserve.
+// Param2: The time step relative to the current one, reservations outside of the window are ignored.
+// Param3: The id of the entity making the reservation.
+//--------------------------------------------------------------------------------------
+void ReservationTable::Reserve(unsigned long nodeId, unsigned int step, unsigned long entityId)
+{
+	if(step >= m_window)
+	{
+		return;
+	}
+
+	Reservation& reservation = m_reservations[((m_currentStep + step) % m_window) * m_numberOfNodes + nodeId];
+
+	reservation.m_entityId = entityId;
+	reservation.m_step	   = m_currentStep + step;
+}
+
+//--------------------------------------------------------------------------------------
+// Cancels all reservations of an entity, for instance before its path is replanned.
+// Param1: The id of the entity.
+//--------------------------------------------------------------------------------------
+void ReservationTable::Release(unsigned long entityId)
+{
+	for(std::vector<Reservation>::iterator it = m_reservations.begin(); it != m_reservations.end(); ++it)
+	{
+		if(it->m_entityId == entityId)
+		{
+			it->m_entityId = 0;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Looks up, which entity reserved a grid field at a time step.
+// Param1: The id of the node.
+// Param2: The time step relative to the current one.
+// Returns the id of the entity that reserved the field, 0 if the field is free at that step or the
+// step lies outside of the window.
+//--------------------------------------------------------------------------------------
+unsigned long ReservationTable::GetReservation(unsigned long nodeId, unsigned int step) const
+{
+	if(step >= m_window)
+	{
+		return 0;
+	}
+
+	const Reservation& reservation = m_reservations[((m_currentStep + step) % m_window) * m_numberOfNodes + nodeId];
+
+	// Reservations left over from earlier steps occupying the same slot have expired
+	return (reservation.m_step == m_currentStep + step) ? reservation.m_entityId : 0;
+}
+
+// Data access functions
+
+unsigned int ReservationTable::GetWindow(void) const
+{
+	return m_window;
+}
+
+float ReservationTable::GetTimeStep(void) const
+{
+	return m_timeStep;
+}
@@ -0,0 +1,58 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  ReservationTable.h
+*  A space-time reservation table shared by the members of a team for cooperative pathfinding
+*  (windowed hierarchical cooperative A*, WHCA*). Time is divided into steps, each as long as
+*  it takes a soldier to cross a grid field. A path planned cooperatively reserves the grid fields
+*  it occupies at each of the next steps, later searches of the team avoid these fields at the
+*  respective steps. Only a limited window of steps is covered, reservations expire as time passes.
+*/
+
+#ifndef RESERVATION_TABLE_H
+#define RESERVATION_TABLE_H
+
+// Includes
+#include <vector>
+
+//--------------------------------------------------------------------------------------
+// The reservation of a grid field at a certain time step.
+//--------------------------------------------------------------------------------------
+struct Reservation
+{
+	Reservation(void) : m_entityId(0),
+						m_step(0)
+	{}
+
+	unsigned long m_entityId; // The id of the entity that reserved the grid field, 0 if there is none
+	unsigned int  m_step;	  // The absolute time step the reservation is valid for
+};
+
+class ReservationTable
+{
+public:
+	ReservationTable(void);
+	~ReservationTable(void);
+
+	void Initialise(unsigned int numberOfNodes, unsigned int window, float timeStep);
+	void Advance(float deltaTime);
+	void Clear(void);
+
+	void		  Reserve(unsigned long nodeId, unsigned int step, unsigned long entityId);
+	void		  Release(unsigned long entityId);
+	unsigned long GetReservation(unsigned long nodeId, unsigned int step) const;
+
+	// Data access functions
+
+	unsigned int GetWindow(void) const;
+	float		 GetTimeStep(void) const;
+
+private:
+	std::vector<Reservation> m_reservations;  // The reservations of all nodes for each step of the window, indexed by (absolute step % window) * number of nodes + node id
+	unsigned int			 m_numberOfNodes; // The number of nodes of the grid
+	unsigned int			 m_window;		  // The number of time steps, for which grid fields can be reserved in advance
+	float					 m_timeStep;	  // The duration of a time step in seconds
+	unsigned int			 m_currentStep;	  // The absolute time step the team is currently in
+	float					 m_elapsedTime;	  // The time in seconds passed since the start of the current step
+};
+
+#endif // RESERVATION_TABLE_H
@@ -167,12 +167,17 @@ void RushBaseAttack::StartAttack(void)
 
 	for(std::vector<Entity*>::iterator it = m_participants.begin(); it != m_participants.end(); ++it)
 	{
-		// Send out the new move orders to attack the enemy flag/base
-		Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, XMFLOAT2(target));
+		// Send out the new move orders to attack the enemy flag/base, the way across the map is searched
+		// hierarchically if no cooperative path can be planned
+		MoveOrder* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, XMFLOAT2(target), 0.0f, HierarchicalAStar);
 		
 		if(!pNewOrder)
 		{
 			SetFailed(true);
+		}else
+		{
+			// Let the attackers take turns at narrow entrances instead of pushing through them together
+			GetTeamAI()->CalculateCooperativePath(*it, target, *pNewOrder->GetPath(), GetManoeuvreNameFromType(GetType()));
 		}
 		
 		FollowOrderMessageData data(pNewOrder);
@@ -301,7 +306,7 @@ BehaviourStatus RushBaseAttack::Initiate(void)
 
 	for(std::vector<Entity*>::iterator it = m_participants.begin(); it != m_participants.end(); ++it)
 	{
-		Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, m_assemblyPoint);
+		Order* pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, m_assemblyPoint, g_kAssemblyPathSuboptimality);
 			
 		if(!pNewOrder)
 		{
@@ -0,0 +1,423 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  SearchContext.cpp
+*  Holds the scratch data of path searches, such as the open list and the costs
+*  associated to the visited nodes. Keeping this data separate from the node graph
+*  allows several searches to run at the same time on the same graph, as long as 
+*  each of them uses its own search context. A search context can be reused for any
+*  number of consecutive searches. Consecutive adaptive searches learn improved heuristic
+*  values from the data left behind by the previous ones (moving target adaptive A*).
+*/
+
+// Includes
+#include <cfloat>
+#include <algorithm>
+#include "SearchContext.h"
+#include "ApplicationSettings.h"
+
+SearchContext::SearchContext(void) : m_generation(0),
+									 m_adaptiveFirstGeneration(0),
+									 m_adaptiveTargetId(0),
+									 m_adaptiveObstacleVersion(0),
+									 m_isAdaptiveSearch(false),
+									 m_pBackwardContext(nullptr),
+									 m_pCallerTag(nullptr),
+									 m_queryTimerStart(0),
+									 m_isQueryTimerRunning(false)
+{
+}
+
+SearchContext::~SearchContext(void)
+{
+	if(m_pBackwardContext)
+	{
+		delete m_pBackwardContext;
+		m_pBackwardContext = nullptr;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Prepares the context for a new search. Instead of resetting the data of every node, the 
+// search generation is incremented, which marks the data of all nodes as outdated at once.
+// The node data only ever grows, so graphs of different sizes (e.g. the grid and the navigation
+// mesh) can be searched alternately without reallocating it.
+// Param1: The number of nodes in the graph that will be searched.
+//--------------------------------------------------------------------------------------
+void SearchContext::BeginSearch(unsigned int numberOfNodes)
+{
+	if(m_nodeData.size() < numberOfNodes)
+	{
+		// The graph is larger than any searched before, grow the node data. This only happens when the
+		// context is used for the first time or the test environment grew. The added nodes are stamped
+		// with generation 0, which is never current, so the data of the other nodes remains valid.
+		m_nodeData.resize(numberOfNodes, SearchNodeData());
+		m_openList.Reserve(numberOfNodes);
+	}
+
+	m_openList.Initialise(&m_nodeData);
+	m_openList.Clear();
+
+	// A new search overwrites the data of a search that might still be pending
+	m_pendingSearch.m_isPending = false;
+	m_isAdaptiveSearch			= false;
+
+	++m_generation;
+
+	if(m_generation == 0)
+	{
+		// The generation counter wrapped around, clear the stamps of all nodes once to prevent
+		// stale stamps from being mistaken for current ones.
+		for(std::vector<SearchNodeData>::iterator it = m_nodeData.begin(); it != m_nodeData.end(); ++it)
+		{
+			it->m_generation = 0;
+		}
+
+		m_generation = 1;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Prepares the context for a new adaptive search. The search continues the current series
+// of adaptive searches if the previous search of this context belonged to it and the obstacles
+// did not change, otherwise a new series is started without any learned heuristic values.
+// Param1: The number of nodes in the graph that will be searched.
+// Param2: The id of the target node of the search.
+// Param3: The current obstacle version of the test environment.
+// Param4: The learned heuristic value of the new target node with regard to the target of the
+//         previous search (see GetAdaptiveHeuristic), only used if the target moved.
+//--------------------------------------------------------------------------------------
+void SearchContext::BeginAdaptiveSearch(unsigned int numberOfNodes, unsigned long targetId, unsigned int obstacleVersion, float targetHeuristicValue)
+{
+	bool  isSeriesContinued = HasLearnedHeuristic(obstacleVersion) && m_adaptiveCorrections.size() < g_kMaxAdaptiveSearchSeriesLength;
+	float correction		= 0.0f;
+
+	if(isSeriesContinued)
+	{
+		// When the target moves, the learned values are no longer exact. Lowering them by the estimated
+		// distance between the old and the new target keeps them admissible and consistent.
+		correction = m_adaptiveCorrections.back() + ((targetId != m_adaptiveTargetId) ? targetHeuristicValue : 0.0f);
+	}
+
+	BeginSearch(numberOfNodes);
+
+	if(!isSeriesContinued || m_generation != m_adaptiveFirstGeneration + m_adaptiveCorrections.size())
+	{
+		// Start a new series, this also happens when another search used the context in between
+		m_adaptiveFirstGeneration = m_generation;
+		m_adaptivePathCosts.clear();
+		m_adaptiveCorrections.clear();
+		correction = 0.0f;
+	}
+
+	m_adaptivePathCosts.push_back(FLT_MAX);
+	m_adaptiveCorrections.push_back(correction);
+
+	m_adaptiveTargetId		  = targetId;
+	m_adaptiveObstacleVersion = obstacleVersion;
+	m_isAdaptiveSearch		  = true;
+}
+
+//--------------------------------------------------------------------------------------
+// Records the result of the current adaptive search. Nodes closed by the search learn their
+// exact distance to the target from it the next time they are visited.
+// Param1: The cost of the path found by the search, FLT_MAX if there is none.
+//--------------------------------------------------------------------------------------
+void SearchContext::EndAdaptiveSearch(float pathCost)
+{
+	if(m_isAdaptiveSearch)
+	{
+		m_adaptivePathCosts.back() = pathCost;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the heuristic value of a node for the current adaptive search. Nodes closed by an
+// earlier search of the series that found a path know their distance to the target of that search 
+// (the path cost minus their own cost), other nodes keep the heuristic value they had. These
+// values are lowered by the distance the target moved since and replaced by the plain heuristic
+// value if that is larger. Before the next search is started, the values refer to the previous one.
+// Param1: The id of the node that is not visited yet during the current search.
+// Param2: The plain heuristic value of the node.
+// Returns the heuristic value to use for the node.
+//--------------------------------------------------------------------------------------
+float SearchContext::GetAdaptiveHeuristic(unsigned long id, float heuristicValue) const
+{
+	if(m_adaptiveFirstGeneration == 0 || id >= m_nodeData.size())
+	{
+		return heuristicValue;
+	}
+
+	const SearchNodeData& data = m_nodeData[id];
+
+	if(data.m_generation < m_adaptiveFirstGeneration || data.m_generation >= m_adaptiveFirstGeneration + m_adaptiveCorrections.size())
+	{
+		// The node was not visited during the current series
+		return heuristicValue;
+	}
+
+	unsigned int search = data.m_generation - m_adaptiveFirstGeneration;
+
+	float learnedValue = data.m_heuristicValue;
+
+	if(data.m_isClosed && m_adaptivePathCosts[search] != FLT_MAX)
+	{
+		learnedValue = m_adaptivePathCosts[search] - data.m_movementCost;
+	}
+
+	learnedValue -= m_adaptiveCorrections.back() - m_adaptiveCorrections[search];
+
+	return std::max(learnedValue, heuristicValue);
+}
+
+//--------------------------------------------------------------------------------------
+// Tells whether the last search of this context was an adaptive search, whose learned
+// heuristic values can be used by the next adaptive search.
+// Param1: The current obstacle version of the test environment.
+// Returns true if there are learned heuristic values that are valid for the obstacles, false otherwise.
+//--------------------------------------------------------------------------------------
+bool SearchContext::HasLearnedHeuristic(unsigned int obstacleVersion) const
+{
+	return m_adaptiveFirstGeneration != 0 && m_adaptiveObstacleVersion == obstacleVersion &&
+		   m_generation == m_adaptiveFirstGeneration + m_adaptiveCorrections.size() - 1;
+}
+
+//--------------------------------------------------------------------------------------
+// Tells whether a node was visited (opened) during the current search.
+// Param1: The id of the node to check.
+// Returns true if the node is either open or closed, false otherwise.
+//--------------------------------------------------------------------------------------
+bool SearchContext::IsVisited(unsigned long id) const
+{
+	return m_nodeData[id].m_generation == m_generation;
+}
+
+//--------------------------------------------------------------------------------------
+// Tells whether a node is currently on the open list.
+// Param1: The id of the node to check.
+// Returns true if the node is open, false otherwise.
+//--------------------------------------------------------------------------------------
+bool SearchContext::IsOpen(unsigned long id) const
+{
+	return IsVisited(id) && !m_nodeData[id].m_isClosed;
+}
+
+//--------------------------------------------------------------------------------------
+// Tells whether a node was already expanded during the current search.
+// Param1: The id of the node to check.
+// Returns true if the node is closed, false otherwise.
+//--------------------------------------------------------------------------------------
+bool SearchContext::IsClosed(unsigned long id) const
+{
+	return IsVisited(id) && m_nodeData[id].m_isClosed;
+}
+
+//--------------------------------------------------------------------------------------
+// Adds a node that was not visited yet during the current search to the open list.
+// Param1: The id of the node to open.
+// Param2: The id of the parent node, pass the id of the node itself for the start node.
+// Param3: The cost of the path from the start node to this node.
+// Param4: The heuristic estimate of the cost from this node to the target.
+//--------------------------------------------------------------------------------------
+void SearchContext::Open(unsigned long id, unsigned long parentId, float movementCost, float heuristicValue)
+{
+	SearchNodeData& data = m_nodeData[id];
+
+	data.m_parentId       = parentId;
+	data.m_movementCost   = movementCost;
+	data.m_heuristicValue = heuristicValue;
+	data.m_generation     = m_generation;
+	data.m_isClosed       = false;
+
+	m_openList.Push(id);
+
+	++m_queryStatistics.m_nodesTouched;
+
+	if(m_openList.GetSize() > m_queryStatistics.m_openListPeak)
+	{
+		m_queryStatistics.m_openListPeak = m_openList.GetSize();
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Updates an open node after a cheaper path to it was found.
+// Param1: The id of the open node.
+// Param2: The id of the new parent node.
+// Param3: The new, lower cost of the path from the start node to this node.
+//--------------------------------------------------------------------------------------
+void SearchContext::UpdateParent(unsigned long id, unsigned long parentId, float movementCost)
+{
+	m_nodeData[id].m_parentId     = parentId;
+	m_nodeData[id].m_movementCost = movementCost;
+
+	m_openList.DecreaseKey(id);
+}
+
+//--------------------------------------------------------------------------------------
+// Looks up the node with the smallest total estimate on the open list without closing it.
+// The open list must not be empty.
+// Returns the id of the node.
+//--------------------------------------------------------------------------------------
+unsigned long SearchContext::GetBest(void) const
+{
+	return m_openList.Top();
+}
+
+//--------------------------------------------------------------------------------------
+// Replaces the heuristic value of an open node. The open list has to be reordered by calling
+// ReorderOpenList once all heuristic values were replaced.
+// Param1: The id of the open node.
+// Param2: The new estimate of the cost from the node to the target.
+//--------------------------------------------------------------------------------------
+void SearchContext::SetHeuristicValue(unsigned long id, float heuristicValue)
+{
+	m_nodeData[id].m_heuristicValue = heuristicValue;
+}
+
+//--------------------------------------------------------------------------------------
+// Restores the order of the open list after the heuristic values of open nodes were replaced.
+//--------------------------------------------------------------------------------------
+void SearchContext::ReorderOpenList(void)
+{
+	m_openList.Rebuild();
+}
+
+//--------------------------------------------------------------------------------------
+// Removes the node with the smallest total estimate from the open list and closes it.
+// The open list must not be empty.
+// Returns the id of the closed node.
+//--------------------------------------------------------------------------------------
+unsigned long SearchContext::CloseBest(void)
+{
+	unsigned long id = m_openList.Pop();
+	m_nodeData[id].m_isClosed = true;
+
+	++m_queryStatistics.m_nodesExpanded;
+
+	return id;
+}
+
+//--------------------------------------------------------------------------------------
+// Prepares the statistics record for a new query. Unlike the node data, the record is not
+// reset by BeginSearch, as a single query can consist of several searches (e.g. HPA* or
+// cooperative searches completing their path beyond the reservation window).
+//--------------------------------------------------------------------------------------
+void SearchContext::ResetQueryStatistics(void)
+{
+	m_queryStatistics			   = PathQueryStatistics();
+	m_queryStatistics.m_pCallerTag = m_pCallerTag;
+	m_isQueryTimerRunning		   = false;
+
+	if(m_pBackwardContext)
+	{
+		m_pBackwardContext->ResetQueryStatistics();
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Adds the nodes visited by the backward half of a bidirectional search to the statistics
+// of the current query.
+//--------------------------------------------------------------------------------------
+void SearchContext::MergeBackwardQueryStatistics(void)
+{
+	if(!m_pBackwardContext)
+	{
+		return;
+	}
+
+	PathQueryStatistics& backwardStatistics = m_pBackwardContext->m_queryStatistics;
+
+	m_queryStatistics.m_nodesExpanded += backwardStatistics.m_nodesExpanded;
+	m_queryStatistics.m_nodesTouched  += backwardStatistics.m_nodesTouched;
+
+	// Both open lists are held at the same time
+	m_queryStatistics.m_openListPeak += backwardStatistics.m_openListPeak;
+
+	backwardStatistics = PathQueryStatistics();
+}
+
+//--------------------------------------------------------------------------------------
+// Starts measuring the time spent on a slice of the current query.
+// Param1: The current time in nanoseconds.
+//--------------------------------------------------------------------------------------
+void SearchContext::StartQueryTimer(unsigned long long time)
+{
+	m_queryTimerStart	  = time;
+	m_isQueryTimerRunning = true;
+}
+
+//--------------------------------------------------------------------------------------
+// Adds the time spent since the timer was started to the wall time of the current query.
+// Does nothing if the timer is not running.
+// Param1: The current time in nanoseconds.
+//--------------------------------------------------------------------------------------
+void SearchContext::StopQueryTimer(unsigned long long time)
+{
+	if(m_isQueryTimerRunning)
+	{
+		m_queryStatistics.m_wallTime += time - m_queryTimerStart;
+		m_isQueryTimerRunning		  = false;
+	}
+}
+
+// Data access functions
+
+const SearchNodeData& SearchContext::GetNodeData(unsigned long id) const
+{
+	return m_nodeData[id];
+}
+
+bool SearchContext::IsOpenListEmpty(void) const
+{
+	return m_openList.IsEmpty();
+}
+
+unsigned int SearchContext::GetOpenListSize(void) const
+{
+	return m_openList.GetSize();
+}
+
+unsigned long SearchContext::GetOpenNode(unsigned int index) const
+{
+	return m_openList.GetNode(index);
+}
+
+SearchContext& SearchContext::GetBackwardContext(void)
+{
+	if(!m_pBackwardContext)
+	{
+		// Allocated once, later bidirectional searches reuse its scratch data
+		m_pBackwardContext = new SearchContext();
+	}
+
+	return *m_pBackwardContext;
+}
+
+PendingSearch& SearchContext::GetPendingSearch(void)
+{
+	return m_pendingSearch;
+}
+
+bool SearchContext::IsAdaptiveSearch(void) const
+{
+	return m_isAdaptiveSearch;
+}
+
+unsigned long SearchContext::GetAdaptiveTargetId(void) const
+{
+	return m_adaptiveTargetId;
+}
+
+PathQueryStatistics& SearchContext::GetQueryStatistics(void)
+{
+	return m_queryStatistics;
+}
+
+const char* SearchContext::GetCallerTag(void) const
+{
+	return m_pCallerTag;
+}
+
+void SearchContext::SetCallerTag(const char* pCallerTag)
+{
+	m_pCallerTag = pCallerTag;
+}
@@ -0,0 +1,91 @@
+/* 
+*  Kevin Meergans, SquadAI, 2014
+*  SearchContext.h
+*  Holds the scratch data of path searches, such as the open list and the costs
+*  associated to the visited nodes. Keeping this data separate from the node graph
+*  allows several searches to run at the same time on the same graph, as long as 
+*  each of them uses its own search context. A search context can be reused for any
+*  number of consecutive searches. Consecutive adaptive searches learn improved heuristic
+*  values from the data left behind by the previous ones (moving target adaptive A*).
+*/
+
+#ifndef SEARCH_CONTEXT_H
+#define SEARCH_CONTEXT_H
+
+// Includes
+#include <vector>
+#include "PathfindingData.h"
+#include "NodeHeap.h"
+
+class SearchContext
+{
+public:
+	SearchContext(void);
+	~SearchContext(void);
+
+	void BeginSearch(unsigned int numberOfNodes);
+	void BeginAdaptiveSearch(unsigned int numberOfNodes, unsigned long targetId, unsigned int obstacleVersion, float targetHeuristicValue);
+	void EndAdaptiveSearch(float pathCost);
+
+	bool IsVisited(unsigned long id) const;
+	bool IsOpen(unsigned long id) const;
+	bool IsClosed(unsigned long id) const;
+
+	void		  Open(unsigned long id, unsigned long parentId, float movementCost, float heuristicValue);
+	void		  UpdateParent(unsigned long id, unsigned long parentId, float movementCost);
+	unsigned long CloseBest(void);
+	unsigned long GetBest(void) const;
+	void		  SetHeuristicValue(unsigned long id, float heuristicValue);
+	void		  ReorderOpenList(void);
+
+	float GetAdaptiveHeuristic(unsigned long id, float heuristicValue) const;
+	bool  HasLearnedHeuristic(unsigned int obstacleVersion) const;
+
+	void ResetQueryStatistics(void);
+	void MergeBackwardQueryStatistics(void);
+	void StartQueryTimer(unsigned long long time);
+	void StopQueryTimer(unsigned long long time);
+
+	// Data access functions
+
+	const SearchNodeData& GetNodeData(unsigned long id) const;
+	bool				  IsOpenListEmpty(void) const;
+	unsigned int		  GetOpenListSize(void) const;
+	unsigned long		  GetOpenNode(unsigned int index) const;
+	SearchContext&		  GetBackwardContext(void);
+	PendingSearch&		  GetPendingSearch(void);
+	bool				  IsAdaptiveSearch(void) const;
+	unsigned long		  GetAdaptiveTargetId(void) const;
+	PathQueryStatistics&  GetQueryStatistics(void);
+	const char*			  GetCallerTag(void) const;
+
+	void SetCallerTag(const char* pCallerTag);
+
+private:
+	// Contexts own their scratch data, prevent copies
+	SearchContext(const SearchContext&);
+	SearchContext& operator=(const SearchContext&);
+
+	std::vector<SearchNodeData> m_nodeData;		 // The search data of all nodes of the graph, indexed by node id
+	NodeHeap					m_openList;		 // The nodes that were visited but not expanded yet
+	unsigned int				m_generation;	 // Incremented with every search, node data not stamped with the current generation is outdated
+	PendingSearch				m_pendingSearch; // The parameters of the time-sliced search currently using this context, if any
+
+	// Moving target adaptive A*
+	std::vector<float> m_adaptivePathCosts;		  // The cost of the path found by each search of the current series of adaptive searches, FLT_MAX if none was found
+	std::vector<float> m_adaptiveCorrections;	  // The accumulated amount, by which the learned heuristic values have to be lowered for each search of the series as the target moved
+	unsigned int	   m_adaptiveFirstGeneration; // The generation of the first search of the current series of adaptive searches, 0 if there is none
+	unsigned long	   m_adaptiveTargetId;		  // The id of the target node of the last adaptive search
+	unsigned int	   m_adaptiveObstacleVersion; // The obstacle version of the test environment the learned heuristic values are valid for
+	bool			   m_isAdaptiveSearch;		  // Tells whether the current search is an adaptive search
+
+	SearchContext* m_pBackwardContext; // Holds the scratch data of the backward half of bidirectional searches, created on first use
+
+	// Instrumentation
+	const char*			m_pCallerTag;		   // Identifies the behaviour action or manoeuvre issuing the queries run with this context
+	PathQueryStatistics m_queryStatistics;	   // The statistics of the current or last query run with this context
+	unsigned long long	m_queryTimerStart;	   // The time in nanoseconds, at which the current slice of the query started
+	bool				m_isQueryTimerRunning; // Tells whether a slice of the query is being measured
+};
+
+#endif // SEARCH_CONTEXT_H
@@ -95,14 +95,16 @@ BehaviourStatus SimpleBaseAttack::Initiate(void)
 	{
 		Order* pNewOrder = nullptr;
 
-		// Randomly send out medium and high priority move orders to ensure some diversity and randomness
+		// Randomly send out medium and high priority move orders to ensure some diversity and randomness.
+		// The paths lead from base to base, bidirectional A* avoids the wide frontier a one-sided search
+		// builds up near the target.
 
 		if(rand() % 2 == 0)
 		{
-			pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, target);
+			pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, MediumPriority, target, 0.0f, BidirectionalAStar);
 		}else
 		{
-			pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, HighPriority, target);
+			pNewOrder = new MoveOrder((*it)->GetId(), MoveToPositionOrder, HighPriority, target, 0.0f, BidirectionalAStar);
 		}
 			
 		if(!pNewOrder)
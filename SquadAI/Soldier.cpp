@@ -57,7 +57,18 @@ bool Soldier::Initialise(unsigned long id, const XMFLOAT2& position, float rotat
 //--------------------------------------------------------------------------------------
 BehaviourStatus Soldier::MoveToTarget(float deltaTime)
 {
-	if(m_movementManager.FollowPath(GetPath(), m_soldierProperties.m_targetReachedRadius, m_soldierProperties.m_maxSpeed))
+	bool targetReached = false;
+
+	if(GetFlowField())
+	{
+		// Heading for a strategic target, follow the shared flow field leading there
+		targetReached = m_movementManager.FollowPath(GetFlowField(), GetMovementTarget(), m_soldierProperties.m_targetReachedRadius, m_soldierProperties.m_maxSpeed);
+	}else
+	{
+		targetReached = m_movementManager.FollowPath(GetPath(), m_soldierProperties.m_targetReachedRadius, m_soldierProperties.m_maxSpeed, deltaTime);
+	}
+
+	if(targetReached)
 	{
 		// The target was reached
 		if(GetGreatestSuspectedThreat() && GetGreatestSuspectedThreat()->m_lastKnownPosition.x == GetMovementTarget().x &&
@@ -154,6 +165,8 @@ BehaviourStatus Soldier::DetermineMovementTarget(float deltaTime)
 	// Reset movement target
 	SetMovementTarget(XMFLOAT2(0.0f, 0.0f));
 	SetMovementTargetSet(false);
+	SetPathSuboptimality(0.0f);
+	SetPathfindingAlgorithm(AdaptiveAStar);
 
 	if(GetCurrentOrder())
 	{
@@ -166,22 +179,30 @@ BehaviourStatus Soldier::DetermineMovementTarget(float deltaTime)
 			{
 				SetMovementTarget(reinterpret_cast<DefendOrder*>(GetCurrentOrder())->GetDefendPosition());
 				SetMovementTargetSet(true);
+				m_movementManager.SetSearchCallerTag("Defend Position Order");
 			}
 		}else if(GetCurrentOrder()->GetOrderType() == MoveToPositionOrder)
 		{
 			SetMovementTarget(reinterpret_cast<MoveOrder*>(GetCurrentOrder())->GetTargetPosition());
 			SetMovementTargetSet(true);
+			m_movementManager.SetSearchCallerTag("Move To Position Order");
+			SetPathSuboptimality(reinterpret_cast<MoveOrder*>(GetCurrentOrder())->GetPathSuboptimality());
+			SetPathfindingAlgorithm(reinterpret_cast<MoveOrder*>(GetCurrentOrder())->GetPathfindingAlgorithm());
 		}
 	}else
 	{
 		// If there is no order, just pick a random target position within the test environment to patrol
 		XMFLOAT2 patrolTarget(0.0f, 0.0f);
-		if(GetTestEnvironment()->GetRandomUnblockedTarget(patrolTarget))
+		if(GetTestEnvironment()->GetRandomUnblockedTarget(GetPosition(), patrolTarget))
 		{
 			m_movementManager.Reset();
 
 			SetMovementTarget(patrolTarget);
 			SetMovementTargetSet(true);
+			m_movementManager.SetSearchCallerTag("Patrol");
+
+			// Patrolling is not urgent, a somewhat longer path is fine if it is found faster
+			SetPathSuboptimality(g_kPatrolPathSuboptimality);
 		}else
 		{
 			SetMovementTargetSet(false);
@@ -207,6 +228,9 @@ BehaviourStatus Soldier::DetermineApproachThreatTarget(float deltaTime)
 
 		SetMovementTarget(GetGreatestSuspectedThreat()->m_lastKnownPosition);
 		SetMovementTargetSet(true);
+		m_movementManager.SetSearchCallerTag("Approach Threat");
+		SetPathSuboptimality(0.0f);
+		SetPathfindingAlgorithm(AdaptiveAStar);
 	}else
 	{
 		SetMovementTargetSet(false);
@@ -376,17 +400,17 @@ BehaviourStatus Soldier::DeterminePathToTarget(float deltaTime)
 		{
 			// Use the path provided by the team AI
 			SetPath(reinterpret_cast<MoveOrder*>(GetCurrentOrder())->GetPath());
+			SetFlowField(nullptr);
 			// If the path was started before, resume it.
 			m_movementManager.SetCurrentNode(GetResumePathNode());
-		}else
+		}else if(DeterminePathOrFlowField() == StatusRunning)
 		{
-			// Let the soldier find a path himself.
-			SetPath(m_movementManager.CreatePathTo(GetMovementTarget()));
-			m_movementManager.SetCurrentNode(0);
+			// Let the soldier find a path himself, the search is not completed yet.
+			return StatusRunning;
 		}
 
 		// If there is no path to the target of the order, notify the team AI that the current order cannot be completed.
-		if(!GetPath())
+		if(!IsPathSet())
 		{
 			UpdateOrderStateMessageData data(GetId(), FailedOrderState);
 			SendMessage(GetTeamAI(), UpdateOrderStateMessageType, &data);
@@ -394,13 +418,50 @@ BehaviourStatus Soldier::DeterminePathToTarget(float deltaTime)
 	}else
 	{
 		// Let the soldier find a path himself.
-		SetPath(m_movementManager.CreatePathTo(GetMovementTarget()));
-		m_movementManager.SetCurrentNode(0);
+		return DeterminePathOrFlowField();
 	}
 	
 	return StatusSuccess;
 }
 
+//--------------------------------------------------------------------------------------
+// Sets up the movement to the current movement target. Strategic targets are approached by
+// following the flow field leading there, a path is calculated for all other targets. The
+// path search is time-sliced, it only expands as many nodes as the share of the per-frame
+// budget of the test environment allows.
+// Returns StatusRunning while the path search is not completed, StatusSuccess otherwise. The
+// path is not set if there is no path to the target.
+//--------------------------------------------------------------------------------------
+BehaviourStatus Soldier::DeterminePathOrFlowField(void)
+{
+	const FlowField* pFlowField = m_movementManager.GetFlowFieldTo(GetMovementTarget());
+
+	if(pFlowField)
+	{
+		SetFlowField(pFlowField);
+		SetPath(nullptr);
+		m_movementManager.SetCurrentNode(0);
+		return StatusSuccess;
+	}
+
+	std::vector<XMFLOAT2>* pPath = nullptr;
+
+	unsigned int expansionBudget = GetTestEnvironment()->AcquirePathExpansions();
+	PathSearchStatus status = m_movementManager.RequestPathTo(GetMovementTarget(), GetPathfindingAlgorithm(), GetPathSuboptimality(), expansionBudget, pPath);
+	GetTestEnvironment()->ReleasePathExpansions(expansionBudget);
+
+	SetFlowField(nullptr);
+	SetPath(pPath);
+
+	if(status == SearchPending)
+	{
+		return StatusRunning;
+	}
+
+	m_movementManager.SetCurrentNode(0);
+	return StatusSuccess;
+}
+
 //--------------------------------------------------------------------------------------
 // Determines a point to observe for the soldier and sets it as the active observation point.
 // Param1: The time in seconds passed since the last frame.
@@ -149,6 +149,7 @@ protected:
 	void ProcessMessage(Message* pMessage);
 
 private:
+	BehaviourStatus DeterminePathOrFlowField(void);
 
 	// Soldier components
 	EntityMovementManager m_movementManager;   // The movement manager used by this soldier
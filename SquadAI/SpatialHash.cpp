@@ -0,0 +1,211 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  SpatialHash.cpp
+*  A uniform grid of buckets covering the test environment, each bucket holds the objects
+*  positioned within it. Proximity queries only visit the buckets overlapping the query circle
+*  instead of checking every object. The objects are kept in intrusive lists, moving an object
+*  to another bucket relinks it in constant time and without allocating memory.
+*/
+
+// Includes
+#include "SpatialHash.h"
+
+SpatialHash::SpatialHash(void) : m_numberOfBuckets(0),
+								 m_bucketSize(0.0f),
+								 m_worldSize(0.0f)
+{
+}
+
+SpatialHash::~SpatialHash(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Initialises the spatial hash for an environment and removes all objects from it.
+// Param1: The size of the environment along x and y axis, it is centred on the origin.
+// Param2: The size of a bucket along x and y axis.
+//--------------------------------------------------------------------------------------
+void SpatialHash::Initialise(float worldSize, float bucketSize)
+{
+	m_worldSize		  = worldSize;
+	m_bucketSize	  = bucketSize;
+	m_numberOfBuckets = static_cast<unsigned int>(worldSize / bucketSize);
+
+	if(m_numberOfBuckets * bucketSize < worldSize)
+	{
+		++m_numberOfBuckets;
+	}
+
+	if(m_numberOfBuckets == 0)
+	{
+		m_numberOfBuckets = 1;
+	}
+
+	Clear();
+}
+
+//--------------------------------------------------------------------------------------
+// Removes all objects from the spatial hash.
+//--------------------------------------------------------------------------------------
+void SpatialHash::Clear(void)
+{
+	m_buckets.assign(m_numberOfBuckets * m_numberOfBuckets, g_kNoSpatialHashEntry);
+	m_entries.clear();
+	m_entryIndices.clear();
+}
+
+//--------------------------------------------------------------------------------------
+// Adds an object to the bucket containing its current position.
+// Param1: The object to add, it has to have a valid and unique id.
+//--------------------------------------------------------------------------------------
+void SpatialHash::Insert(CollidableObject* pObject)
+{
+	if(pObject->GetId() >= m_entryIndices.size())
+	{
+		m_entryIndices.resize(pObject->GetId() + 1, g_kNoSpatialHashEntry);
+	}
+
+	if(m_entryIndices[pObject->GetId()] != g_kNoSpatialHashEntry)
+	{
+		// The object was added before
+		Update(pObject);
+		return;
+	}
+
+	m_entryIndices[pObject->GetId()] = m_entries.size();
+
+	m_entries.push_back(SpatialHashEntry());
+	m_entries.back().m_pObject = pObject;
+
+	Link(m_entries.size() - 1, GetBucketCoordinate(pObject->GetPosition().x) * m_numberOfBuckets + GetBucketCoordinate(pObject->GetPosition().y));
+}
+
+//--------------------------------------------------------------------------------------
+// Moves an object to the bucket containing its current position, to be called whenever
+// the position of the object changes. Objects that were not added are ignored.
+// Param1: The object that moved.
+//--------------------------------------------------------------------------------------
+void SpatialHash::Update(const CollidableObject* pObject)
+{
+	if(pObject->GetId() >= m_entryIndices.size() || m_entryIndices[pObject->GetId()] == g_kNoSpatialHashEntry)
+	{
+		return;
+	}
+
+	unsigned int entry  = m_entryIndices[pObject->GetId()];
+	unsigned int bucket = GetBucketCoordinate(pObject->GetPosition().x) * m_numberOfBuckets + GetBucketCoordinate(pObject->GetPosition().y);
+
+	// Most moves stay within the current bucket
+	if(m_entries[entry].m_bucket != bucket)
+	{
+		Unlink(entry);
+		Link(entry, bucket);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the buckets overlapping the bounding square of a circle.
+// Param1: The centre of the circle.
+// Param2: The radius of the circle.
+// Param3: Will hold the x coordinate of the first overlapping bucket.
+// Param4: Will hold the y coordinate of the first overlapping bucket.
+// Param5: Will hold the x coordinate of the last overlapping bucket.
+// Param6: Will hold the y coordinate of the last overlapping bucket.
+//--------------------------------------------------------------------------------------
+void SpatialHash::GetBucketRange(const XMFLOAT2& position, float radius, unsigned int& startX, unsigned int& startY, unsigned int& endX, unsigned int& endY) const
+{
+	startX = GetBucketCoordinate(position.x - radius);
+	startY = GetBucketCoordinate(position.y - radius);
+	endX   = GetBucketCoordinate(position.x + radius);
+	endY   = GetBucketCoordinate(position.y + radius);
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the bucket coordinate along one axis for a world coordinate, positions outside
+// of the environment are assigned to the buckets at its border.
+// Param1: The world coordinate.
+// Returns the bucket coordinate.
+//--------------------------------------------------------------------------------------
+unsigned int SpatialHash::GetBucketCoordinate(float worldCoordinate) const
+{
+	float coordinate = (worldCoordinate + m_worldSize * 0.5f) / m_bucketSize;
+
+	if(coordinate <= 0.0f)
+	{
+		return 0;
+	}
+
+	if(coordinate >= static_cast<float>(m_numberOfBuckets - 1))
+	{
+		return m_numberOfBuckets - 1;
+	}
+
+	return static_cast<unsigned int>(coordinate);
+}
+
+//--------------------------------------------------------------------------------------
+// Adds an entry to the front of the list of a bucket.
+// Param1: The index of the entry.
+// Param2: The index of the bucket.
+//--------------------------------------------------------------------------------------
+void SpatialHash::Link(unsigned int entry, unsigned int bucket)
+{
+	m_entries[entry].m_bucket   = bucket;
+	m_entries[entry].m_previous = g_kNoSpatialHashEntry;
+	m_entries[entry].m_next		= m_buckets[bucket];
+
+	if(m_buckets[bucket] != g_kNoSpatialHashEntry)
+	{
+		m_entries[m_buckets[bucket]].m_previous = entry;
+	}
+
+	m_buckets[bucket] = entry;
+}
+
+//--------------------------------------------------------------------------------------
+// Removes an entry from the list of its bucket.
+// Param1: The index of the entry.
+//--------------------------------------------------------------------------------------
+void SpatialHash::Unlink(unsigned int entry)
+{
+	SpatialHashEntry& current = m_entries[entry];
+
+	if(current.m_previous != g_kNoSpatialHashEntry)
+	{
+		m_entries[current.m_previous].m_next = current.m_next;
+	}else
+	{
+		m_buckets[current.m_bucket] = current.m_next;
+	}
+
+	if(current.m_next != g_kNoSpatialHashEntry)
+	{
+		m_entries[current.m_next].m_previous = current.m_previous;
+	}
+
+	current.m_next	   = g_kNoSpatialHashEntry;
+	current.m_previous = g_kNoSpatialHashEntry;
+}
+
+// Data access functions
+
+const SpatialHashEntry* SpatialHash::GetFirstEntry(unsigned int bucketX, unsigned int bucketY) const
+{
+	unsigned int entry = m_buckets[bucketX * m_numberOfBuckets + bucketY];
+	return (entry != g_kNoSpatialHashEntry) ? &m_entries[entry] : nullptr;
+}
+
+const SpatialHashEntry* SpatialHash::GetNextEntry(const SpatialHashEntry* pEntry) const
+{
+	return (pEntry->m_next != g_kNoSpatialHashEntry) ? &m_entries[pEntry->m_next] : nullptr;
+}
+
+unsigned int SpatialHash::GetNumberOfBuckets(void) const
+{
+	return m_numberOfBuckets;
+}
+
+float SpatialHash::GetBucketSize(void) const
+{
+	return m_bucketSize;
+}
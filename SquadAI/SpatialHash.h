@@ -0,0 +1,74 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  SpatialHash.h
+*  A uniform grid of buckets covering the test environment, each bucket holds the objects
+*  positioned within it. Proximity queries only visit the buckets overlapping the query circle
+*  instead of checking every object. The objects are kept in intrusive lists, moving an object
+*  to another bucket relinks it in constant time and without allocating memory.
+*/
+
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+// Includes
+#include <DirectXMath.h>
+#include <vector>
+#include "CollidableObject.h"
+
+using namespace DirectX;
+
+// Marks the end of a bucket list or an object that is not part of the hash
+const unsigned int g_kNoSpatialHashEntry = 0xffffffff;
+
+//--------------------------------------------------------------------------------------
+// An object held by the spatial hash and its links within the list of its bucket.
+//--------------------------------------------------------------------------------------
+struct SpatialHashEntry
+{
+	SpatialHashEntry(void) : m_pObject(nullptr),
+							 m_bucket(0),
+							 m_next(g_kNoSpatialHashEntry),
+							 m_previous(g_kNoSpatialHashEntry)
+	{}
+
+	CollidableObject* m_pObject;  // The object
+	unsigned int	  m_bucket;	  // The index of the bucket the object is currently in
+	unsigned int	  m_next;	  // The index of the next entry in the same bucket
+	unsigned int	  m_previous; // The index of the previous entry in the same bucket
+};
+
+class SpatialHash
+{
+public:
+	SpatialHash(void);
+	~SpatialHash(void);
+
+	void Initialise(float worldSize, float bucketSize);
+	void Clear(void);
+
+	void Insert(CollidableObject* pObject);
+	void Update(const CollidableObject* pObject);
+
+	void GetBucketRange(const XMFLOAT2& position, float radius, unsigned int& startX, unsigned int& startY, unsigned int& endX, unsigned int& endY) const;
+
+	// Data access functions
+
+	const SpatialHashEntry* GetFirstEntry(unsigned int bucketX, unsigned int bucketY) const;
+	const SpatialHashEntry* GetNextEntry(const SpatialHashEntry* pEntry) const;
+	unsigned int			GetNumberOfBuckets(void) const;
+	float					GetBucketSize(void) const;
+
+private:
+	unsigned int GetBucketCoordinate(float worldCoordinate) const;
+	void		 Link(unsigned int entry, unsigned int bucket);
+	void		 Unlink(unsigned int entry);
+
+	std::vector<unsigned int>	  m_buckets;		  // The index of the first entry of each bucket, indexed by bucket x * number of buckets + bucket y
+	std::vector<SpatialHashEntry> m_entries;		  // The objects held by the hash
+	std::vector<unsigned int>	  m_entryIndices;	  // The index of the entry of each object, indexed by object id
+	unsigned int				  m_numberOfBuckets;  // The number of buckets along x and y axis
+	float						  m_bucketSize;		  // The size of a bucket along x and y axis
+	float						  m_worldSize;		  // The size of the covered area along x and y axis, centred on the origin
+};
+
+#endif // SPATIAL_HASH_H
@@ -77,7 +77,9 @@ bool TeamAI::InitialiseManoeuvres(void)
 //--------------------------------------------------------------------------------------
 void TeamAI::PrepareForSimulation(void)
 {
-	// Do nothing. Default implementation
+	// A time step of the reservations lasts as long as it takes a soldier to cross a grid field
+	m_reservationTable.Initialise(m_pTestEnvironment->GetNumberOfGridPartitions() * m_pTestEnvironment->GetNumberOfGridPartitions(), g_kReservationWindow,
+								  m_pTestEnvironment->GetGridSpacing() / g_kSoldierMaxSpeed);
 }
 
 //--------------------------------------------------------------------------------------
@@ -92,6 +94,9 @@ void TeamAI::Update(float deltaTime)
 		return;
 	}
 
+	// Let the reservations of past time steps expire
+	m_reservationTable.Advance(deltaTime);
+
 	m_pBehaviour->Tick(deltaTime);
 }
 
@@ -330,6 +335,51 @@ void TeamAI::ReleaseEntityFromManoeuvre(unsigned long entityId)
 	}
 }
 
+//--------------------------------------------------------------------------------------
+// Calculates a path for a team member that avoids the paths planned cooperatively for the
+// other team members earlier, and reserves the grid fields along the new path.
+// Param1: A pointer to the entity, for which to calculate the path.
+// Param2: The target position of the path.
+// Param3: A vector that will hold the path, the entity has to wait for a time step wherever a node
+//         is repeated. Empty if no cooperative path was calculated.
+// Param4: Names the caller of the search in the pathfinding statistics.
+// Returns true if a path was calculated, false if cooperative pathfinding is disabled or the
+// reservations of the other team members block all ways.
+//--------------------------------------------------------------------------------------
+bool TeamAI::CalculateCooperativePath(const Entity* pEntity, const XMFLOAT2& targetPosition, std::vector<XMFLOAT2>& path, const char* pCallerTag)
+{
+	path.clear();
+
+	if(!g_kUseCooperativePathfinding || !pEntity)
+	{
+		return false;
+	}
+
+	// The new path replaces the old one of the entity
+	m_reservationTable.Release(pEntity->GetId());
+
+	m_cooperativeSearchContext.SetCallerTag(pCallerTag);
+
+	if(!m_pTestEnvironment->GetPathfinder().CalculateCooperativePath(pEntity->GetId(), pEntity->GetPosition(), targetPosition, m_reservationTable, path, m_cooperativeSearchContext))
+	{
+		path.clear();
+		return false;
+	}
+
+	// Reserve the field occupied at each time step, the entity stays at the end of a short path
+	unsigned int lastIndex = static_cast<unsigned int>(path.size()) - 1;
+
+	for(unsigned int step = 0; step < m_reservationTable.GetWindow(); ++step)
+	{
+		XMFLOAT2 gridPosition;
+		m_pTestEnvironment->WorldToGridPosition(path[std::min(step, lastIndex)], gridPosition);
+
+		m_reservationTable.Reserve(static_cast<unsigned long>(gridPosition.x) * m_pTestEnvironment->GetNumberOfGridPartitions() + static_cast<unsigned long>(gridPosition.y), step, pEntity->GetId());
+	}
+
+	return true;
+}
+
 //--------------------------------------------------------------------------------------
 // Puts an entity under the control of the team AI.
 // Param1: A pointer to the entity that should be put under the control of the team AI.
@@ -381,6 +431,8 @@ void TeamAI::Reset(void)
 	
 	m_timeLeft = 1.0f;
 
+	m_reservationTable.Clear();
+
 	// Clear team members
 	m_teamMembers.clear();
 
@@ -450,6 +502,11 @@ float TeamAI::GetTimeLeft(void) const
 	return m_timeLeft;
 }
 
+SearchContext& TeamAI::GetSearchContext(void)
+{
+	return m_searchContext;
+}
+
 void TeamAI::SetTeam(EntityTeam team)
 {
 	m_team = team;
@@ -23,6 +23,8 @@
 #include "Behaviour.h"
 #include "Order.h"
 #include "TeamManoeuvre.h"
+#include "SearchContext.h"
+#include "ReservationTable.h"
 
 using namespace DirectX;
 
@@ -81,6 +83,7 @@ public:
 	virtual void			ActivateManoeuvre(TeamManoeuvreType manoeuvre);
 	virtual void			RegisterObjective(Objective* pObjective) = 0;
 	void					ReleaseEntityFromManoeuvre(unsigned long entityId);
+	bool					CalculateCooperativePath(const Entity* pEntity, const XMFLOAT2& targetPosition, std::vector<XMFLOAT2>& path, const char* pCallerTag);
 
 
 	// Data access functions
@@ -93,6 +96,7 @@ public:
 	const std::unordered_map<unsigned long, std::set<unsigned long>>&	GetSpottedEnemies(void) const;
 	float																GetScore(EntityTeam team) const;
 	float																GetTimeLeft(void) const;
+	SearchContext&														GetSearchContext(void);
 	
 	void SetTeam(EntityTeam team);
 	void SetCharacteristic(TeamAICharacteristic characteristic);
@@ -118,6 +122,9 @@ private:
 	TestEnvironment*								m_pTestEnvironment;        // The environment, in which the current match plays
 	float											m_scores[NumberOfTeams-1]; // The current score for each team as a percentual value in relation to the score required for victory
 	float											m_timeLeft;                // The time left as a percentual value in relation to the maximal time a round can last
+	SearchContext									m_searchContext;		   // Used by the team AI and its manoeuvres to compare the path costs of team members and targets
+	SearchContext									m_cooperativeSearchContext; // Used for the cooperative paths, kept apart as the space-time searches cover many more nodes than the grid
+	ReservationTable								m_reservationTable;		   // The grid fields reserved by the cooperatively planned paths of the team members
 
 };
 
@@ -236,6 +236,33 @@ const char* TeamManoeuvre::GetManoeuvreNameFromType(TeamManoeuvreType type)
 	case RunTheFlagHomeManoeuvre:
 		return "Run The Flag Home";
 		break;
+	case ReturnDroppedFlagManoeuvre:
+		return "Return Dropped Flag";
+		break;
+	case CoordinatedBaseAttackManoeuvre:
+		return "Coordinated Base Attack";
+		break;
+	case DistractionBaseAttackManoeuvre:
+		return "Distraction Base Attack";
+		break;
+	case SimpleBaseAttackManoeuvre:
+		return "Simple Base Attack";
+		break;
+	case PickUpDroppedFlagManoeuvre:
+		return "Pick Up Dropped Flag";
+		break;
+	case SimpleBaseDefenceManoeuvre:
+		return "Simple Base Defence";
+		break;
+	case ActiveBaseDefenceManoeuvre:
+		return "Active Base Defence";
+		break;
+	case InterceptFlagCarrierManoeuvre:
+		return "Intercept Flag Carrier";
+		break;
+	case GuardedFlagCaptureManoeuvre:
+		return "Guarded Flag Capture";
+		break;
 	default:
 		return "";
 	}
@@ -15,7 +15,13 @@ TestEnvironment::TestEnvironment(void) : m_id(0),
 										 m_gridSize(0.0f),
 										 m_numberOfGridPartitions(0),
 										 m_gridSpacing(0.0f),
-										 m_pNodes(nullptr)
+										 m_pNodeStorage(nullptr),
+										 m_pNodeProperties(nullptr),
+										 m_pNodes(nullptr),
+										 m_obstacleVersion(0),
+										 m_pathExpansionsLeft(g_kPathExpansionsPerFrame),
+										 m_pathSearchesThisFrame(0),
+										 m_pathSearchesLastFrame(0)
 {
 	for(unsigned int i = 0; i < NumberOfObjectTypes; ++i)
 	{
@@ -110,6 +116,8 @@ bool TestEnvironment::Initialise(float gridSize, unsigned int numberOfGridPartit
 	// Initialise the random number generator.
 	srand(static_cast<unsigned int>(time(NULL)));
 
+	m_soldierHash.Initialise(m_gridSize, g_kSpatialHashBucketSize);
+
 	return InitialiseGrid() && m_pathfinder.Initialise(this);
 }
 
@@ -152,6 +160,17 @@ void TestEnvironment::Update(RenderContext& pRenderContext, float deltaTime)
 
 		// Update soldiers
 
+		// Renew the node expansion budget shared by the path searches of the soldiers
+		m_pathExpansionsLeft	= g_kPathExpansionsPerFrame;
+		m_pathSearchesLastFrame = m_pathSearchesThisFrame;
+		m_pathSearchesThisFrame = 0;
+
+		// Determine the enemies each soldier might see, only these are tested for line of sight by the sensors
+		if(g_kUseBatchedFieldOfViewTest && !m_pGameContext->IsTerminated() && !m_isPaused)
+		{
+			m_fieldOfViewCandidates.Update(m_soldiers, g_kSoldiersPerTeam * (NumberOfTeams-1));
+		}
+
 		for(unsigned int i = 0; i < g_kSoldiersPerTeam * (NumberOfTeams-1); ++i)
 		{
 			
@@ -527,8 +546,34 @@ bool TestEnvironment::PrepareSimulation(void)
 		}
 	}
 
+	// Sort the soldiers into the buckets of the spatial hash
+	m_soldierHash.Clear();
+
+	for(int i = 0; i < soldierIndex; ++i)
+	{
+		m_soldierHash.Insert(&m_soldiers[i]);
+	}
+
 	UpdateNodeGraph();
 
+	// Rebuild the clusters affected by changes to the obstacles since the last simulation
+	m_clusterGraph.Update(m_pathfinder);
+
+	// Rebuild the flow fields leading to the strategic targets
+	UpdateFlowFields();
+
+	// Recalculate the landmark distances if the obstacles changed
+	m_landmarkTable.Update(m_pathfinder);
+
+	// Rebuild the rectangles of the navigation mesh if the obstacles changed
+	m_navigationMesh.Update();
+
+	// Rebuild the line of sight between the grid fields around changed obstacles
+	if(g_kUseVisibilityTable)
+	{
+		m_visibilityTable.Update();
+	}
+
 	// Prepare the team AIs for simulation.
 	for(unsigned int i = 0; i < NumberOfTeams-1; ++i)
 	{
@@ -666,6 +711,14 @@ bool TestEnvironment::AddObject(ObjectType type, const XMFLOAT2& position, float
 		case BlueAttackPositionType:
 			++m_attackPositionsCount[TeamBlue];
 			break;
+		case ObstacleType:
+			// The entrances and distances of the clusters around the obstacle change
+			m_clusterGraph.Invalidate(static_cast<unsigned int>(gridPosition.x), static_cast<unsigned int>(gridPosition.y));
+			// The line of sight between the grid fields around the obstacle changes
+			m_visibilityTable.Invalidate(static_cast<unsigned int>(gridPosition.x), static_cast<unsigned int>(gridPosition.y));
+			// Cached paths might cross the obstacle or miss a shorter route, the navigation mesh is rebuilt on the next update
+			++m_obstacleVersion;
+			break;
 		}
 	}
 
@@ -735,6 +788,14 @@ bool TestEnvironment::RemoveObjects(const XMFLOAT2& position)
 		case BlueAttackPositionType:
 			--m_attackPositionsCount[TeamBlue];
 			break;
+		case ObstacleType:
+			// The entrances and distances of the clusters around the obstacle change
+			m_clusterGraph.Invalidate(static_cast<unsigned int>(gridPosition.x), static_cast<unsigned int>(gridPosition.y));
+			// The line of sight between the grid fields around the obstacle changes
+			m_visibilityTable.Invalidate(static_cast<unsigned int>(gridPosition.x), static_cast<unsigned int>(gridPosition.y));
+			// Cached paths might cross the obstacle or miss a shorter route, the navigation mesh is rebuilt on the next update
+			++m_obstacleVersion;
+			break;
 		}
 
 	}
@@ -930,57 +991,129 @@ void TestEnvironment::GetNearbyObjects(const XMFLOAT2& position, float radius, E
  
 	if(entityGroup != GroupObstacles) 
 	{
-		if(entityGroup == GroupTeamRed || entityGroup == GroupTeamRedAndObstacles)
+		// Only check the soldiers in the buckets overlapping the query circle
+		unsigned int startX, startY, endX, endY;
+		m_soldierHash.GetBucketRange(position, radius, startX, startY, endX, endY);
+
+		for(unsigned int i = startX; i <= endX; ++i)
 		{
-			// Check all soldiers
-			for(unsigned int i = 0; i < g_kSoldiersPerTeam * (NumberOfTeams-1); ++i)
+			for(unsigned int k = startY; k <= endY; ++k)
 			{
-				if(m_soldiers[i].GetTeam() == TeamRed && m_soldiers[i].IsAlive())
+				for(const SpatialHashEntry* pEntry = m_soldierHash.GetFirstEntry(i, k); pEntry != nullptr; pEntry = m_soldierHash.GetNextEntry(pEntry))
 				{
-					XMStoreFloat(&squareDistance, XMVector2LengthSq(XMLoadFloat2(&m_soldiers[i].GetPosition()) - XMLoadFloat2(&position)));
+					Entity* pSoldier = static_cast<Entity*>(pEntry->m_pObject);
+
+					if(!pSoldier->IsAlive())
+					{
+						continue;
+					}
+
+					if((entityGroup == GroupTeamRed || entityGroup == GroupTeamRedAndObstacles) && pSoldier->GetTeam() != TeamRed)
+					{
+						continue;
+					}
+
+					if((entityGroup == GroupTeamBlue || entityGroup == GroupTeamBlueAndObstacles) && pSoldier->GetTeam() != TeamBlue)
+					{
+						continue;
+					}
+
+					XMStoreFloat(&squareDistance, XMVector2LengthSq(XMLoadFloat2(&pSoldier->GetPosition()) - XMLoadFloat2(&position)));
 					if(squareDistance <= squareRadius)
 					{
-						collisionObjects.insert(std::pair<float, CollidableObject*>(squareDistance,(&(m_soldiers[i]))));
+						collisionObjects.insert(std::pair<float, CollidableObject*>(squareDistance, pSoldier));
 					}
 				}
 			}
-		}else if(entityGroup == GroupTeamBlue || entityGroup == GroupTeamBlueAndObstacles)
+		}
+	}
+
+	if(entityGroup == GroupObstacles || entityGroup == GroupTeamRedAndObstacles || entityGroup == GroupTeamBlueAndObstacles || entityGroup == GroupAllSoldiersAndObstacles)
+	{
+		// Only check nearby obstacles for collision
+		unsigned int maxGridDistance = static_cast<unsigned int>(radius / m_gridSpacing) + 1;
+
+		// Get the current grid position of the entity
+		XMFLOAT2 gridPos;
+		WorldToGridPosition(position, gridPos);
+
+		unsigned int startX = (gridPos.x > maxGridDistance) ? (static_cast<int>(gridPos.x) - maxGridDistance) : 0;
+		unsigned int startY = (gridPos.y > maxGridDistance) ? (static_cast<int>(gridPos.y) - maxGridDistance) : 0;
+		unsigned int endX = (gridPos.x + maxGridDistance < m_numberOfGridPartitions) ? (static_cast<int>(gridPos.x) + maxGridDistance) : (m_numberOfGridPartitions - 1);
+		unsigned int endY = (gridPos.y + maxGridDistance < m_numberOfGridPartitions) ? (static_cast<int>(gridPos.y) + maxGridDistance) : (m_numberOfGridPartitions - 1);
+
+		// Check the grid within that distance for colliding obstacles
+		for(unsigned int i = startX; i <= endX; ++i)
 		{
-			// Check all soldiers
-			for(unsigned int i = 0; i < g_kSoldiersPerTeam * (NumberOfTeams-1); ++i)
+			for(unsigned int k = startY; k <= endY; ++k)
 			{
-				if(m_soldiers[i].GetTeam() == TeamBlue && m_soldiers[i].IsAlive())
+				if(m_pNodes[i][k].IsObstacle())
 				{
-					XMStoreFloat(&squareDistance, XMVector2LengthSq(XMLoadFloat2(&m_soldiers[i].GetPosition()) - XMLoadFloat2(&position)));
+					int a = i;
+					int b = k;
+
+					XMStoreFloat(&squareDistance, XMVector2LengthSq(XMLoadFloat2(&m_pNodes[i][k].GetObstacle()->GetPosition()) - XMLoadFloat2(&position)));
 					if(squareDistance <= squareRadius)
 					{
-						collisionObjects.insert(std::pair<float, CollidableObject*>(squareDistance,(&(m_soldiers[i]))));
+						collisionObjects.insert(std::pair<float, CollidableObject*>(squareDistance, m_pNodes[i][k].GetObstacle()));
 					}
 				}
 			}
-		}else
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the objects passing a filter that are within a specified circle-shaped area
+// around a given position. This checks against the centres of the objects. Unlike the
+// version above, this does not allocate any memory and does not sort the results.
+// Param1: The centre of the circle area.
+// Param2: The radius of the circle area.
+// Param3: Specifies which objects will be checked and returned.
+// Param4: The buffer that will hold the objects positioned within the radius along with their
+//         square distance to the centre, it is cleared first.
+//--------------------------------------------------------------------------------------
+void TestEnvironment::GetNearbyObjects(const XMFLOAT2& position, float radius, const NearbyObjectsFilter& filter, NearbyObjects& nearbyObjects)
+{
+	float squareRadius = radius * radius;
+	float squareDistance = 0.0f;
+
+	nearbyObjects.Clear();
+
+	if(filter.m_includeEntities)
+	{
+		// Only check the soldiers in the buckets overlapping the query circle
+		unsigned int startX, startY, endX, endY;
+		m_soldierHash.GetBucketRange(position, radius, startX, startY, endX, endY);
+
+		for(unsigned int i = startX; i <= endX; ++i)
 		{
-			// Check all soldiers
-			for(unsigned int i = 0; i < g_kSoldiersPerTeam * (NumberOfTeams-1); ++i)
+			for(unsigned int k = startY; k <= endY; ++k)
 			{
-				if(m_soldiers[i].IsAlive())
+				for(const SpatialHashEntry* pEntry = m_soldierHash.GetFirstEntry(i, k); pEntry != nullptr; pEntry = m_soldierHash.GetNextEntry(pEntry))
 				{
-					XMStoreFloat(&squareDistance, XMVector2LengthSq(XMLoadFloat2(&m_soldiers[i].GetPosition()) - XMLoadFloat2(&position)));
+					Entity* pSoldier = static_cast<Entity*>(pEntry->m_pObject);
+
+					if((filter.m_isAliveOnly && !pSoldier->IsAlive()) || (filter.m_team != None && pSoldier->GetTeam() != filter.m_team) || pSoldier->GetId() == filter.m_excludedId)
+					{
+						continue;
+					}
+
+					XMStoreFloat(&squareDistance, XMVector2LengthSq(XMLoadFloat2(&pSoldier->GetPosition()) - XMLoadFloat2(&position)));
 					if(squareDistance <= squareRadius)
 					{
-						collisionObjects.insert(std::pair<float, CollidableObject*>(squareDistance,(&(m_soldiers[i]))));
+						nearbyObjects.Add(pSoldier, squareDistance);
 					}
 				}
 			}
 		}
 	}
 
-	if(entityGroup == GroupObstacles || entityGroup == GroupTeamRedAndObstacles || entityGroup == GroupTeamBlueAndObstacles || entityGroup == GroupAllSoldiersAndObstacles)
+	if(filter.m_includeObstacles)
 	{
-		// Only check nearby obstacles for collision
+		// Only check nearby obstacles
 		unsigned int maxGridDistance = static_cast<unsigned int>(radius / m_gridSpacing) + 1;
 
-		// Get the current grid position of the entity
 		XMFLOAT2 gridPos;
 		WorldToGridPosition(position, gridPos);
 
@@ -989,20 +1122,16 @@ void TestEnvironment::GetNearbyObjects(const XMFLOAT2& position, float radius, E
 		unsigned int endX = (gridPos.x + maxGridDistance < m_numberOfGridPartitions) ? (static_cast<int>(gridPos.x) + maxGridDistance) : (m_numberOfGridPartitions - 1);
 		unsigned int endY = (gridPos.y + maxGridDistance < m_numberOfGridPartitions) ? (static_cast<int>(gridPos.y) + maxGridDistance) : (m_numberOfGridPartitions - 1);
 
-		// Check the grid within that distance for colliding obstacles
 		for(unsigned int i = startX; i <= endX; ++i)
 		{
 			for(unsigned int k = startY; k <= endY; ++k)
 			{
-				if(m_pNodes[i][k].IsObstacle())
+				if(m_pNodes[i][k].IsObstacle() && m_pNodes[i][k].GetObstacle()->GetId() != filter.m_excludedId)
 				{
-					int a = i;
-					int b = k;
-
 					XMStoreFloat(&squareDistance, XMVector2LengthSq(XMLoadFloat2(&m_pNodes[i][k].GetObstacle()->GetPosition()) - XMLoadFloat2(&position)));
 					if(squareDistance <= squareRadius)
 					{
-						collisionObjects.insert(std::pair<float, CollidableObject*>(squareDistance, m_pNodes[i][k].GetObstacle()));
+						nearbyObjects.Add(m_pNodes[i][k].GetObstacle(), squareDistance);
 					}
 				}
 			}
@@ -1010,14 +1139,85 @@ void TestEnvironment::GetNearbyObjects(const XMFLOAT2& position, float radius, E
 	}
 }
 
+//--------------------------------------------------------------------------------------
+// Determines the enemies that were within viewing range and field of view of a soldier at
+// the start of the frame. These are the candidates for the line of sight test of the sensors.
+// Param1: The observing soldier.
+// Param2: The buffer that will hold the candidates along with their current square distance
+//         to the observer, it is cleared first.
+// Param3: Will tell whether any living enemy was within viewing range, in or out of the field of view.
+// Returns true if the candidates were determined, false if the batched test is disabled or
+// the observer was not part of it. The caller has to test range and field of view itself then.
+//--------------------------------------------------------------------------------------
+bool TestEnvironment::GetFieldOfViewCandidates(const Entity* pObserver, NearbyObjects& candidates, bool& areEnemiesInRange)
+{
+	candidates.Clear();
+	areEnemiesInRange = false;
+
+	if(!g_kUseBatchedFieldOfViewTest)
+	{
+		return false;
+	}
+
+	unsigned int observer = m_fieldOfViewCandidates.GetObserverIndex(pObserver->GetId());
+
+	if(observer == g_kNoFieldOfViewObserver)
+	{
+		return false;
+	}
+
+	const unsigned int* pWords = m_fieldOfViewCandidates.GetCandidates(observer);
+	float squareDistance = 0.0f;
+
+	areEnemiesInRange = m_fieldOfViewCandidates.AreEnemiesInRange(observer);
+
+	for(unsigned int word = 0; word < m_fieldOfViewCandidates.GetNumberOfWords(); ++word)
+	{
+		unsigned int bits = pWords[word];
+
+		for(unsigned int target = word * 32; bits != 0; ++target, bits >>= 1)
+		{
+			if(bits & 1)
+			{
+				XMStoreFloat(&squareDistance, XMVector2LengthSq(XMLoadFloat2(&m_soldiers[target].GetPosition()) - XMLoadFloat2(&pObserver->GetPosition())));
+				candidates.Add(&m_soldiers[target], squareDistance);
+			}
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Moves an entity to the bucket of the spatial hash containing its current position, to be
+// called whenever the position of the entity changes.
+// Param1: The entity that moved.
+//--------------------------------------------------------------------------------------
+void TestEnvironment::UpdateEntityPosition(const Entity* pEntity)
+{
+	m_soldierHash.Update(pEntity);
+}
+
 //--------------------------------------------------------------------------------------
 // Randomly determines a position within the test environment that is not occupied by
-// an obstacle.
-// Param1: Out paramter that will hold the randomly determined target position.
+// an obstacle and can be reached from a given position.
+// Param1: The position, from which the target has to be reachable (usually the position of the caller).
+// Param2: Out paramter that will hold the randomly determined target position.
 // Returns true if a position was found false otherwise.
 //--------------------------------------------------------------------------------------
-bool TestEnvironment::GetRandomUnblockedTarget(XMFLOAT2& outPosition) const
+bool TestEnvironment::GetRandomUnblockedTarget(const XMFLOAT2& reachableFrom, XMFLOAT2& outPosition) const
 {
+	unsigned int component = GetComponentAt(reachableFrom);
+
+	if(component != g_kNoComponent)
+	{
+		// Pick one of the nodes of the component directly, rand() alone does not cover large grids
+		unsigned int index = (static_cast<unsigned int>(rand()) * (RAND_MAX + 1u) + static_cast<unsigned int>(rand())) % m_connectedComponents.GetComponentSize(component);
+		outPosition = GetNodeById(m_connectedComponents.GetComponentNode(component, index))->GetWorldPosition();
+
+		return true;
+	}
+
 	if(m_obstacles.size() >= m_numberOfGridPartitions * m_numberOfGridPartitions)
 	{
 		return false;
@@ -1039,14 +1239,18 @@ bool TestEnvironment::GetRandomUnblockedTarget(XMFLOAT2& outPosition) const
 
 //--------------------------------------------------------------------------------------
 // Randomly determines a position within a certain area of the test environment that is 
-// not occupied by an obstacle. 
+// not occupied by an obstacle and can be reached from a given position. 
 // Param1: The centre of the area, in which the random position should lie.
 // Param2: Radius around the centre of the area, in which the result position will lie.
-// Param3: Out paramter that will hold the randomly determined target position.
+// Param3: The position, from which the target has to be reachable (usually the position of the entity
+//         that will move to it).
+// Param4: Out paramter that will hold the randomly determined target position.
 // Returns true if a position was found false otherwise.
 //--------------------------------------------------------------------------------------
-bool TestEnvironment::GetRandomUnblockedTargetInArea(const XMFLOAT2& centre, float radius, XMFLOAT2& outPosition) const
+bool TestEnvironment::GetRandomUnblockedTargetInArea(const XMFLOAT2& centre, float radius, const XMFLOAT2& reachableFrom, XMFLOAT2& outPosition) const
 {
+	unsigned int component = GetComponentAt(reachableFrom);
+
 	XMFLOAT2 centreGridPos(0.0f, 0.0f);
 	WorldToGridPosition(centre, centreGridPos);
 
@@ -1070,7 +1274,7 @@ bool TestEnvironment::GetRandomUnblockedTargetInArea(const XMFLOAT2& centre, flo
 		x = startX + rand() % (endX - startX);
 		y = startY + rand() % (endY - startY);
 		++tryCount;
-	}while(m_pNodes[x][y].IsObstacle() && tryCount < maxTries);
+	}while((m_pNodes[x][y].IsObstacle() || (component != g_kNoComponent && m_connectedComponents.GetComponent(m_pNodes[x][y].GetId()) != component)) && tryCount < maxTries);
 	
 	GridToWorldPosition(XMFLOAT2(static_cast<float>(x), static_cast<float>(y)), outPosition);
 	
@@ -1277,7 +1481,7 @@ Direction TestEnvironment::GetAttackDirectionFromRotation(float rotation)
 // Param4: The y-coordinate of the end grid field in grid units.
 // Returns true if a direct line of sight exists, false if an obstacle obstructs the view.
 //--------------------------------------------------------------------------------------
-bool TestEnvironment::CheckLineOfSightGrid(int startGridX, int startGridY, int endGridX, int endGridY)
+bool TestEnvironment::CheckLineOfSightGrid(int startGridX, int startGridY, int endGridX, int endGridY) const
 {
 	// Prepare the coordinates for the calculation according to the properties of the line 
 	// connecting drawn between them.
@@ -1326,6 +1530,71 @@ bool TestEnvironment::CheckLineOfSightGrid(int startGridX, int startGridY, int e
 	return true;
 }
 
+//--------------------------------------------------------------------------------------
+// Determines whether an entity can move along a straight line between the centres of two
+// fields on the grid. Unlike CheckLineOfSightGrid, every field the line crosses is visited.
+// Where the line passes through the corner of a field, both fields beside the corner have to
+// be free, just like for diagonal moves between adjacent fields. The line thus neither squeezes
+// between two obstacles touching at their corners nor cuts the corner of an obstacle.
+// Param1: The x-coordinate of the start grid field in grid units.
+// Param2: The y-coordinate of the start grid field in grid units.
+// Param3: The x-coordinate of the end grid field in grid units.
+// Param4: The y-coordinate of the end grid field in grid units.
+// Returns true if the line only touches free fields, false if it touches an obstacle.
+//--------------------------------------------------------------------------------------
+bool TestEnvironment::CheckStraightPathGrid(int startGridX, int startGridY, int endGridX, int endGridY) const
+{
+	int deltaX = std::abs(endGridX - startGridX);
+	int deltaY = std::abs(endGridY - startGridY);
+	int stepX  = (endGridX > startGridX) ? 1 : -1;
+	int stepY  = (endGridY > startGridY) ? 1 : -1;
+	int x	   = startGridX;
+	int y	   = startGridY;
+	int movesX = 0;
+	int movesY = 0;
+
+	if(m_pNodes[x][y].IsObstacle())
+	{
+		return false;
+	}
+
+	while(movesX < deltaX || movesY < deltaY)
+	{
+		// The line leaves the current field through its vertical border at the line parameter (movesX + 0.5) / deltaX and
+		// through its horizontal border at (movesY + 0.5) / deltaY. Both are compared without division, the test is exact.
+		int comparison = (2 * movesX + 1) * deltaY - (2 * movesY + 1) * deltaX;
+
+		if(comparison == 0)
+		{
+			// The line passes through the corner and touches the fields on both sides of it
+			if(m_pNodes[x + stepX][y].IsObstacle() || m_pNodes[x][y + stepY].IsObstacle())
+			{
+				return false;
+			}
+
+			x += stepX;
+			y += stepY;
+			++movesX;
+			++movesY;
+		}else if(comparison < 0)
+		{
+			x += stepX;
+			++movesX;
+		}else
+		{
+			y += stepY;
+			++movesY;
+		}
+
+		if(m_pNodes[x][y].IsObstacle())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 //--------------------------------------------------------------------------------------
 // Determines whether there is a direct line of sight between two points.
 // Param1: The start position of the line.
@@ -1390,6 +1659,151 @@ bool TestEnvironment::CheckLineOfSight(const XMFLOAT2& start, const XMFLOAT2& en
 	return true;
 }
 
+//--------------------------------------------------------------------------------------
+// Determines whether there is a direct line of sight between two points. Walks along the
+// line from one grid field to the next (Amanatides-Woo traversal) and only tests the obstacles
+// on the fields the line actually crosses, stopping at the first one blocking it. As touching
+// an obstacle counts as collision, the fields that the line only touches are tested as well.
+// These are the fields beside a corner the line passes through, the fields beside a border
+// the line runs along and the fields around end points lying on a border.
+// Param1: The start position of the line.
+// Param2: The end position of the line.
+// Returns true if a direct line of sight exists, false if an obstacle obstructs the view.
+//--------------------------------------------------------------------------------------
+bool TestEnvironment::CheckLineOfSightTraversal(const XMFLOAT2& start, const XMFLOAT2& end)
+{
+	XMFLOAT2 startGridPos;
+	XMFLOAT2 endGridPos;
+	WorldToGridPosition(start, startGridPos);
+	WorldToGridPosition(end, endGridPos);
+
+	if(startGridPos.x < 0.0f || endGridPos.x < 0.0f)
+	{
+		// The line leaves the grid
+		return CheckLineOfSight(start, end);
+	}
+
+	// Positions closer than this to a border (in grid units) count as lying on it
+	const float borderTolerance = 1e-4f;
+
+	// The end points of the line in grid units
+	float pointsX[2] = {(start.x + m_gridSize * 0.5f) / m_gridSpacing, (end.x + m_gridSize * 0.5f) / m_gridSpacing};
+	float pointsY[2] = {(start.y + m_gridSize * 0.5f) / m_gridSpacing, (end.y + m_gridSize * 0.5f) / m_gridSpacing};
+	int	  fieldsX[2] = {static_cast<int>(startGridPos.x), static_cast<int>(endGridPos.x)};
+	int	  fieldsY[2] = {static_cast<int>(startGridPos.y), static_cast<int>(endGridPos.y)};
+	int	  sidesX[2];
+	int	  sidesY[2];
+
+	// End points on a border also touch the fields on the other side of it
+	for(unsigned int i = 0; i < 2; ++i)
+	{
+		sidesX[i] = (pointsX[i] - fieldsX[i] <= borderTolerance) ? -1 : ((fieldsX[i] + 1 - pointsX[i] <= borderTolerance) ? 1 : 0);
+		sidesY[i] = (pointsY[i] - fieldsY[i] <= borderTolerance) ? -1 : ((fieldsY[i] + 1 - pointsY[i] <= borderTolerance) ? 1 : 0);
+
+		if((sidesX[i] != 0 && IsLineBlockedByObstacle(fieldsX[i] + sidesX[i], fieldsY[i], start, end)) ||
+		   (sidesY[i] != 0 && IsLineBlockedByObstacle(fieldsX[i], fieldsY[i] + sidesY[i], start, end)) ||
+		   (sidesX[i] != 0 && sidesY[i] != 0 && IsLineBlockedByObstacle(fieldsX[i] + sidesX[i], fieldsY[i] + sidesY[i], start, end)))
+		{
+			return false;
+		}
+	}
+
+	float deltaX = pointsX[1] - pointsX[0];
+	float deltaY = pointsY[1] - pointsY[0];
+
+	int x	  = fieldsX[0];
+	int y	  = fieldsY[0];
+	int stepX = (deltaX > 0.0f) ? 1 : ((deltaX < 0.0f) ? -1 : 0);
+	int stepY = (deltaY > 0.0f) ? 1 : ((deltaY < 0.0f) ? -1 : 0);
+
+	// A line parallel to an axis that runs along a border touches the fields on both sides of it
+	int borderSideX = (stepX == 0) ? sidesX[0] : 0;
+	int borderSideY = (stepY == 0) ? sidesY[0] : 0;
+
+	// The line parameter (0 at the start, 1 at the end), at which the line crosses the next vertical/horizontal border,
+	// and the increase of the parameter from one border to the next
+	float nextBorderX	  = (stepX != 0) ? ((stepX > 0) ? (x + 1 - pointsX[0]) / deltaX : (x - pointsX[0]) / deltaX) : std::numeric_limits<float>::max();
+	float nextBorderY	  = (stepY != 0) ? ((stepY > 0) ? (y + 1 - pointsY[0]) / deltaY : (y - pointsY[0]) / deltaY) : std::numeric_limits<float>::max();
+	float borderDistanceX = (stepX != 0) ? (stepX / deltaX) : std::numeric_limits<float>::max();
+	float borderDistanceY = (stepY != 0) ? (stepY / deltaY) : std::numeric_limits<float>::max();
+
+	for(;;)
+	{
+		if(IsLineBlockedByObstacle(x, y, start, end) ||
+		   (borderSideX != 0 && IsLineBlockedByObstacle(x + borderSideX, y, start, end)) ||
+		   (borderSideY != 0 && IsLineBlockedByObstacle(x, y + borderSideY, start, end)))
+		{
+			return false;
+		}
+
+		if((x == fieldsX[1] && y == fieldsY[1]) || (nextBorderX > 1.0f && nextBorderY > 1.0f))
+		{
+			break;
+		}
+
+		if(abs(nextBorderX - nextBorderY) <= borderTolerance * std::min(borderDistanceX, borderDistanceY))
+		{
+			// The line passes through a corner, it touches the fields on both sides of it
+			if(IsLineBlockedByObstacle(x + stepX, y, start, end) || IsLineBlockedByObstacle(x, y + stepY, start, end))
+			{
+				return false;
+			}
+
+			x += stepX;
+			y += stepY;
+			nextBorderX += borderDistanceX;
+			nextBorderY += borderDistanceY;
+		}else if(nextBorderX < nextBorderY)
+		{
+			x += stepX;
+			nextBorderX += borderDistanceX;
+		}else
+		{
+			y += stepY;
+			nextBorderY += borderDistanceY;
+		}
+
+		if(x < 0 || y < 0 || x >= static_cast<int>(m_numberOfGridPartitions) || y >= static_cast<int>(m_numberOfGridPartitions))
+		{
+			break;
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Checks whether one position can be seen from another one. When the visibility table is
+// used and tells that the grid fields of both positions are fully visible from each other,
+// no obstacle has to be tested, otherwise the line of sight is checked exactly.
+// Param1: The position of the observer.
+// Param2: The position to check the visibility of.
+// Returns true if a direct line of sight exists, false if an obstacle obstructs the view.
+//--------------------------------------------------------------------------------------
+bool TestEnvironment::CheckVisibility(const XMFLOAT2& start, const XMFLOAT2& end)
+{
+	if(g_kUseVisibilityTable)
+	{
+		XMFLOAT2 startGridPos;
+		XMFLOAT2 endGridPos;
+		WorldToGridPosition(start, startGridPos);
+		WorldToGridPosition(end, endGridPos);
+
+		if(startGridPos.x >= 0.0f && endGridPos.x >= 0.0f &&
+		   m_visibilityTable.IsFullyVisible(static_cast<unsigned int>(startGridPos.x), static_cast<unsigned int>(startGridPos.y), static_cast<unsigned int>(endGridPos.x), static_cast<unsigned int>(endGridPos.y)))
+		{
+			return true;
+		}
+	}
+
+	if(g_kUseGridTraversalLineOfSight)
+	{
+		return CheckLineOfSightTraversal(start, end);
+	}
+
+	return CheckLineOfSight(start, end);
+}
+
 //--------------------------------------------------------------------------------------
 // Resets the node graph as a preparation measure for the simulation.
 //--------------------------------------------------------------------------------------
@@ -1402,6 +1816,15 @@ void TestEnvironment::ResetNodeGraph(void)
 			m_pNodes[i][k].Reset();
 		}
 	}
+
+	// Without obstacles all moves within the grid are legal
+	for(unsigned int i = 0; i < m_numberOfGridPartitions; ++i)
+	{
+		for(unsigned int k = 0; k < m_numberOfGridPartitions; ++k)
+		{
+			m_pNodes[i][k].SetMoveMask(CalculateMoveMask(i, k));
+		}
+	}
 }
 
 //--------------------------------------------------------------------------------------
@@ -1419,6 +1842,35 @@ void TestEnvironment::AddDeadEntity(unsigned long id)
 	}
 }
 
+//--------------------------------------------------------------------------------------
+// Hands out a share of the node expansions available to time-sliced path searches during
+// the current frame. The budget is split evenly between the searches that were active during
+// the last frame, which bounds the time spent on pathfinding per frame regardless of the 
+// size of the test environment.
+// Returns the number of nodes the calling search may expand, can be zero if the budget of
+// the current frame is used up.
+//--------------------------------------------------------------------------------------
+unsigned int TestEnvironment::AcquirePathExpansions(void)
+{
+	++m_pathSearchesThisFrame;
+
+	unsigned int share = g_kPathExpansionsPerFrame / std::max(m_pathSearchesLastFrame, 1u);
+	share = std::min(std::max(share, g_kMinPathExpansionsPerSearch), m_pathExpansionsLeft);
+
+	m_pathExpansionsLeft -= share;
+
+	return share;
+}
+
+//--------------------------------------------------------------------------------------
+// Returns node expansions that a search did not need to the budget of the current frame.
+// Param1: The number of unused node expansions.
+//--------------------------------------------------------------------------------------
+void TestEnvironment::ReleasePathExpansions(unsigned int expansions)
+{
+	m_pathExpansionsLeft += expansions;
+}
+
 //--------------------------------------------------------------------------------------
 // Processes an event by writing it to a log file and/or updating the statistics for this
 // simulation. Simply forwards the calls to the logger object of the test environment.
@@ -1490,6 +1942,9 @@ bool TestEnvironment::StartSimulation(void)
 	m_isInEditMode = false;
 	m_isPaused = false;
 
+	m_pathfinder.GetPathCache().ResetStatistics();
+	m_pathfinder.GetStatistics().Reset();
+
 #ifdef DEBUG
 	m_logger.Open("Log.txt");
 #endif
@@ -1504,6 +1959,8 @@ bool TestEnvironment::StartSimulation(void)
 void TestEnvironment::EndSimulation(void)
 {
 #ifdef DEBUG
+	m_logger.LogEvent(PathCacheStatisticsLogEvent, &m_pathfinder.GetPathCache(), nullptr);
+	m_logger.LogEvent(PathfindingStatisticsLogEvent, &m_pathfinder.GetStatistics(), nullptr);
 	m_logger.Close();
 #endif
 
@@ -1511,6 +1968,8 @@ void TestEnvironment::EndSimulation(void)
 	m_projectiles.clear();
 	m_obstacles.clear();
 	m_deadEntities.clear();
+	m_soldierHash.Clear();
+	m_fieldOfViewCandidates.Clear();
 
 	// Reset game context
 
@@ -1562,23 +2021,20 @@ bool TestEnvironment::InitialiseGrid()
 {
 	m_gridSpacing = m_gridSize / static_cast<float>(m_numberOfGridPartitions);
 
-	// Initialise the nodes
+	// Initialise the nodes, all nodes are stored in one block, the rarely accessed data in another one
 
-	m_pNodes = new Node*[m_numberOfGridPartitions];
+	m_pNodeStorage	  = new Node[m_numberOfGridPartitions * m_numberOfGridPartitions];
+	m_pNodeProperties = new NodeProperties[m_numberOfGridPartitions * m_numberOfGridPartitions];
+	m_pNodes		  = new Node*[m_numberOfGridPartitions];
 
-	if(!m_pNodes)
+	if(!m_pNodeStorage || !m_pNodeProperties || !m_pNodes)
 	{
 		return false;
 	}
 
 	for(unsigned int i = 0; i < m_numberOfGridPartitions; ++i)
 	{
-		m_pNodes[i] = new Node[m_numberOfGridPartitions];
-		
-		if(!m_pNodes[i])
-		{
-			return false;
-		}
+		m_pNodes[i] = &m_pNodeStorage[i * m_numberOfGridPartitions];
 	}
 
 	// Initialise the nodes
@@ -1593,54 +2049,25 @@ bool TestEnvironment::InitialiseGrid()
 			GridToWorldPosition(gridPos, worldPos);
 
 			// Use the array position as node ID
-			m_pNodes[i][k].Initialise(i * m_numberOfGridPartitions + k, gridPos, worldPos, false);
+			m_pNodes[i][k].Initialise(i * m_numberOfGridPartitions + k, gridPos, worldPos, false, &m_pNodeProperties[i * m_numberOfGridPartitions + k]);
 		}
 	}
 
-	// Set up adjacency information for the nodes
+	// Set up the legal moves between adjacent nodes
 	for(unsigned int i = 0; i < m_numberOfGridPartitions; ++i)
 	{
 		for(unsigned int k = 0; k < m_numberOfGridPartitions; ++k)
 		{
-			if(i > 0)
-			{
-				m_pNodes[i][k].AddAdjacentNode(&m_pNodes[i-1][k]);
-				if(k > 0)
-				{
-					m_pNodes[i][k].AddAdjacentNode(&m_pNodes[i-1][k-1]);
-				}
-				if(k < m_numberOfGridPartitions-1)
-				{
-					m_pNodes[i][k].AddAdjacentNode(&m_pNodes[i-1][k+1]);
-				}
-			}
-
-			if(i < m_numberOfGridPartitions-1)
-			{
-				m_pNodes[i][k].AddAdjacentNode(&m_pNodes[i+1][k]);
-				if(k > 0)
-				{
-					m_pNodes[i][k].AddAdjacentNode(&m_pNodes[i+1][k-1]);
-				}
-				if(k < m_numberOfGridPartitions-1)
-				{
-					m_pNodes[i][k].AddAdjacentNode(&m_pNodes[i+1][k+1]);
-				}
-			}
-
-			if(k > 0)
-			{
-				m_pNodes[i][k].AddAdjacentNode(&m_pNodes[i][k-1]);
-			}
-
-			if(k < m_numberOfGridPartitions-1)
-			{
-				m_pNodes[i][k].AddAdjacentNode(&m_pNodes[i][k+1]);
-			}
+			m_pNodes[i][k].SetMoveMask(CalculateMoveMask(i, k));
 		}
 	}
 
-	return true;
+	// Paths cached for the old grid are no longer valid
+	++m_obstacleVersion;
+
+	// The cluster graph, the flow fields, the landmark distances, the component labels, the navigation mesh and the visibility table have to be built from scratch for the new grid
+	return m_clusterGraph.Initialise(this, g_kClusterSize) && m_flowFieldManager.Initialise(this) && m_landmarkTable.Initialise(this, g_kNumberOfLandmarks) &&
+		   m_connectedComponents.Initialise(this) && m_navigationMesh.Initialise(this) && m_visibilityTable.Initialise(this, g_kSoldierViewingDistance);
 }
 
 //--------------------------------------------------------------------------------------
@@ -1651,15 +2078,21 @@ void TestEnvironment::CleanupGrid()
 
 	if(m_pNodes)
 	{
-		for(unsigned int i = 0; i < m_numberOfGridPartitions; ++i)
-		{
-			delete[] m_pNodes[i];
-			m_pNodes[i] = nullptr;
-		}
-
 		delete[] m_pNodes;
 		m_pNodes = nullptr;
 	}
+
+	if(m_pNodeProperties)
+	{
+		delete[] m_pNodeProperties;
+		m_pNodeProperties = nullptr;
+	}
+
+	if(m_pNodeStorage)
+	{
+		delete[] m_pNodeStorage;
+		m_pNodeStorage = nullptr;
+	}
 }
 
 //--------------------------------------------------------------------------------------
@@ -1703,9 +2136,87 @@ void TestEnvironment::UpdateNodeGraph(void)
 	// Update base entrances
 	UpdateBaseEntrances();
 
+	// Label the connected components of the traversable nodes
+	m_connectedComponents.Update();
 }
 
 
+//--------------------------------------------------------------------------------------
+// Determines the connected component of the node graph a position belongs to.
+// Param1: The world position.
+// Returns the component of the grid field containing the position, g_kNoComponent if the position
+// lies outside of the grid or on an obstacle or if the component labels are outdated.
+//--------------------------------------------------------------------------------------
+unsigned int TestEnvironment::GetComponentAt(const XMFLOAT2& position) const
+{
+	if(!m_connectedComponents.IsUpToDate())
+	{
+		return g_kNoComponent;
+	}
+
+	XMFLOAT2 gridPosition(0.0f, 0.0f);
+	WorldToGridPosition(position, gridPosition);
+
+	if((gridPosition.x < 0) || (gridPosition.y < 0) ||
+	   (gridPosition.x >= m_numberOfGridPartitions) || (gridPosition.y >= m_numberOfGridPartitions))
+	{
+		return g_kNoComponent;
+	}
+
+	return m_connectedComponents.GetComponent(m_pNodes[static_cast<unsigned int>(gridPosition.x)][static_cast<unsigned int>(gridPosition.y)].GetId());
+}
+
+//--------------------------------------------------------------------------------------
+// Checks whether the obstacle on a grid field collides with a line.
+// Param1: The x-coordinate of the grid field.
+// Param2: The y-coordinate of the grid field.
+// Param3: The start position of the line.
+// Param4: The end position of the line.
+// Returns true if there is an obstacle on the field and the line touches it, false if the
+// field is free or lies outside of the grid.
+//--------------------------------------------------------------------------------------
+bool TestEnvironment::IsLineBlockedByObstacle(int gridX, int gridY, const XMFLOAT2& start, const XMFLOAT2& end)
+{
+	if(gridX < 0 || gridY < 0 || gridX >= static_cast<int>(m_numberOfGridPartitions) || gridY >= static_cast<int>(m_numberOfGridPartitions))
+	{
+		return false;
+	}
+
+	return m_pNodes[gridX][gridY].IsObstacle() && m_pNodes[gridX][gridY].GetObstacle()->GetCollider()->CheckLineCollision(start, end);
+}
+
+//--------------------------------------------------------------------------------------
+// Updates the flow fields leading to the flags, the base entrances and the attack positions
+// of both teams. Has to be called after the node graph was updated.
+//--------------------------------------------------------------------------------------
+void TestEnvironment::UpdateFlowFields(void)
+{
+	std::vector<XMFLOAT2> targetPositions;
+
+	for(std::vector<EditModeObject>::iterator it = m_staticObjects.begin(); it != m_staticObjects.end(); ++it)
+	{
+		if(it->GetType() == RedFlagType || it->GetType() == BlueFlagType)
+		{
+			targetPositions.push_back(it->GetPosition());
+		}
+	}
+
+	for(unsigned int i = 0; i < NumberOfTeams-1; ++i)
+	{
+		for(std::unordered_map<Direction, std::vector<XMFLOAT2>>::const_iterator it = m_baseEntrances[i].begin(); it != m_baseEntrances[i].end(); ++it)
+		{
+			targetPositions.insert(targetPositions.end(), it->second.begin(), it->second.end());
+		}
+
+		for(std::unordered_map<Direction, std::vector<XMFLOAT2>>::const_iterator it = m_attackPositions[i].begin(); it != m_attackPositions[i].end(); ++it)
+		{
+			targetPositions.insert(targetPositions.end(), it->second.begin(), it->second.end());
+		}
+	}
+
+	m_flowFieldManager.Update(targetPositions, m_pathfinder);
+}
+
 //--------------------------------------------------------------------------------------
 // Updates the nodes of the graph according to the new obstacle added to the environment.
 // Nodes next to the new obstacle node are registered as providing cover towards some
@@ -1728,6 +2239,9 @@ void TestEnvironment::UpdateCoverSpots(CollidableObject* obstacle)
 
 	m_pNodes[gridX][gridY].SetObstacle(obstacle);
 
+	// Moves onto the node and diagonal moves passing it are only legal if it is free
+	UpdateMoveMasks(gridX, gridY);
+
 	// Update the adjacent nodes with regard to the added/deleted cover spot
 
 	if(gridX > 0)
@@ -1767,6 +2281,68 @@ void TestEnvironment::UpdateCoverSpots(CollidableObject* obstacle)
 	}
 }
 
+//--------------------------------------------------------------------------------------
+// Recalculates the legal moves of a node and its adjacent nodes after the obstacle placed
+// on the node changed. These are the only nodes, whose moves lead onto the node or cut its corner.
+// Param1: The x coordinate of the node in grid space.
+// Param2: The y coordinate of the node in grid space.
+//--------------------------------------------------------------------------------------
+void TestEnvironment::UpdateMoveMasks(unsigned int gridX, unsigned int gridY)
+{
+	unsigned int minX = (gridX > 0) ? gridX - 1 : 0;
+	unsigned int minY = (gridY > 0) ? gridY - 1 : 0;
+	unsigned int maxX = std::min(gridX + 1, m_numberOfGridPartitions - 1);
+	unsigned int maxY = std::min(gridY + 1, m_numberOfGridPartitions - 1);
+
+	for(unsigned int i = minX; i <= maxX; ++i)
+	{
+		for(unsigned int k = minY; k <= maxY; ++k)
+		{
+			m_pNodes[i][k].SetMoveMask(CalculateMoveMask(i, k));
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the legal moves from a node to its adjacent nodes. A move is legal if the
+// adjacent node lies within the grid and is not blocked by an obstacle. Diagonal moves are
+// further required not to cut the corner of an obstacle.
+// Param1: The x coordinate of the node in grid space.
+// Param2: The y coordinate of the node in grid space.
+// Returns the move mask of the node, bit i is set if the move with the offsets g_kMoveOffsetX[i]
+// and g_kMoveOffsetY[i] is legal.
+//--------------------------------------------------------------------------------------
+unsigned char TestEnvironment::CalculateMoveMask(unsigned int gridX, unsigned int gridY) const
+{
+	unsigned char moveMask = 0;
+
+	for(unsigned int move = 0; move < g_kNumberOfMoves; ++move)
+	{
+		int adjacentX = static_cast<int>(gridX) + g_kMoveOffsetX[move];
+		int adjacentY = static_cast<int>(gridY) + g_kMoveOffsetY[move];
+
+		if(adjacentX < 0 || adjacentY < 0 || adjacentX >= static_cast<int>(m_numberOfGridPartitions) || adjacentY >= static_cast<int>(m_numberOfGridPartitions))
+		{
+			continue;
+		}
+
+		if(m_pNodes[adjacentX][adjacentY].IsObstacle())
+		{
+			continue;
+		}
+
+		if(g_kMoveOffsetX[move] != 0 && g_kMoveOffsetY[move] != 0 && (m_pNodes[adjacentX][gridY].IsObstacle() || m_pNodes[gridX][adjacentY].IsObstacle()))
+		{
+			// The diagonal move would cut the corner of an obstacle
+			continue;
+		}
+
+		moveMask |= (1 << move);
+	}
+
+	return moveMask;
+}
+
 //--------------------------------------------------------------------------------------
 // Updates the nodes of the graph according to the base territories and marks nodes that
 // are entrances into the territory of each team.
@@ -1970,7 +2546,47 @@ Pathfinder& TestEnvironment::GetPathfinder(void)
 	return m_pathfinder;
 }
 
+const ClusterGraph& TestEnvironment::GetClusterGraph(void) const
+{
+	return m_clusterGraph;
+}
+
+const FlowFieldManager& TestEnvironment::GetFlowFieldManager(void) const
+{
+	return m_flowFieldManager;
+}
+
+const LandmarkTable& TestEnvironment::GetLandmarkTable(void) const
+{
+	return m_landmarkTable;
+}
+
+const ConnectedComponents& TestEnvironment::GetConnectedComponents(void) const
+{
+	return m_connectedComponents;
+}
+
+const NavigationMesh& TestEnvironment::GetNavigationMesh(void) const
+{
+	return m_navigationMesh;
+}
+
+unsigned int TestEnvironment::GetObstacleVersion(void) const
+{
+	return m_obstacleVersion;
+}
+
 Node** TestEnvironment::GetNodes(void)
 {
 	return m_pNodes;
 }
+
+const Node* TestEnvironment::GetNode(unsigned int gridX, unsigned int gridY) const
+{
+	return &m_pNodeStorage[gridX * m_numberOfGridPartitions + gridY];
+}
+
+const Node* TestEnvironment::GetNodeById(unsigned long id) const
+{
+	return &m_pNodeStorage[id];
+}
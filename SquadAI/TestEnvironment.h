@@ -29,6 +29,15 @@
 #include "Projectile.h"
 #include "Node.h"
 #include "Pathfinder.h"
+#include "ClusterGraph.h"
+#include "FlowFieldManager.h"
+#include "LandmarkTable.h"
+#include "ConnectedComponents.h"
+#include "NavigationMesh.h"
+#include "SpatialHash.h"
+#include "NearbyObjects.h"
+#include "FieldOfViewCandidates.h"
+#include "VisibilityTable.h"
 #include "SoldierProperties.h"
 #include "CircleCollider.h"
 #include "AxisAlignedRectangleCollider.h"
@@ -71,16 +80,25 @@ public:
 	void GridToWorldPosition(const XMFLOAT2& gridPos, XMFLOAT2& worldPos) const;
 
 	void GetNearbyObjects(const XMFLOAT2& position, float radius, EntityGroup entityGroup, std::multimap<float, CollidableObject*>& collisionObjects);
-	bool GetRandomUnblockedTarget(XMFLOAT2& outPosition) const;
-	bool GetRandomUnblockedTargetInArea(const XMFLOAT2& centre, float radius, XMFLOAT2& outPosition) const;
-
-	bool CheckLineOfSightGrid(int startGridX, int startGridY, int endGridX, int endGridY);
+	void GetNearbyObjects(const XMFLOAT2& position, float radius, const NearbyObjectsFilter& filter, NearbyObjects& nearbyObjects);
+	bool GetFieldOfViewCandidates(const Entity* pObserver, NearbyObjects& candidates, bool& areEnemiesInRange);
+	void UpdateEntityPosition(const Entity* pEntity);
+	bool GetRandomUnblockedTarget(const XMFLOAT2& reachableFrom, XMFLOAT2& outPosition) const;
+	bool GetRandomUnblockedTargetInArea(const XMFLOAT2& centre, float radius, const XMFLOAT2& reachableFrom, XMFLOAT2& outPosition) const;
+
+	bool CheckLineOfSightGrid(int startGridX, int startGridY, int endGridX, int endGridY) const;
+	bool CheckStraightPathGrid(int startGridX, int startGridY, int endGridX, int endGridY) const;
 	bool CheckLineOfSight(const XMFLOAT2& start, const XMFLOAT2& end);
+	bool CheckLineOfSightTraversal(const XMFLOAT2& start, const XMFLOAT2& end);
+	bool CheckVisibility(const XMFLOAT2& start, const XMFLOAT2& end);
 	bool CheckCollision(const CollidableObject* pCollidableObject,  const XMFLOAT2& oldPosition, EntityGroup entityGroup, CollidableObject*& outCollisionObject);
 	
 	void ResetNodeGraph(void);
 	void ProcessEvent(EventType type, void* pEventData);
 
+	unsigned int AcquirePathExpansions(void);
+	void		 ReleasePathExpansions(unsigned int expansions);
+
 	void	   RecordEvent(LogEventType type, void* pObject1, void* pObject2);
 	bool	   IsBlocked(const XMFLOAT2 worldPos) const;
 	EntityTeam GetTerritoryOwner(const XMFLOAT2 worldPos) const;
@@ -92,7 +110,15 @@ public:
 	bool				IsPaused(void) const;
 	const GameContext*	GetGameContext(void) const;
 	Pathfinder&			GetPathfinder(void);
+	const ClusterGraph& GetClusterGraph(void) const;
+	const FlowFieldManager& GetFlowFieldManager(void) const;
+	const LandmarkTable& GetLandmarkTable(void) const;
+	const ConnectedComponents& GetConnectedComponents(void) const;
+	const NavigationMesh& GetNavigationMesh(void) const;
+	unsigned int		GetObstacleVersion(void) const;
 	Node**				GetNodes(void);
+	const Node*			GetNode(unsigned int gridX, unsigned int gridY) const;
+	const Node*			GetNodeById(unsigned long id) const;
 
 	const std::unordered_map<Direction, std::vector<XMFLOAT2>>& GetBaseEntrances(EntityTeam team) const;
 	const std::unordered_map<Direction, std::vector<XMFLOAT2>>& GetAttackPositions(EntityTeam team) const;
@@ -107,9 +133,14 @@ private:
 	bool InitialiseGrid(void);
 	void CleanupGrid(void);
 	void UpdateCoverSpots(CollidableObject* obstacle);
+	void UpdateMoveMasks(unsigned int gridX, unsigned int gridY);
+	unsigned char CalculateMoveMask(unsigned int gridX, unsigned int gridY) const;
 	void UpdateBaseEntrances(void);
 	void UpdateNodeGraph(void);
+	void UpdateFlowFields(void);
 	void UpdateRespawns(float deltaTime);
+	unsigned int GetComponentAt(const XMFLOAT2& position) const;
+	bool IsLineBlockedByObstacle(int gridX, int gridY, const XMFLOAT2& start, const XMFLOAT2& end);
 
 	Direction GetAttackDirectionFromRotation(float rotation);
 
@@ -128,7 +159,9 @@ private:
 	float			m_gridSize;					// The size of the grid along x and y axis
 	unsigned int	m_numberOfGridPartitions;	// The number of grid fields along x and y axis
 	float			m_gridSpacing;				// The size of a grid field along x and y axis
-	Node**			m_pNodes;					// The graph made up of nodes representing the test environment when in simulation mode
+	Node*			m_pNodeStorage;				// The graph made up of nodes representing the test environment when in simulation mode, one contiguous array indexed by node id
+	NodeProperties*	m_pNodeProperties;			// The rarely accessed data of the nodes, indexed by node id
+	Node**			m_pNodes;					// Points to the first node of each row of the node storage, allows access by grid coordinates
 	
 	TeamAI*		    m_pTeamAI[NumberOfTeams-1]; // The team AIs controlling the entities of the teams
 
@@ -145,6 +178,18 @@ private:
 	std::vector<XMFLOAT2>								 m_baseFieldPositions[NumberOfTeams-1]; // The world positions of the team base grid fields for each team
 
 	Pathfinder   m_pathfinder;                              // The pathfinder associated to this environment.
+	ClusterGraph m_clusterGraph;							// The abstraction of the node graph used for hierarchical pathfinding
+	unsigned int m_obstacleVersion;							// Incremented whenever obstacles are added or removed, invalidates cached paths
+	FlowFieldManager m_flowFieldManager;					// Holds the flow fields leading to the flags, base entrances and attack positions
+	LandmarkTable m_landmarkTable;							// Holds the distances to the landmarks used by the landmark (ALT) heuristic
+	ConnectedComponents m_connectedComponents;				// Labels the nodes with the connected component of the node graph they belong to
+	NavigationMesh m_navigationMesh;						// Covers the traversable nodes with rectangles for searches on a much smaller graph
+	SpatialHash  m_soldierHash;								// Sorts the soldiers into buckets by position to speed up proximity queries
+	FieldOfViewCandidates m_fieldOfViewCandidates;			// The enemies within range and field of view of each soldier at the start of the frame
+	VisibilityTable m_visibilityTable;						// The precomputed line of sight between grid fields within viewing distance of each other
+	unsigned int m_pathExpansionsLeft;						// The number of node expansions left for time-sliced path searches during the current frame
+	unsigned int m_pathSearchesThisFrame;					// The number of time-sliced path searches that requested expansions during the current frame
+	unsigned int m_pathSearchesLastFrame;					// The number of time-sliced path searches that requested expansions during the last frame
 	float        m_objectScaleFactors[NumberOfObjectTypes]; // Determines the scale of the different objects in relation to a grid field
 	unsigned int m_soldierCount[NumberOfTeams-1];			// Keeps track of how many soldiers have been placed in edit mode
 	bool		 m_flagSet[NumberOfTeams-1];				// Keeps track of the flags that have been placed in edit mode
@@ -0,0 +1,323 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  VisibilityTable.cpp
+*  Precomputed visibility between the grid fields of a test environment. For each grid field a
+*  bitset tells which of the fields within viewing distance are visible from every point of the
+*  field, that is no obstacle touches the area swept by the lines between the two fields. The bits
+*  only cover the offsets within a disc around the field, and only half of them as visibility is
+*  symmetric. A line of sight check between soldiers in such fields thus becomes a single bit test,
+*  all other pairs are still checked exactly. Changes to the obstacles only invalidate the fields
+*  around them, these are rebuilt on the next update.
+*/
+
+// Includes
+#include <algorithm>
+#include "VisibilityTable.h"
+#include "TestEnvironment.h"
+
+VisibilityTable::VisibilityTable(void) : m_pEnvironment(nullptr),
+										 m_numberOfGridPartitions(0),
+										 m_radius(0),
+										 m_numberOfWords(0),
+										 m_isUpToDate(false)
+{
+}
+
+VisibilityTable::~VisibilityTable(void)
+{
+}
+
+//--------------------------------------------------------------------------------------
+// Initialises the visibility table for the current grid of a test environment. All
+// fields are marked for rebuild.
+// Param1: A pointer to the test environment.
+// Param2: The distance in world units up to which the visibility between fields is stored.
+// Returns true if the visibility table was initialised successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool VisibilityTable::Initialise(const TestEnvironment* pTestEnvironment, float viewingDistance)
+{
+	if(!pTestEnvironment || viewingDistance <= 0.0f)
+	{
+		return false;
+	}
+
+	m_pEnvironment			 = pTestEnvironment;
+	m_numberOfGridPartitions = m_pEnvironment->GetNumberOfGridPartitions();
+
+	// Soldiers can be anywhere within their grid fields, add one field to cover all pairs within viewing distance
+	m_radius = static_cast<unsigned int>(viewingDistance / m_pEnvironment->GetGridSpacing()) + 1;
+
+	int radius = static_cast<int>(m_radius);
+	int width  = 2 * radius + 1;
+
+	m_offsetIndices.assign(width * width, -1);
+	m_offsetsX.clear();
+	m_offsetsY.clear();
+	m_sweptFieldsStart.clear();
+	m_sweptFieldsX.clear();
+	m_sweptFieldsY.clear();
+
+	// Only store the offsets in one half of the disc, the other half is covered by swapping start and end
+	for(int offsetX = -radius; offsetX <= radius; ++offsetX)
+	{
+		for(int offsetY = 0; offsetY <= radius; ++offsetY)
+		{
+			if((offsetY == 0 && offsetX < 0) || (offsetX * offsetX + offsetY * offsetY > radius * radius))
+			{
+				continue;
+			}
+
+			m_offsetIndices[(offsetX + radius) * width + offsetY + radius] = static_cast<int>(m_offsetsX.size());
+			m_offsetsX.push_back(offsetX);
+			m_offsetsY.push_back(offsetY);
+
+			m_sweptFieldsStart.push_back(static_cast<unsigned int>(m_sweptFieldsX.size()));
+			CalculateSweptFields(offsetX, offsetY);
+		}
+	}
+
+	m_sweptFieldsStart.push_back(static_cast<unsigned int>(m_sweptFieldsX.size()));
+
+	m_numberOfWords = (static_cast<unsigned int>(m_offsetsX.size()) + 31) / 32;
+
+	m_visibility.assign(m_numberOfGridPartitions * m_numberOfGridPartitions * m_numberOfWords, 0);
+	m_isDirty.assign(m_numberOfGridPartitions * m_numberOfGridPartitions, true);
+
+	m_isUpToDate = false;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Marks the fields affected by a change to a grid field (an obstacle was added or removed)
+// for rebuild. These are all fields close enough to have the changed field among the swept
+// fields of one of their offsets.
+// Param1: The x-coordinate of the changed grid field.
+// Param2: The y-coordinate of the changed grid field.
+//--------------------------------------------------------------------------------------
+void VisibilityTable::Invalidate(unsigned int gridX, unsigned int gridY)
+{
+	if(gridX >= m_numberOfGridPartitions || gridY >= m_numberOfGridPartitions)
+	{
+		return;
+	}
+
+	// Swept fields lie at most one field beside the line between the centres of two fields
+	int radius = static_cast<int>(m_radius) + 2;
+
+	for(int offsetX = -radius; offsetX <= radius; ++offsetX)
+	{
+		for(int offsetY = -radius; offsetY <= radius; ++offsetY)
+		{
+			int x = static_cast<int>(gridX) + offsetX;
+			int y = static_cast<int>(gridY) + offsetY;
+
+			if(x >= 0 && y >= 0 && x < static_cast<int>(m_numberOfGridPartitions) && y < static_cast<int>(m_numberOfGridPartitions) &&
+			   offsetX * offsetX + offsetY * offsetY <= radius * radius)
+			{
+				m_isDirty[x * m_numberOfGridPartitions + y] = true;
+			}
+		}
+	}
+
+	m_isUpToDate = false;
+}
+
+//--------------------------------------------------------------------------------------
+// Rebuilds the bitsets of all fields marked for rebuild. The obstacles of the node graph
+// have to be up to date.
+//--------------------------------------------------------------------------------------
+void VisibilityTable::Update(void)
+{
+	if(m_isUpToDate)
+	{
+		return;
+	}
+
+	for(unsigned int i = 0; i < m_numberOfGridPartitions; ++i)
+	{
+		for(unsigned int k = 0; k < m_numberOfGridPartitions; ++k)
+		{
+			if(m_isDirty[i * m_numberOfGridPartitions + k])
+			{
+				CalculateVisibility(i, k);
+				m_isDirty[i * m_numberOfGridPartitions + k] = false;
+			}
+		}
+	}
+
+	m_isUpToDate = true;
+}
+
+//--------------------------------------------------------------------------------------
+// Looks up whether every point of one grid field can be seen from every point of another one.
+// Param1: The x-coordinate of the start field.
+// Param2: The y-coordinate of the start field.
+// Param3: The x-coordinate of the end field.
+// Param4: The y-coordinate of the end field.
+// Returns true if the fields are fully visible from each other, false if an obstacle might block
+// the view, the fields are too far apart or the table is not up to date. The line of sight has to
+// be checked exactly then.
+//--------------------------------------------------------------------------------------
+bool VisibilityTable::IsFullyVisible(unsigned int startX, unsigned int startY, unsigned int endX, unsigned int endY) const
+{
+	if(!m_isUpToDate || startX >= m_numberOfGridPartitions || startY >= m_numberOfGridPartitions || endX >= m_numberOfGridPartitions || endY >= m_numberOfGridPartitions)
+	{
+		return false;
+	}
+
+	int offsetX = static_cast<int>(endX) - static_cast<int>(startX);
+	int offsetY = static_cast<int>(endY) - static_cast<int>(startY);
+
+	if(offsetY < 0 || (offsetY == 0 && offsetX < 0))
+	{
+		// The offset lies in the half that is not stored, look it up from the end field instead
+		offsetX = -offsetX;
+		offsetY = -offsetY;
+		startX	= endX;
+		startY	= endY;
+	}
+
+	int index = GetOffsetIndex(offsetX, offsetY);
+
+	if(index < 0)
+	{
+		return false;
+	}
+
+	return (m_visibility[(startX * m_numberOfGridPartitions + startY) * m_numberOfWords + index / 32] & (1u << (index % 32))) != 0;
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the fields, obstacles on which could block a line between two fields of the
+// given offset. The lines between two fields sweep the area covered by one field moved along
+// the line between their centres. An obstacle field touches this area if its centre lies
+// within one field (in both directions) of that line. The offsets of these fields are
+// appended to the swept fields.
+// Param1: The x component of the offset between the two fields.
+// Param2: The y component of the offset between the two fields.
+//--------------------------------------------------------------------------------------
+void VisibilityTable::CalculateSweptFields(int offsetX, int offsetY)
+{
+	int minX = std::min(0, offsetX) - 1;
+	int maxX = std::max(0, offsetX) + 1;
+	int minY = std::min(0, offsetY) - 1;
+	int maxY = std::max(0, offsetY) + 1;
+
+	for(int x = minX; x <= maxX; ++x)
+	{
+		for(int y = minY; y <= maxY; ++y)
+		{
+			// The square of side length two around the field centre overlaps the line unless all of its
+			// corners lie strictly on the same side of it. Touching counts as overlapping as lines grazing an
+			// obstacle might be reported as blocked.
+			bool isLeft	 = false;
+			bool isRight = false;
+
+			for(int cornerX = -1; cornerX <= 1; cornerX += 2)
+			{
+				for(int cornerY = -1; cornerY <= 1; cornerY += 2)
+				{
+					int side = offsetX * (y + cornerY) - offsetY * (x + cornerX);
+
+					isLeft	= isLeft || side >= 0;
+					isRight = isRight || side <= 0;
+				}
+			}
+
+			if(isLeft && isRight)
+			{
+				m_sweptFieldsX.push_back(x);
+				m_sweptFieldsY.push_back(y);
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the fields within range of a grid field that are fully visible from it, these
+// are the fields whose swept fields are free of obstacles.
+// Param1: The x-coordinate of the grid field.
+// Param2: The y-coordinate of the grid field.
+//--------------------------------------------------------------------------------------
+void VisibilityTable::CalculateVisibility(unsigned int gridX, unsigned int gridY)
+{
+	unsigned int* pWords = &m_visibility[(gridX * m_numberOfGridPartitions + gridY) * m_numberOfWords];
+
+	for(unsigned int word = 0; word < m_numberOfWords; ++word)
+	{
+		pWords[word] = 0;
+	}
+
+	for(unsigned int i = 0; i < m_offsetsX.size(); ++i)
+	{
+		int x = static_cast<int>(gridX) + m_offsetsX[i];
+		int y = static_cast<int>(gridY) + m_offsetsY[i];
+
+		if(x < 0 || x >= static_cast<int>(m_numberOfGridPartitions) || y >= static_cast<int>(m_numberOfGridPartitions))
+		{
+			continue;
+		}
+
+		bool isFullyVisible = true;
+
+		for(unsigned int k = m_sweptFieldsStart[i]; k < m_sweptFieldsStart[i + 1] && isFullyVisible; ++k)
+		{
+			int sweptX = static_cast<int>(gridX) + m_sweptFieldsX[k];
+			int sweptY = static_cast<int>(gridY) + m_sweptFieldsY[k];
+
+			// There are no obstacles outside of the grid
+			if(sweptX >= 0 && sweptY >= 0 && sweptX < static_cast<int>(m_numberOfGridPartitions) && sweptY < static_cast<int>(m_numberOfGridPartitions))
+			{
+				isFullyVisible = !m_pEnvironment->GetNode(sweptX, sweptY)->IsObstacle();
+			}
+		}
+
+		if(isFullyVisible)
+		{
+			pWords[i / 32] |= 1u << (i % 32);
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the bit index of an offset between two fields.
+// Param1: The x component of the offset.
+// Param2: The y component of the offset.
+// Returns the index of the bit, -1 if the offset is not covered.
+//--------------------------------------------------------------------------------------
+int VisibilityTable::GetOffsetIndex(int offsetX, int offsetY) const
+{
+	int radius = static_cast<int>(m_radius);
+
+	if(offsetX < -radius || offsetX > radius || offsetY < -radius || offsetY > radius)
+	{
+		return -1;
+	}
+
+	return m_offsetIndices[(offsetX + radius) * (2 * radius + 1) + offsetY + radius];
+}
+
+// Data access functions
+
+unsigned int VisibilityTable::GetRadius(void) const
+{
+	return m_radius;
+}
+
+unsigned int VisibilityTable::GetNumberOfOffsets(void) const
+{
+	return static_cast<unsigned int>(m_offsetsX.size());
+}
+
+unsigned int VisibilityTable::GetMemoryUsage(void) const
+{
+	return static_cast<unsigned int>(m_visibility.size() * sizeof(unsigned int) + m_offsetIndices.size() * sizeof(int) +
+									 (m_offsetsX.size() + m_offsetsY.size() + m_sweptFieldsStart.size() + m_sweptFieldsX.size() + m_sweptFieldsY.size()) * sizeof(int) +
+									 m_isDirty.size() / 8);
+}
+
+bool VisibilityTable::IsUpToDate(void) const
+{
+	return m_isUpToDate;
+}
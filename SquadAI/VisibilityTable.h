@@ -0,0 +1,61 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  VisibilityTable.h
+*  Precomputed visibility between the grid fields of a test environment. For each grid field a
+*  bitset tells which of the fields within viewing distance are visible from every point of the
+*  field, that is no obstacle touches the area swept by the lines between the two fields. The bits
+*  only cover the offsets within a disc around the field, and only half of them as visibility is
+*  symmetric. A line of sight check between soldiers in such fields thus becomes a single bit test,
+*  all other pairs are still checked exactly. Changes to the obstacles only invalidate the fields
+*  around them, these are rebuilt on the next update.
+*/
+
+#ifndef VISIBILITY_TABLE_H
+#define VISIBILITY_TABLE_H
+
+// Includes
+#include <vector>
+
+// Forward declarations
+class TestEnvironment;
+
+class VisibilityTable
+{
+public:
+	VisibilityTable(void);
+	~VisibilityTable(void);
+
+	bool Initialise(const TestEnvironment* pTestEnvironment, float viewingDistance);
+	void Invalidate(unsigned int gridX, unsigned int gridY);
+	void Update(void);
+
+	bool IsFullyVisible(unsigned int startX, unsigned int startY, unsigned int endX, unsigned int endY) const;
+
+	// Data access functions
+
+	unsigned int GetRadius(void) const;
+	unsigned int GetNumberOfOffsets(void) const;
+	unsigned int GetMemoryUsage(void) const;
+	bool		 IsUpToDate(void) const;
+
+private:
+	void CalculateSweptFields(int offsetX, int offsetY);
+	void CalculateVisibility(unsigned int gridX, unsigned int gridY);
+	int	 GetOffsetIndex(int offsetX, int offsetY) const;
+
+	const TestEnvironment*	  m_pEnvironment;			// The test environment, the visibility between the grid fields of which is stored
+	unsigned int			  m_numberOfGridPartitions; // The number of grid fields along the x and y axis of the grid
+	unsigned int			  m_radius;					// The radius in grid fields of the disc of offsets covered for each field
+	std::vector<int>		  m_offsetIndices;			// The bit index of each offset within the square around a field, -1 if the offset is not covered
+	std::vector<int>		  m_offsetsX;				// The x component of each covered offset, indexed by bit index
+	std::vector<int>		  m_offsetsY;				// The y component of each covered offset, indexed by bit index
+	std::vector<unsigned int> m_sweptFieldsStart;		// The index of the first swept field of each offset, indexed by bit index (one more entry marks the end)
+	std::vector<int>		  m_sweptFieldsX;			// The x offsets of the fields, obstacles on which could block a line between two fields of each offset
+	std::vector<int>		  m_sweptFieldsY;			// The y offsets of the swept fields
+	unsigned int			  m_numberOfWords;			// The number of 32 bit words of the bitset of a grid field
+	std::vector<unsigned int> m_visibility;				// The bitsets of the fully visible fields of all fields, indexed by (gridX * number of partitions + gridY) * number of words + word
+	std::vector<bool>		  m_isDirty;				// Tells for each field whether its bitset has to be rebuilt because obstacles around it changed
+	bool					  m_isUpToDate;				// Tells whether all bitsets are valid for the current obstacles
+};
+
+#endif // VISIBILITY_TABLE_H
@@ -0,0 +1,250 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  BidirectionalSearchTests.cpp
+*  Property tests and a benchmark for bidirectional A*. Random pairs of free fields are searched
+*  with A* and with bidirectional A* through the time-sliced path requests used by the soldiers.
+*  Both searches have to agree on whether a path exists and on the cost of the shortest one. The
+*  path returned by the bidirectional search has to lead from the start to the target through
+*  free fields and must not be longer than the shortest grid path. The expansions of both
+*  searches are reported for the pairs further apart than half the map diagonal.
+*/
+
+// Includes
+#include <cstdio>
+#include <cmath>
+#include <cfloat>
+#include <climits>
+#include <vector>
+#include <algorithm>
+#include "TestEnvironment.h"
+#include "TestUtilities.h"
+#include "TestSuites.h"
+
+// The number of random pairs of fields searched on each map
+const unsigned int g_kNumberOfSearchPairs = 400;
+
+// The relative difference, up to which path costs are considered equal (both sides add up
+// the costs of the steps in a different order)
+const float g_kPathCostTolerance = 1e-4f;
+
+//--------------------------------------------------------------------------------------
+// Looks up the id of the node at a world position.
+// Param1: The test environment.
+// Param2: The world position.
+// Returns the id of the node of the grid field containing the position.
+//--------------------------------------------------------------------------------------
+unsigned long GetNodeId(TestEnvironment& environment, const XMFLOAT2& position)
+{
+	XMFLOAT2 gridPosition;
+	environment.WorldToGridPosition(position, gridPosition);
+
+	return environment.GetNode(static_cast<unsigned int>(gridPosition.x), static_cast<unsigned int>(gridPosition.y))->GetId();
+}
+
+//--------------------------------------------------------------------------------------
+// Determines the cost of the path found by the last bidirectional search of a context. The
+// path passes from one side to the other at the node with the smallest sum of the costs of
+// both sides.
+// Param1: The test environment.
+// Param2: The search context used by the bidirectional search.
+// Returns the cost of the path, FLT_MAX if the sides did not meet.
+//--------------------------------------------------------------------------------------
+float GetBidirectionalPathCost(TestEnvironment& environment, SearchContext& context)
+{
+	SearchContext& backwardContext = context.GetBackwardContext();
+
+	unsigned long numberOfNodes = environment.GetNumberOfGridPartitions() * environment.GetNumberOfGridPartitions();
+	float		  bestCost		= FLT_MAX;
+
+	for(unsigned long id = 0; id < numberOfNodes; ++id)
+	{
+		if(context.IsVisited(id) && backwardContext.IsVisited(id))
+		{
+			bestCost = std::min(bestCost, context.GetNodeData(id).m_movementCost + backwardContext.GetNodeData(id).m_movementCost);
+		}
+	}
+
+	return bestCost;
+}
+
+//--------------------------------------------------------------------------------------
+// Checks that a path leads from the start to the target through free fields and is not longer
+// than the shortest path on the grid.
+// Param1: The test environment.
+// Param2: The path in world space.
+// Param3: The start position of the search.
+// Param4: The target position of the search.
+// Param5: The cost of the shortest path on the grid.
+// Returns true if the path is valid, false otherwise.
+//--------------------------------------------------------------------------------------
+bool IsPathValid(TestEnvironment& environment, const std::vector<XMFLOAT2>& path, const XMFLOAT2& start, const XMFLOAT2& target, float shortestCost)
+{
+	if(path.empty() || GetNodeId(environment, path.front()) != GetNodeId(environment, start) || GetNodeId(environment, path.back()) != GetNodeId(environment, target))
+	{
+		return false;
+	}
+
+	float length = 0.0f;
+
+	for(unsigned int i = 1; i < path.size(); ++i)
+	{
+		XMFLOAT2 from;
+		XMFLOAT2 to;
+		environment.WorldToGridPosition(path[i - 1], from);
+		environment.WorldToGridPosition(path[i], to);
+
+		if(!environment.CheckStraightPathGrid(static_cast<int>(from.x), static_cast<int>(from.y), static_cast<int>(to.x), static_cast<int>(to.y)))
+		{
+			return false;
+		}
+
+		length += sqrt((path[i].x - path[i - 1].x) * (path[i].x - path[i - 1].x) + (path[i].y - path[i - 1].y) * (path[i].y - path[i - 1].y));
+	}
+
+	return length <= shortestCost * (1.0f + g_kPathCostTolerance);
+}
+
+//--------------------------------------------------------------------------------------
+// Runs the property tests and the benchmark of bidirectional A* on several maps.
+// Returns true if bidirectional A* agrees with A* for all pairs of fields, false otherwise.
+//--------------------------------------------------------------------------------------
+bool RunBidirectionalSearchTests(void)
+{
+	SetRandomSeed(12);
+
+	const MapType	   kMapTypes[5]				 = {WallsMap, SparseRandomMap, DenseRandomMap, WallsMap, DenseRandomMap};
+	const unsigned int kNumberOfGridPartitions[5] = {64, 64, 64, 128, 128};
+	const Heuristic	   kHeuristics[2]			 = {EuclideanDistance, OctileDistance};
+	const char*		   kHeuristicNames[2]		 = {"euclidean", "octile"};
+
+	bool isSuccessful = true;
+
+	printf("Bidirectional A* compared to A* for %u random pairs of fields per map, expansions per query for pairs further apart than half the diagonal\n", g_kNumberOfSearchPairs);
+	printf("%-18s %-10s %8s %8s %8s %8s %8s %10s %10s %8s\n", "map", "heuristic", "paths", "exists", "cost", "invalid", "budget", "A* exp.", "bidir exp.", "ratio");
+
+	for(unsigned int map = 0; map < 5; ++map)
+	{
+		TestEnvironment environment;
+
+		if(!CreateMap(environment, kMapTypes[map], kNumberOfGridPartitions[map]))
+		{
+			printf("Failed to set up the %s map of size %u\n", GetMapTypeName(kMapTypes[map]), kNumberOfGridPartitions[map]);
+			isSuccessful = false;
+			continue;
+		}
+
+		Pathfinder& pathfinder = environment.GetPathfinder();
+		float		halfDiagonal = 0.5f * sqrt(2.0f) * environment.GetNumberOfGridPartitions();
+
+		for(unsigned int h = 0; h < 2; ++h)
+		{
+			SearchContext aStarContext;
+			SearchContext bidirectionalContext;
+
+			unsigned int numberOfPaths	   = 0;
+			unsigned int existenceMismatches = 0;
+			unsigned int costMismatches	   = 0;
+			unsigned int invalidPaths	   = 0;
+			unsigned int budgetMismatches	   = 0;
+			unsigned int numberOfLongPairs   = 0;
+			double		 aStarExpansions	   = 0.0;
+			double		 bidirectionalExpansions = 0.0;
+
+			for(unsigned int i = 0; i < g_kNumberOfSearchPairs; ++i)
+			{
+				XMFLOAT2 start;
+				XMFLOAT2 target;
+				GetRandomFreePosition(environment, start);
+				GetRandomFreePosition(environment, target);
+
+				std::vector<XMFLOAT2> aStarPath;
+				std::vector<XMFLOAT2> bidirectionalPath;
+
+				bool isAStarPathFound = pathfinder.CalculatePath(AStar, kHeuristics[h], 0.0f, start, target, aStarPath, aStarContext);
+
+				unsigned int	 expansionBudget = UINT_MAX;
+				PathSearchStatus status			 = pathfinder.StartPathSearch(BidirectionalAStar, kHeuristics[h], 0.0f, start, target, bidirectionalPath, bidirectionalContext, expansionBudget);
+
+				if(aStarContext.GetQueryStatistics().m_isCacheHit || bidirectionalContext.GetQueryStatistics().m_isCacheHit)
+				{
+					// The pair was searched before, the contexts do not hold its search
+					continue;
+				}
+
+				// The whole search has to be completed within a single slice and charged against the budget
+				if(status == SearchPending || UINT_MAX - expansionBudget != bidirectionalContext.GetQueryStatistics().m_nodesExpanded)
+				{
+					++budgetMismatches;
+				}
+
+				if(isAStarPathFound != (status == SearchSucceeded))
+				{
+					++existenceMismatches;
+					continue;
+				}
+
+				if(!isAStarPathFound)
+				{
+					continue;
+				}
+
+				++numberOfPaths;
+
+				float aStarCost			= aStarContext.GetNodeData(GetNodeId(environment, target)).m_movementCost;
+				float bidirectionalCost = GetBidirectionalPathCost(environment, bidirectionalContext);
+
+				if(fabs(aStarCost - bidirectionalCost) > g_kPathCostTolerance * std::max(aStarCost, 1.0f))
+				{
+					++costMismatches;
+				}
+
+				if(!IsPathValid(environment, bidirectionalPath, start, target, aStarCost))
+				{
+					++invalidPaths;
+				}
+
+				XMFLOAT2 startGridPosition;
+				XMFLOAT2 targetGridPosition;
+				environment.WorldToGridPosition(start, startGridPosition);
+				environment.WorldToGridPosition(target, targetGridPosition);
+
+				if(sqrt((targetGridPosition.x - startGridPosition.x) * (targetGridPosition.x - startGridPosition.x) + (targetGridPosition.y - startGridPosition.y) * (targetGridPosition.y - startGridPosition.y)) > halfDiagonal)
+				{
+					++numberOfLongPairs;
+					aStarExpansions			+= aStarContext.GetQueryStatistics().m_nodesExpanded;
+					bidirectionalExpansions += bidirectionalContext.GetQueryStatistics().m_nodesExpanded;
+				}
+			}
+
+			// Without budget left the search must not start
+			XMFLOAT2 start;
+			XMFLOAT2 target;
+			GetRandomFreePosition(environment, start);
+			GetRandomFreePosition(environment, target);
+
+			std::vector<XMFLOAT2> path;
+			unsigned int		  expansionBudget = 0;
+
+			if(pathfinder.StartPathSearch(BidirectionalAStar, kHeuristics[h], 0.0f, start, target, path, bidirectionalContext, expansionBudget) != SearchPending)
+			{
+				++budgetMismatches;
+			}
+
+			if(existenceMismatches + costMismatches + invalidPaths + budgetMismatches != 0)
+			{
+				isSuccessful = false;
+			}
+
+			aStarExpansions			/= std::max(numberOfLongPairs, 1u);
+			bidirectionalExpansions /= std::max(numberOfLongPairs, 1u);
+
+			printf("%3ux%-3u %-10s %-10s %8u %8u %8u %8u %8u %10.0f %10.0f %8.2f\n", kNumberOfGridPartitions[map], kNumberOfGridPartitions[map], GetMapTypeName(kMapTypes[map]), kHeuristicNames[h],
+				   numberOfPaths, existenceMismatches, costMismatches, invalidPaths, budgetMismatches, aStarExpansions, bidirectionalExpansions,
+				   (aStarExpansions > 0.0) ? bidirectionalExpansions / aStarExpansions : 0.0);
+		}
+
+		environment.EndSimulation();
+	}
+
+	return isSuccessful;
+}
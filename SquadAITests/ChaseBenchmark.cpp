@@ -0,0 +1,229 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  ChaseBenchmark.cpp
+*  Compares the cost of replanning with moving target adaptive A* to replanning with A* from
+*  scratch while chasing a moving target, as soldiers do when they intercept a flag carrier.
+*  In every update the target takes a random step and the chaser a step along its path, then
+*  the path is searched again through the time-sliced path requests used by the soldiers. Both
+*  algorithms search the same sequence of queries and have to find paths of the same cost.
+*/
+
+// Includes
+#include <cstdio>
+#include <cmath>
+#include <climits>
+#include <vector>
+#include <algorithm>
+#include "TestEnvironment.h"
+#include "TestUtilities.h"
+#include "TestSuites.h"
+
+// The number of chases run on each map and the number of updates per chase
+const unsigned int g_kNumberOfChases	 = 20;
+const unsigned int g_kUpdatesPerChase	 = 60;
+
+// The relative difference, up to which path costs are considered equal
+const float g_kChaseCostTolerance = 1e-4f;
+
+//--------------------------------------------------------------------------------------
+// Looks up the node of the grid field containing a world position.
+// Param1: The test environment.
+// Param2: The world position.
+// Returns a pointer to the node.
+//--------------------------------------------------------------------------------------
+const Node* GetNodeAt(TestEnvironment& environment, const XMFLOAT2& position)
+{
+	XMFLOAT2 gridPosition;
+	environment.WorldToGridPosition(position, gridPosition);
+
+	return environment.GetNode(static_cast<unsigned int>(gridPosition.x), static_cast<unsigned int>(gridPosition.y));
+}
+
+//--------------------------------------------------------------------------------------
+// Moves a position to an adjacent free field, the moves follow the same rules as paths.
+// Param1: The test environment.
+// Param2: The position to move, the centre of a grid field.
+// Param3: The position to approach, a random adjacent field is chosen if it is nullptr.
+//--------------------------------------------------------------------------------------
+void TakeStep(TestEnvironment& environment, XMFLOAT2& position, const XMFLOAT2* pGoal)
+{
+	const Node*	  pNode	   = GetNodeAt(environment, position);
+	unsigned int  x		   = static_cast<unsigned int>(pNode->GetGridPosition().x);
+	unsigned int  y		   = static_cast<unsigned int>(pNode->GetGridPosition().y);
+	unsigned char moveMask = pNode->GetMoveMask();
+
+	if(moveMask == 0)
+	{
+		return;
+	}
+
+	if(!pGoal)
+	{
+		unsigned int move = GetRandomNumber(g_kNumberOfMoves);
+
+		while(!(moveMask & (1 << move)))
+		{
+			move = (move + 1) % g_kNumberOfMoves;
+		}
+
+		position = environment.GetNode(x + g_kMoveOffsetX[move], y + g_kMoveOffsetY[move])->GetWorldPosition();
+		return;
+	}
+
+	// Take the legal step that gets closest to the goal
+	float bestDistance = (pGoal->x - position.x) * (pGoal->x - position.x) + (pGoal->y - position.y) * (pGoal->y - position.y);
+
+	for(unsigned int move = 0; move < g_kNumberOfMoves; ++move)
+	{
+		if(!(moveMask & (1 << move)))
+		{
+			continue;
+		}
+
+		const XMFLOAT2& nextPosition = environment.GetNode(x + g_kMoveOffsetX[move], y + g_kMoveOffsetY[move])->GetWorldPosition();
+		float			distance	 = (pGoal->x - nextPosition.x) * (pGoal->x - nextPosition.x) + (pGoal->y - nextPosition.y) * (pGoal->y - nextPosition.y);
+
+		if(distance < bestDistance)
+		{
+			bestDistance = distance;
+			position	 = nextPosition;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Searches a path through the time-sliced path requests with an unlimited budget.
+// Param1: The pathfinder.
+// Param2: The algorithm to use.
+// Param3: The start position.
+// Param4: The target position.
+// Param5: Will hold the path.
+// Param6: The search context, it keeps the learned heuristic of adaptive A* between searches.
+// Param7: Will hold the time spent on the search in microseconds.
+// Returns true if a path was found, false otherwise.
+//--------------------------------------------------------------------------------------
+bool SearchChasePath(Pathfinder& pathfinder, PathfindingAlgorithm algorithm, const XMFLOAT2& start, const XMFLOAT2& target, std::vector<XMFLOAT2>& path, SearchContext& context, double& time)
+{
+	unsigned int expansionBudget = UINT_MAX;
+
+	double startTime = GetTime();
+	bool   isFound	 = pathfinder.StartPathSearch(algorithm, EuclideanDistance, 0.0f, start, target, path, context, expansionBudget) == SearchSucceeded;
+	time			 = GetTime() - startTime;
+
+	return isFound;
+}
+
+//--------------------------------------------------------------------------------------
+// Runs the chase benchmark on several maps.
+// Returns true if adaptive A* and A* found paths of the same cost for all updates, false
+// otherwise.
+//--------------------------------------------------------------------------------------
+bool RunChaseBenchmark(void)
+{
+	SetRandomSeed(8);
+
+	const MapType	   kMapTypes[4]				  = {WallsMap, SparseRandomMap, DenseRandomMap, SparseRandomMap};
+	const unsigned int kNumberOfGridPartitions[4] = {64, 64, 128, 256};
+
+	bool isSuccessful = true;
+
+	printf("Replanning cost while chasing a moving target, %u chases of %u updates per map\n", g_kNumberOfChases, g_kUpdatesPerChase);
+	printf("%-18s %8s %8s %10s %10s %8s %10s %10s %8s\n", "map", "updates", "cost", "A* exp.", "adapt exp.", "ratio", "A* us", "adapt us", "speedup");
+
+	for(unsigned int map = 0; map < 4; ++map)
+	{
+		TestEnvironment environment;
+
+		if(!CreateMap(environment, kMapTypes[map], kNumberOfGridPartitions[map]))
+		{
+			printf("Failed to set up the %s map of size %u\n", GetMapTypeName(kMapTypes[map]), kNumberOfGridPartitions[map]);
+			isSuccessful = false;
+			continue;
+		}
+
+		Pathfinder& pathfinder = environment.GetPathfinder();
+
+		unsigned int numberOfUpdates	= 0;
+		unsigned int costMismatches		= 0;
+		double		 aStarExpansions	= 0.0;
+		double		 adaptiveExpansions = 0.0;
+		double		 aStarTime			= 0.0;
+		double		 adaptiveTime		= 0.0;
+
+		for(unsigned int chase = 0; chase < g_kNumberOfChases; ++chase)
+		{
+			// Every chaser keeps its own context, like the movement manager of a soldier
+			SearchContext aStarContext;
+			SearchContext adaptiveContext;
+
+			XMFLOAT2 chaserPosition;
+			XMFLOAT2 targetPosition;
+			GetRandomFreePosition(environment, chaserPosition);
+			GetRandomFreePosition(environment, targetPosition);
+
+			for(unsigned int update = 0; update < g_kUpdatesPerChase; ++update)
+			{
+				TakeStep(environment, targetPosition, nullptr);
+
+				if(GetNodeAt(environment, chaserPosition) == GetNodeAt(environment, targetPosition))
+				{
+					break;
+				}
+
+				std::vector<XMFLOAT2> aStarPath;
+				std::vector<XMFLOAT2> adaptivePath;
+				double				  aStarSearchTime	 = 0.0;
+				double				  adaptiveSearchTime = 0.0;
+
+				bool isAStarPathFound	 = SearchChasePath(pathfinder, AStar, chaserPosition, targetPosition, aStarPath, aStarContext, aStarSearchTime);
+				bool isAdaptivePathFound = SearchChasePath(pathfinder, AdaptiveAStar, chaserPosition, targetPosition, adaptivePath, adaptiveContext, adaptiveSearchTime);
+
+				if(!isAStarPathFound || !isAdaptivePathFound)
+				{
+					costMismatches += (isAStarPathFound != isAdaptivePathFound) ? 1 : 0;
+					break;
+				}
+
+				if(!aStarContext.GetQueryStatistics().m_isCacheHit && !adaptiveContext.GetQueryStatistics().m_isCacheHit)
+				{
+					unsigned long targetId = GetNodeAt(environment, targetPosition)->GetId();
+
+					float aStarCost	   = aStarContext.GetNodeData(targetId).m_movementCost;
+					float adaptiveCost = adaptiveContext.GetNodeData(targetId).m_movementCost;
+
+					if(fabs(aStarCost - adaptiveCost) > g_kChaseCostTolerance * std::max(aStarCost, 1.0f))
+					{
+						++costMismatches;
+					}
+
+					++numberOfUpdates;
+					aStarExpansions	   += aStarContext.GetQueryStatistics().m_nodesExpanded;
+					adaptiveExpansions += adaptiveContext.GetQueryStatistics().m_nodesExpanded;
+					aStarTime		   += aStarSearchTime;
+					adaptiveTime	   += adaptiveSearchTime;
+				}
+
+				if(adaptivePath.size() > 1)
+				{
+					TakeStep(environment, chaserPosition, &adaptivePath[1]);
+				}
+			}
+		}
+
+		if(costMismatches != 0)
+		{
+			isSuccessful = false;
+		}
+
+		unsigned int divisor = std::max(numberOfUpdates, 1u);
+
+		printf("%3ux%-3u %-10s %8u %8u %10.0f %10.0f %8.3f %10.1f %10.1f %8.1f\n", kNumberOfGridPartitions[map], kNumberOfGridPartitions[map], GetMapTypeName(kMapTypes[map]),
+			   numberOfUpdates, costMismatches, aStarExpansions / divisor, adaptiveExpansions / divisor,
+			   (aStarExpansions > 0.0) ? adaptiveExpansions / aStarExpansions : 0.0, aStarTime / divisor, adaptiveTime / divisor,
+			   (adaptiveTime > 0.0) ? aStarTime / adaptiveTime : 0.0);
+
+		environment.EndSimulation();
+	}
+
+	return isSuccessful;
+}
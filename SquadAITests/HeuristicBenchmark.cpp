@@ -0,0 +1,133 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  HeuristicBenchmark.cpp
+*  Compares the heuristics available to A*: the euclidean distance, the octile distance and
+*  the landmark (ALT) lower bound. All of them are admissible, so A* has to find paths of the
+*  same cost for the same random pairs of free fields with every heuristic. The benchmark
+*  reports the expanded nodes and the time per query for each heuristic.
+*/
+
+// Includes
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "TestEnvironment.h"
+#include "TestUtilities.h"
+#include "TestSuites.h"
+
+// The number of random pairs of fields searched on each map
+const unsigned int g_kNumberOfHeuristicQueries = 200;
+
+// The number of compared heuristics
+const unsigned int g_kNumberOfHeuristics = 3;
+
+// The relative difference, up to which path costs are considered equal
+const float g_kHeuristicCostTolerance = 1e-4f;
+
+//--------------------------------------------------------------------------------------
+// Runs the benchmark of the heuristics on several maps.
+// Returns true if A* finds paths of the same cost with all heuristics for all pairs of
+// fields, false otherwise.
+//--------------------------------------------------------------------------------------
+bool RunHeuristicBenchmark(void)
+{
+	SetRandomSeed(9);
+
+	const MapType	   kMapTypes[5]						  = {WallsMap, SparseRandomMap, DenseRandomMap, WallsMap, DenseRandomMap};
+	const unsigned int kNumberOfGridPartitions[5]		  = {128, 128, 128, 256, 256};
+	const Heuristic	   kHeuristics[g_kNumberOfHeuristics] = {EuclideanDistance, OctileDistance, LandmarkDistance};
+
+	bool isSuccessful = true;
+
+	printf("A* with the euclidean, octile and landmark (ALT) heuristics for %u random pairs of fields per map, %u landmarks\n", g_kNumberOfHeuristicQueries, g_kNumberOfLandmarks);
+	printf("%-18s %8s %8s %10s %10s %10s %10s %10s %10s\n", "map", "paths", "cost", "eucl. exp.", "oct. exp.", "ALT exp.", "eucl. us", "oct. us", "ALT us");
+
+	for(unsigned int map = 0; map < 5; ++map)
+	{
+		TestEnvironment environment;
+
+		if(!CreateMap(environment, kMapTypes[map], kNumberOfGridPartitions[map]))
+		{
+			printf("Failed to set up the %s map of size %u\n", GetMapTypeName(kMapTypes[map]), kNumberOfGridPartitions[map]);
+			isSuccessful = false;
+			continue;
+		}
+
+		Pathfinder&	  pathfinder = environment.GetPathfinder();
+		SearchContext contexts[g_kNumberOfHeuristics];
+
+		unsigned int numberOfPaths	= 0;
+		unsigned int costMismatches = 0;
+		double		 expansions[g_kNumberOfHeuristics] = {0.0, 0.0, 0.0};
+		double		 times[g_kNumberOfHeuristics]	   = {0.0, 0.0, 0.0};
+
+		for(unsigned int i = 0; i < g_kNumberOfHeuristicQueries; ++i)
+		{
+			XMFLOAT2 start;
+			XMFLOAT2 target;
+			GetRandomFreePosition(environment, start);
+			GetRandomFreePosition(environment, target);
+
+			std::vector<XMFLOAT2> path;
+			bool				  isPathFound[g_kNumberOfHeuristics];
+			double				  queryTimes[g_kNumberOfHeuristics];
+			bool				  isCacheHit = false;
+
+			for(unsigned int h = 0; h < g_kNumberOfHeuristics; ++h)
+			{
+				double startTime = GetTime();
+				isPathFound[h]	 = pathfinder.CalculatePath(AStar, kHeuristics[h], 0.0f, start, target, path, contexts[h]);
+				queryTimes[h]	 = GetTime() - startTime;
+				isCacheHit		|= contexts[h].GetQueryStatistics().m_isCacheHit;
+			}
+
+			if(isCacheHit)
+			{
+				// The pair was searched before, the contexts do not hold its search
+				continue;
+			}
+
+			++numberOfPaths;
+
+			XMFLOAT2 targetGridPosition;
+			environment.WorldToGridPosition(target, targetGridPosition);
+			unsigned long targetId = environment.GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y))->GetId();
+
+			for(unsigned int h = 0; h < g_kNumberOfHeuristics; ++h)
+			{
+				expansions[h] += contexts[h].GetQueryStatistics().m_nodesExpanded;
+				times[h]	  += queryTimes[h];
+
+				if(isPathFound[h] != isPathFound[0])
+				{
+					++costMismatches;
+				}else if(isPathFound[h] && h > 0)
+				{
+					float referenceCost = contexts[0].GetNodeData(targetId).m_movementCost;
+					float cost			= contexts[h].GetNodeData(targetId).m_movementCost;
+
+					if(fabs(referenceCost - cost) > g_kHeuristicCostTolerance * std::max(referenceCost, 1.0f))
+					{
+						++costMismatches;
+					}
+				}
+			}
+		}
+
+		if(costMismatches != 0)
+		{
+			isSuccessful = false;
+		}
+
+		unsigned int numberOfQueries = std::max(numberOfPaths, 1u);
+
+		printf("%3ux%-3u %-10s %8u %8u %10.0f %10.0f %10.0f %10.1f %10.1f %10.1f\n", kNumberOfGridPartitions[map], kNumberOfGridPartitions[map], GetMapTypeName(kMapTypes[map]),
+			   numberOfPaths, costMismatches, expansions[0] / numberOfQueries, expansions[1] / numberOfQueries, expansions[2] / numberOfQueries,
+			   times[0] / numberOfQueries, times[1] / numberOfQueries, times[2] / numberOfQueries);
+
+		environment.EndSimulation();
+	}
+
+	return isSuccessful;
+}
@@ -0,0 +1,127 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  JumpPointSearchBenchmark.cpp
+*  Compares jump point search to A* on open maps, on maps with long corridors between walls
+*  and on maps with random obstacles. Both searches are run for the same random pairs of free
+*  fields and have to find paths of the same cost. The benchmark reports the expanded nodes
+*  per query, which are the jump points for jump point search, and the time per query, which
+*  also includes the scans between the jump points.
+*/
+
+// Includes
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "TestEnvironment.h"
+#include "TestUtilities.h"
+#include "TestSuites.h"
+
+// The number of random pairs of fields searched on each map
+const unsigned int g_kNumberOfJumpPointQueries = 200;
+
+// The relative difference, up to which path costs are considered equal
+const float g_kJumpPointCostTolerance = 1e-4f;
+
+//--------------------------------------------------------------------------------------
+// Runs the benchmark on open, walled and random maps of two sizes.
+// Returns true if jump point search and A* find paths of the same cost for all pairs of
+// fields, false otherwise.
+//--------------------------------------------------------------------------------------
+bool RunJumpPointSearchBenchmark(void)
+{
+	SetRandomSeed(3);
+
+	const MapType	   kMapTypes[6]				  = {OpenMap, WallsMap, SparseRandomMap, OpenMap, WallsMap, SparseRandomMap};
+	const unsigned int kNumberOfGridPartitions[6] = {64, 64, 64, 256, 256, 256};
+
+	bool isSuccessful = true;
+
+	printf("Jump point search compared to A* (euclidean heuristic) for %u random pairs of fields per map\n", g_kNumberOfJumpPointQueries);
+	printf("%-18s %8s %8s %10s %10s %8s %10s %10s %8s\n", "map", "paths", "cost", "A* exp.", "JPS exp.", "ratio", "A* us", "JPS us", "speedup");
+
+	for(unsigned int map = 0; map < 6; ++map)
+	{
+		TestEnvironment environment;
+
+		if(!CreateMap(environment, kMapTypes[map], kNumberOfGridPartitions[map]))
+		{
+			printf("Failed to set up the %s map of size %u\n", GetMapTypeName(kMapTypes[map]), kNumberOfGridPartitions[map]);
+			isSuccessful = false;
+			continue;
+		}
+
+		Pathfinder&	  pathfinder = environment.GetPathfinder();
+		SearchContext aStarContext;
+		SearchContext jumpPointContext;
+
+		unsigned int numberOfPaths	  = 0;
+		unsigned int costMismatches	  = 0;
+		double		 aStarExpansions	  = 0.0;
+		double		 jumpPointExpansions = 0.0;
+		double		 aStarTime		  = 0.0;
+		double		 jumpPointTime	  = 0.0;
+
+		for(unsigned int i = 0; i < g_kNumberOfJumpPointQueries; ++i)
+		{
+			XMFLOAT2 start;
+			XMFLOAT2 target;
+			GetRandomFreePosition(environment, start);
+			GetRandomFreePosition(environment, target);
+
+			std::vector<XMFLOAT2> path;
+
+			double startTime		= GetTime();
+			bool   isAStarPathFound = pathfinder.CalculatePath(AStar, EuclideanDistance, 0.0f, start, target, path, aStarContext);
+			double midTime			= GetTime();
+			bool   isJumpPathFound	= pathfinder.CalculatePath(JumpPointSearch, EuclideanDistance, 0.0f, start, target, path, jumpPointContext);
+			double endTime			= GetTime();
+
+			if(aStarContext.GetQueryStatistics().m_isCacheHit || jumpPointContext.GetQueryStatistics().m_isCacheHit)
+			{
+				// The pair was searched before, the contexts do not hold its search
+				continue;
+			}
+
+			aStarTime			+= midTime - startTime;
+			jumpPointTime		+= endTime - midTime;
+			aStarExpansions		+= aStarContext.GetQueryStatistics().m_nodesExpanded;
+			jumpPointExpansions += jumpPointContext.GetQueryStatistics().m_nodesExpanded;
+			++numberOfPaths;
+
+			XMFLOAT2 targetGridPosition;
+			environment.WorldToGridPosition(target, targetGridPosition);
+			unsigned long targetId = environment.GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y))->GetId();
+
+			if(isAStarPathFound != isJumpPathFound)
+			{
+				++costMismatches;
+			}else if(isAStarPathFound)
+			{
+				float aStarCost		= aStarContext.GetNodeData(targetId).m_movementCost;
+				float jumpPointCost = jumpPointContext.GetNodeData(targetId).m_movementCost;
+
+				if(fabs(aStarCost - jumpPointCost) > g_kJumpPointCostTolerance * std::max(aStarCost, 1.0f))
+				{
+					++costMismatches;
+				}
+			}
+		}
+
+		if(costMismatches != 0)
+		{
+			isSuccessful = false;
+		}
+
+		unsigned int numberOfQueries = std::max(numberOfPaths, 1u);
+
+		printf("%3ux%-3u %-10s %8u %8u %10.0f %10.0f %8.3f %10.1f %10.1f %8.1f\n", kNumberOfGridPartitions[map], kNumberOfGridPartitions[map], GetMapTypeName(kMapTypes[map]),
+			   numberOfPaths, costMismatches, aStarExpansions / numberOfQueries, jumpPointExpansions / numberOfQueries,
+			   (aStarExpansions > 0.0) ? jumpPointExpansions / aStarExpansions : 0.0, aStarTime / numberOfQueries, jumpPointTime / numberOfQueries,
+			   (jumpPointTime > 0.0) ? aStarTime / jumpPointTime : 0.0);
+
+		environment.EndSimulation();
+	}
+
+	return isSuccessful;
+}
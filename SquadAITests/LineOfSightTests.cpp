@@ -0,0 +1,383 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  LineOfSightTests.cpp
+*  Property tests and a benchmark for the line of sight checks of the test environment and
+*  the straight path check between grid fields. Generated maps are set up through the edit
+*  mode interface and the simulation is started on them. The checks are then compared to an
+*  exact reference, which tests the segment against the square of every obstacle field, for
+*  random rays, for degenerate rays running through field corners and along field borders and
+*  for the segments between field centres. The suite fails if any check disagrees with the
+*  reference.
+*/
+
+// Includes
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "TestEnvironment.h"
+#include "TestUtilities.h"
+#include "TestSuites.h"
+
+// A map the checks are tested on
+struct MapSettings
+{
+	MapSettings(MapType type, unsigned int numberOfGridPartitions, float maxRayLength) : m_type(type),
+																						 m_numberOfGridPartitions(numberOfGridPartitions),
+																						 m_maxRayLength(maxRayLength)
+	{}
+
+	MapType		 m_type;				   // The kind of the map
+	unsigned int m_numberOfGridPartitions; // The number of fields along each side of the grid
+	float		 m_maxRayLength;		   // The maximal length of the random rays in world units
+};
+
+// The number of rays tested and measured on each map
+const unsigned int g_kNumberOfRandomRays	 = 200000;
+const unsigned int g_kNumberOfDegenerateRays = 50000;
+const unsigned int g_kNumberOfFieldPairs	 = 200000;
+
+//--------------------------------------------------------------------------------------
+// The exact reference for the line of sight checks. Tests the closed segment against the
+// closed square of every obstacle field close to it, touching an obstacle blocks the line.
+// Param1: The test environment.
+// Param2: The start point of the segment in world space.
+// Param3: The end point of the segment in world space.
+// Returns true if the segment does not touch any obstacle, false otherwise.
+//--------------------------------------------------------------------------------------
+bool IsSegmentFree(TestEnvironment& environment, const XMFLOAT2& start, const XMFLOAT2& end)
+{
+	XMFLOAT2 startGridPosition;
+	XMFLOAT2 endGridPosition;
+
+	environment.WorldToGridPosition(start, startGridPosition);
+	environment.WorldToGridPosition(end, endGridPosition);
+
+	int numberOfGridPartitions = static_cast<int>(environment.GetNumberOfGridPartitions());
+	int minX = std::max(static_cast<int>(std::min(startGridPosition.x, endGridPosition.x)) - 1, 0);
+	int maxX = std::min(static_cast<int>(std::max(startGridPosition.x, endGridPosition.x)) + 1, numberOfGridPartitions - 1);
+	int minY = std::max(static_cast<int>(std::min(startGridPosition.y, endGridPosition.y)) - 1, 0);
+	int maxY = std::min(static_cast<int>(std::max(startGridPosition.y, endGridPosition.y)) + 1, numberOfGridPartitions - 1);
+
+	double halfSize = 0.5 * environment.GetGridSpacing();
+	double deltaX	= static_cast<double>(end.x) - start.x;
+	double deltaY	= static_cast<double>(end.y) - start.y;
+
+	for(int x = minX; x <= maxX; ++x)
+	{
+		for(int y = minY; y <= maxY; ++y)
+		{
+			if(!environment.GetNode(x, y)->IsObstacle())
+			{
+				continue;
+			}
+
+			XMFLOAT2 centre;
+			environment.GridToWorldPosition(XMFLOAT2(static_cast<float>(x), static_cast<float>(y)), centre);
+
+			double left	  = centre.x - halfSize;
+			double right  = centre.x + halfSize;
+			double bottom = centre.y - halfSize;
+			double top	  = centre.y + halfSize;
+
+			if(std::max(start.x, end.x) < left || std::min(start.x, end.x) > right || std::max(start.y, end.y) < bottom || std::min(start.y, end.y) > top)
+			{
+				continue;
+			}
+
+			// Within the bounding box, the segment misses the square only if all corners lie strictly on the same side of it
+			bool isLeft	 = false;
+			bool isRight = false;
+
+			for(unsigned int corner = 0; corner < 4; ++corner)
+			{
+				double cornerX = (corner & 1) ? right : left;
+				double cornerY = (corner & 2) ? top : bottom;
+				double side	   = deltaX * (cornerY - start.y) - deltaY * (cornerX - start.x);
+
+				isLeft	= isLeft || side >= 0.0;
+				isRight = isRight || side <= 0.0;
+			}
+
+			if(isLeft && isRight)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Generates random rays between unblocked points within the grid.
+// Param1: The test environment.
+// Param2: The maximal length of the rays in world units.
+// Param3: The number of rays to generate.
+// Param4: Will hold the start points of the rays.
+// Param5: Will hold the end points of the rays.
+//--------------------------------------------------------------------------------------
+void CreateRandomRays(TestEnvironment& environment, float maxLength, unsigned int numberOfRays, std::vector<XMFLOAT2>& starts, std::vector<XMFLOAT2>& ends)
+{
+	float halfGridSize = 0.5f * environment.GetGridSize() * 0.999f;
+
+	while(starts.size() < numberOfRays)
+	{
+		XMFLOAT2 start((GetRandomFloat() * 2.0f - 1.0f) * halfGridSize, (GetRandomFloat() * 2.0f - 1.0f) * halfGridSize);
+		float	 angle	= GetRandomFloat() * XM_2PI;
+		float	 length = GetRandomFloat() * maxLength;
+		XMFLOAT2 end(start.x + length * cos(angle), start.y + length * sin(angle));
+
+		if(fabs(end.x) >= halfGridSize || fabs(end.y) >= halfGridSize || environment.IsBlocked(start) || environment.IsBlocked(end))
+		{
+			continue;
+		}
+
+		starts.push_back(start);
+		ends.push_back(end);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Generates degenerate rays: the start and end points lie on field corners, field centres
+// or at a quarter of a field, and the offsets between them are small whole numbers of fields.
+// Many of these rays run exactly through corners or along borders of fields. Points on the
+// outer border of the grid are left out.
+// Param1: The test environment.
+// Param2: The number of rays to generate.
+// Param3: Will hold the start points of the rays.
+// Param4: Will hold the end points of the rays.
+//--------------------------------------------------------------------------------------
+void CreateDegenerateRays(TestEnvironment& environment, unsigned int numberOfRays, std::vector<XMFLOAT2>& starts, std::vector<XMFLOAT2>& ends)
+{
+	const float kFieldOffsets[4] = {0.0f, 0.25f, 0.5f, 0.75f};
+
+	int	  numberOfGridPartitions = static_cast<int>(environment.GetNumberOfGridPartitions());
+	float halfGridSize			 = 0.5f * environment.GetGridSize();
+	float spacing				 = environment.GetGridSpacing();
+
+	while(starts.size() < numberOfRays)
+	{
+		int	  startX  = 1 + static_cast<int>(GetRandomNumber(numberOfGridPartitions - 1));
+		int	  startY  = 1 + static_cast<int>(GetRandomNumber(numberOfGridPartitions - 1));
+		int	  deltaX  = static_cast<int>(GetRandomNumber(9)) - 4;
+		int	  deltaY  = static_cast<int>(GetRandomNumber(9)) - 4;
+		float offset  = kFieldOffsets[GetRandomNumber(4)];
+
+		if((deltaX == 0 && deltaY == 0) || startX + deltaX < 1 || startY + deltaY < 1 || startX + deltaX >= numberOfGridPartitions || startY + deltaY >= numberOfGridPartitions)
+		{
+			continue;
+		}
+
+		XMFLOAT2 start(-halfGridSize + (startX + offset) * spacing, -halfGridSize + (startY + offset) * spacing);
+		XMFLOAT2 end(-halfGridSize + (startX + deltaX + offset) * spacing, -halfGridSize + (startY + deltaY + offset) * spacing);
+
+		if(environment.IsBlocked(start) || environment.IsBlocked(end))
+		{
+			continue;
+		}
+
+		starts.push_back(start);
+		ends.push_back(end);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Compares the world space line of sight checks to the reference for a set of rays.
+// Param1: The test environment.
+// Param2: The start points of the rays.
+// Param3: The end points of the rays.
+// Param4: Will hold the number of rays, for which the grid traversal disagrees with the reference.
+// Param5: Will hold the number of rays, for which the visibility check disagrees with the reference.
+// Param6: Will hold the number of rays, for which the bounding box scan disagrees with the reference.
+//--------------------------------------------------------------------------------------
+void CompareLineOfSightChecks(TestEnvironment& environment, const std::vector<XMFLOAT2>& starts, const std::vector<XMFLOAT2>& ends,
+							  unsigned int& traversalMismatches, unsigned int& visibilityMismatches, unsigned int& boundingBoxMismatches)
+{
+	traversalMismatches	  = 0;
+	visibilityMismatches  = 0;
+	boundingBoxMismatches = 0;
+
+	for(unsigned int i = 0; i < starts.size(); ++i)
+	{
+		bool isFree = IsSegmentFree(environment, starts[i], ends[i]);
+
+		traversalMismatches	  += (environment.CheckLineOfSightTraversal(starts[i], ends[i]) != isFree) ? 1 : 0;
+		visibilityMismatches  += (environment.CheckVisibility(starts[i], ends[i]) != isFree) ? 1 : 0;
+		boundingBoxMismatches += (environment.CheckLineOfSight(starts[i], ends[i]) != isFree) ? 1 : 0;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Compares the straight path check between grid fields, used to straighten paths and for
+// the shortcuts of Theta*, to the reference for the segments between the field centres.
+// Param1: The test environment.
+// Param2: The number of field pairs to compare.
+// Param3: Will hold the number of pairs, for which the Bresenham line of sight disagrees with the reference.
+// Returns the number of pairs, for which the straight path check disagrees with the reference.
+//--------------------------------------------------------------------------------------
+unsigned int CompareStraightPathChecks(TestEnvironment& environment, unsigned int numberOfPairs, unsigned int& bresenhamMismatches)
+{
+	unsigned int numberOfGridPartitions = environment.GetNumberOfGridPartitions();
+	unsigned int mismatches				= 0;
+
+	bresenhamMismatches = 0;
+
+	for(unsigned int i = 0; i < numberOfPairs; ++i)
+	{
+		int startX = static_cast<int>(GetRandomNumber(numberOfGridPartitions));
+		int startY = static_cast<int>(GetRandomNumber(numberOfGridPartitions));
+		int endX   = std::min(std::max(startX + static_cast<int>(GetRandomNumber(41)) - 20, 0), static_cast<int>(numberOfGridPartitions) - 1);
+		int endY   = std::min(std::max(startY + static_cast<int>(GetRandomNumber(41)) - 20, 0), static_cast<int>(numberOfGridPartitions) - 1);
+
+		XMFLOAT2 start;
+		XMFLOAT2 end;
+		environment.GridToWorldPosition(XMFLOAT2(static_cast<float>(startX), static_cast<float>(startY)), start);
+		environment.GridToWorldPosition(XMFLOAT2(static_cast<float>(endX), static_cast<float>(endY)), end);
+
+		bool isFree = IsSegmentFree(environment, start, end);
+
+		mismatches			+= (environment.CheckStraightPathGrid(startX, startY, endX, endY) != isFree) ? 1 : 0;
+		bresenhamMismatches += (environment.CheckLineOfSightGrid(startX, startY, endX, endY) != isFree) ? 1 : 0;
+	}
+
+	return mismatches;
+}
+
+//--------------------------------------------------------------------------------------
+// Measures the average time of the world space line of sight checks for a set of rays.
+// Param1: The test environment.
+// Param2: The start points of the rays.
+// Param3: The end points of the rays.
+// Param4: Will hold the microseconds per check of the bounding box scan.
+// Param5: Will hold the microseconds per check of the grid traversal.
+// Param6: Will hold the microseconds per check of the visibility check.
+// Param7: Will hold the microseconds per check of the Bresenham line between the fields.
+//--------------------------------------------------------------------------------------
+void MeasureLineOfSightChecks(TestEnvironment& environment, const std::vector<XMFLOAT2>& starts, const std::vector<XMFLOAT2>& ends,
+							  double& boundingBoxTime, double& traversalTime, double& visibilityTime, double& bresenhamTime)
+{
+	unsigned int numberOfRays = static_cast<unsigned int>(starts.size());
+	unsigned int visible	  = 0;
+
+	double startTime = GetTime();
+
+	for(unsigned int i = 0; i < numberOfRays; ++i)
+	{
+		visible += environment.CheckLineOfSight(starts[i], ends[i]) ? 1 : 0;
+	}
+
+	double traversalStartTime = GetTime();
+
+	for(unsigned int i = 0; i < numberOfRays; ++i)
+	{
+		visible += environment.CheckLineOfSightTraversal(starts[i], ends[i]) ? 1 : 0;
+	}
+
+	double visibilityStartTime = GetTime();
+
+	for(unsigned int i = 0; i < numberOfRays; ++i)
+	{
+		visible += environment.CheckVisibility(starts[i], ends[i]) ? 1 : 0;
+	}
+
+	double bresenhamStartTime = GetTime();
+
+	for(unsigned int i = 0; i < numberOfRays; ++i)
+	{
+		XMFLOAT2 startGridPosition;
+		XMFLOAT2 endGridPosition;
+		environment.WorldToGridPosition(starts[i], startGridPosition);
+		environment.WorldToGridPosition(ends[i], endGridPosition);
+
+		visible += environment.CheckLineOfSightGrid(static_cast<int>(startGridPosition.x), static_cast<int>(startGridPosition.y),
+													static_cast<int>(endGridPosition.x), static_cast<int>(endGridPosition.y)) ? 1 : 0;
+	}
+
+	double endTime = GetTime();
+
+	boundingBoxTime = (traversalStartTime - startTime) / numberOfRays;
+	traversalTime	= (visibilityStartTime - traversalStartTime) / numberOfRays;
+	visibilityTime	= (bresenhamStartTime - visibilityStartTime) / numberOfRays;
+	bresenhamTime	= (endTime - bresenhamStartTime) / numberOfRays;
+
+	// Use the results, so that the checks cannot be optimised away
+	if(visible == 0xFFFFFFFF)
+	{
+		printf(" ");
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Runs the property tests and the benchmark of the line of sight checks on all maps.
+// Returns true if all checks agree with the reference, false otherwise.
+//--------------------------------------------------------------------------------------
+bool RunLineOfSightTests(void)
+{
+	SetRandomSeed(7);
+
+	std::vector<MapSettings> maps;
+	maps.push_back(MapSettings(WallsMap, 20, 20.0f));
+	maps.push_back(MapSettings(DenseRandomMap, 20, 20.0f));
+	maps.push_back(MapSettings(SparseRandomMap, 50, 20.0f));
+	maps.push_back(MapSettings(WallsMap, 50, 20.0f));
+	maps.push_back(MapSettings(SparseRandomMap, 100, 100.0f));
+	maps.push_back(MapSettings(WallsMap, 100, 100.0f));
+
+	bool isSuccessful = true;
+
+	printf("Mismatches with the exact reference for random (rand) and degenerate (degen) rays and field pairs, microseconds per check for random rays\n");
+	printf("%-18s %17s %17s %17s %17s %35s\n", "", "traversal", "visibility", "bounding box", "grid fields", "us per check");
+	printf("%-18s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s\n", "map", "rand", "degen", "rand", "degen", "rand", "degen", "straight", "bresen.", "bbox", "travers.", "visib.", "bresen.");
+
+	for(std::vector<MapSettings>::const_iterator it = maps.begin(); it != maps.end(); ++it)
+	{
+		TestEnvironment environment;
+
+		if(!CreateMap(environment, it->m_type, it->m_numberOfGridPartitions))
+		{
+			printf("Failed to set up the %s map of size %u\n", GetMapTypeName(it->m_type), it->m_numberOfGridPartitions);
+			isSuccessful = false;
+			continue;
+		}
+
+		std::vector<XMFLOAT2> randomStarts;
+		std::vector<XMFLOAT2> randomEnds;
+		std::vector<XMFLOAT2> degenerateStarts;
+		std::vector<XMFLOAT2> degenerateEnds;
+
+		CreateRandomRays(environment, it->m_maxRayLength, g_kNumberOfRandomRays, randomStarts, randomEnds);
+		CreateDegenerateRays(environment, g_kNumberOfDegenerateRays, degenerateStarts, degenerateEnds);
+
+		unsigned int traversalMismatches[2];
+		unsigned int visibilityMismatches[2];
+		unsigned int boundingBoxMismatches[2];
+		unsigned int bresenhamMismatches = 0;
+
+		CompareLineOfSightChecks(environment, randomStarts, randomEnds, traversalMismatches[0], visibilityMismatches[0], boundingBoxMismatches[0]);
+		CompareLineOfSightChecks(environment, degenerateStarts, degenerateEnds, traversalMismatches[1], visibilityMismatches[1], boundingBoxMismatches[1]);
+
+		unsigned int straightPathMismatches = CompareStraightPathChecks(environment, g_kNumberOfFieldPairs, bresenhamMismatches);
+
+		double boundingBoxTime = 0.0;
+		double traversalTime   = 0.0;
+		double visibilityTime  = 0.0;
+		double bresenhamTime   = 0.0;
+
+		MeasureLineOfSightChecks(environment, randomStarts, randomEnds, boundingBoxTime, traversalTime, visibilityTime, bresenhamTime);
+
+		// The bounding box scan and the Bresenham line are known to be inexact, they are only reported
+		if(traversalMismatches[0] + traversalMismatches[1] + visibilityMismatches[0] + visibilityMismatches[1] + straightPathMismatches != 0)
+		{
+			isSuccessful = false;
+		}
+
+		printf("%3ux%-3u %-10s %8u %8u %8u %8u %8u %8u %8u %8u %8.3f %8.3f %8.3f %8.3f\n", it->m_numberOfGridPartitions, it->m_numberOfGridPartitions, GetMapTypeName(it->m_type),
+			   traversalMismatches[0], traversalMismatches[1], visibilityMismatches[0], visibilityMismatches[1], boundingBoxMismatches[0], boundingBoxMismatches[1],
+			   straightPathMismatches, bresenhamMismatches, boundingBoxTime, traversalTime, visibilityTime, bresenhamTime);
+
+		environment.EndSimulation();
+	}
+
+	return isSuccessful;
+}
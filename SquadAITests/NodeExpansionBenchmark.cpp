@@ -0,0 +1,248 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  NodeExpansionBenchmark.cpp
+*  Measures how many nodes per second A* expands with the indexed binary heap and the generation
+*  stamped node data of the search context. For comparison, the same queries are run with a copy
+*  of the former implementation, which sorted the open list before every expansion and scanned
+*  the open and closed lists for every adjacent node. As the cost of these scans grows with the
+*  number of expanded nodes, the former implementation is stopped after a fixed number of
+*  expansions. The paths of the queries it completes have to cost as much as the ones found with
+*  the heap.
+*/
+
+// Includes
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "TestEnvironment.h"
+#include "TestUtilities.h"
+#include "TestSuites.h"
+
+// The number of random queries run on each map
+const unsigned int g_kNumberOfQueries = 40;
+
+// The number of expansions, after which the list-based search is stopped
+const unsigned int g_kMaxListExpansions = 5000;
+
+// The relative difference, up to which path costs are considered equal
+const float g_kListPathCostTolerance = 1e-4f;
+
+// Holds the per-node data of the list-based search, which was formerly kept by the nodes
+struct ListSearchData
+{
+	std::vector<float>		   m_movementCosts;	  // The cost of the best known path from the start to each node
+	std::vector<float>		   m_heuristicValues; // The estimated cost from each node to the target
+	std::vector<unsigned long> m_openList;		  // The ids of the nodes on the open list
+	std::vector<unsigned long> m_closedList;	  // The ids of the nodes on the closed list
+};
+
+// Orders node ids by the total estimate of the cost of a path through them
+struct CompareTotalEstimates
+{
+	CompareTotalEstimates(const ListSearchData& data) : m_data(data)
+	{}
+
+	bool operator()(unsigned long first, unsigned long second) const
+	{
+		return m_data.m_movementCosts[first] + m_data.m_heuristicValues[first] < m_data.m_movementCosts[second] + m_data.m_heuristicValues[second];
+	}
+
+	const ListSearchData& m_data;
+};
+
+//--------------------------------------------------------------------------------------
+// Searches a path with the former list-based A*: the open list is sorted before every
+// expansion, membership in the open and closed lists is determined by scanning them.
+// Param1: The test environment.
+// Param2: The node to start from.
+// Param3: The target node.
+// Param4: The scratch data of the search.
+// Param5: Will hold the number of expanded nodes.
+// Param6: Will hold the cost of the path, if one was found.
+// Returns true if the target was reached within the expansion limit, false otherwise.
+//--------------------------------------------------------------------------------------
+bool SearchWithLists(TestEnvironment& environment, const Node* pStartNode, const Node* pTargetNode, ListSearchData& data, unsigned int& expansions, float& pathCost)
+{
+	const Pathfinder& pathfinder = environment.GetPathfinder();
+
+	data.m_openList.clear();
+	data.m_closedList.clear();
+
+	XMFLOAT2 targetPosition = pTargetNode->GetWorldPosition();
+
+	data.m_movementCosts[pStartNode->GetId()]	= 0.0f;
+	data.m_heuristicValues[pStartNode->GetId()] = 0.0f;
+	data.m_openList.push_back(pStartNode->GetId());
+
+	expansions = 0;
+
+	while(!data.m_openList.empty() && expansions < g_kMaxListExpansions)
+	{
+		std::sort(data.m_openList.begin(), data.m_openList.end(), CompareTotalEstimates(data));
+
+		unsigned long currentId = data.m_openList[0];
+		data.m_closedList.push_back(currentId);
+		data.m_openList.erase(data.m_openList.begin());
+		++expansions;
+
+		if(currentId == pTargetNode->GetId())
+		{
+			pathCost = data.m_movementCosts[currentId];
+			return true;
+		}
+
+		const Node*	  pCurrentNode = environment.GetNodeById(currentId);
+		unsigned int  currentX	   = static_cast<unsigned int>(pCurrentNode->GetGridPosition().x);
+		unsigned int  currentY	   = static_cast<unsigned int>(pCurrentNode->GetGridPosition().y);
+		unsigned char moveMask	   = pCurrentNode->GetMoveMask();
+
+		for(unsigned int move = 0; move < g_kNumberOfMoves; ++move)
+		{
+			if(!(moveMask & (1 << move)))
+			{
+				continue;
+			}
+
+			const Node*	  pAdjacentNode = environment.GetNode(currentX + g_kMoveOffsetX[move], currentY + g_kMoveOffsetY[move]);
+			unsigned long adjacentId	= pAdjacentNode->GetId();
+
+			if(std::find(data.m_closedList.begin(), data.m_closedList.end(), adjacentId) != data.m_closedList.end())
+			{
+				continue;
+			}
+
+			float traversalCost = pathfinder.GetWeightHorizontal();
+
+			if(g_kMoveOffsetX[move] != 0 && g_kMoveOffsetY[move] != 0)
+			{
+				traversalCost = pathfinder.GetWeightDiagonal();
+			}else if(g_kMoveOffsetX[move] != 0)
+			{
+				traversalCost = pathfinder.GetWeightVertical();
+			}
+
+			float newCost = data.m_movementCosts[currentId] + traversalCost;
+
+			if(std::find(data.m_openList.begin(), data.m_openList.end(), adjacentId) == data.m_openList.end())
+			{
+				float deltaX = targetPosition.x - pAdjacentNode->GetWorldPosition().x;
+				float deltaY = targetPosition.y - pAdjacentNode->GetWorldPosition().y;
+
+				data.m_openList.push_back(adjacentId);
+				data.m_movementCosts[adjacentId]   = newCost;
+				data.m_heuristicValues[adjacentId] = sqrt(deltaX * deltaX + deltaY * deltaY);
+			}else if(newCost < data.m_movementCosts[adjacentId])
+			{
+				data.m_movementCosts[adjacentId] = newCost;
+			}
+		}
+	}
+
+	return false;
+}
+
+//--------------------------------------------------------------------------------------
+// Runs the benchmark on 64x64, 256x256 and 1024x1024 grids.
+// Returns true if the list-based search and the heap agree on the costs of all paths
+// completed by both, false otherwise.
+//--------------------------------------------------------------------------------------
+bool RunNodeExpansionBenchmark(void)
+{
+	SetRandomSeed(1);
+
+	const unsigned int kNumberOfGridPartitions[3] = {64, 256, 1024};
+
+	bool isSuccessful = true;
+
+	printf("Nodes expanded per second by A* for %u random queries per map, the list-based search is stopped after %u expansions\n", g_kNumberOfQueries, g_kMaxListExpansions);
+	printf("%-18s %12s %12s %12s %12s %9s %9s %8s\n", "map", "heap exp.", "heap exp/s", "list exp.", "list exp/s", "speedup", "compared", "cost");
+
+	for(unsigned int map = 0; map < 3; ++map)
+	{
+		TestEnvironment environment;
+
+		if(!CreateMap(environment, SparseRandomMap, kNumberOfGridPartitions[map]))
+		{
+			printf("Failed to set up the %s map of size %u\n", GetMapTypeName(SparseRandomMap), kNumberOfGridPartitions[map]);
+			isSuccessful = false;
+			continue;
+		}
+
+		Pathfinder&	  pathfinder = environment.GetPathfinder();
+		SearchContext context;
+
+		unsigned long numberOfNodes = environment.GetNumberOfGridPartitions() * environment.GetNumberOfGridPartitions();
+
+		ListSearchData listData;
+		listData.m_movementCosts.resize(numberOfNodes, 0.0f);
+		listData.m_heuristicValues.resize(numberOfNodes, 0.0f);
+
+		double		 heapExpansions = 0.0;
+		double		 heapTime		= 0.0;
+		double		 listExpansions = 0.0;
+		double		 listTime		= 0.0;
+		unsigned int comparedPaths	= 0;
+		unsigned int costMismatches = 0;
+
+		for(unsigned int i = 0; i < g_kNumberOfQueries; ++i)
+		{
+			XMFLOAT2 start;
+			XMFLOAT2 target;
+			GetRandomFreePosition(environment, start);
+			GetRandomFreePosition(environment, target);
+
+			std::vector<XMFLOAT2> path;
+
+			double startTime	= GetTime();
+			bool   isPathFound	= pathfinder.CalculatePath(AStar, EuclideanDistance, 0.0f, start, target, path, context);
+			heapTime		   += GetTime() - startTime;
+
+			heapExpansions += context.GetQueryStatistics().m_nodesExpanded;
+
+			XMFLOAT2 startGridPosition;
+			XMFLOAT2 targetGridPosition;
+			environment.WorldToGridPosition(start, startGridPosition);
+			environment.WorldToGridPosition(target, targetGridPosition);
+
+			const Node* pStartNode	= environment.GetNode(static_cast<unsigned int>(startGridPosition.x), static_cast<unsigned int>(startGridPosition.y));
+			const Node* pTargetNode = environment.GetNode(static_cast<unsigned int>(targetGridPosition.x), static_cast<unsigned int>(targetGridPosition.y));
+
+			unsigned int expansions = 0;
+			float		 listCost	= 0.0f;
+
+			startTime			   = GetTime();
+			bool isListPathFound   = SearchWithLists(environment, pStartNode, pTargetNode, listData, expansions, listCost);
+			listTime			  += GetTime() - startTime;
+
+			listExpansions += expansions;
+
+			if(isListPathFound && !context.GetQueryStatistics().m_isCacheHit)
+			{
+				++comparedPaths;
+
+				float heapCost = context.GetNodeData(pTargetNode->GetId()).m_movementCost;
+
+				if(!isPathFound || fabs(heapCost - listCost) > g_kListPathCostTolerance * std::max(heapCost, 1.0f))
+				{
+					++costMismatches;
+				}
+			}
+		}
+
+		if(costMismatches != 0)
+		{
+			isSuccessful = false;
+		}
+
+		double heapRate = heapExpansions * 1000000.0 / std::max(heapTime, 1.0);
+		double listRate = listExpansions * 1000000.0 / std::max(listTime, 1.0);
+
+		printf("%4ux%-4u %-9s %12.0f %12.0f %12.0f %12.0f %9.1f %9u %8u\n", kNumberOfGridPartitions[map], kNumberOfGridPartitions[map], GetMapTypeName(SparseRandomMap),
+			   heapExpansions / g_kNumberOfQueries, heapRate, listExpansions / g_kNumberOfQueries, listRate, heapRate / std::max(listRate, 1.0), comparedPaths, costMismatches);
+
+		environment.EndSimulation();
+	}
+
+	return isSuccessful;
+}
@@ -0,0 +1,86 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  SquadAITests.cpp
+*  Entry point of the test program. Runs all test suites or only those named on the command
+*  line, e.g. "SquadAITests lineofsight". The program returns a non-zero exit code if any
+*  suite fails.
+*/
+
+// Includes
+#include <cstdio>
+#include <cstring>
+#include "TestSuites.h"
+
+// A test suite that can be selected on the command line
+struct TestSuite
+{
+	const char* m_pName;		   // The name used to select the suite
+	bool		(*m_pRun)(void);   // Runs the suite, returns true if all of its tests passed
+};
+
+const TestSuite g_kTestSuites[] =
+{
+	{"lineofsight",	  RunLineOfSightTests},
+	{"bidirectional", RunBidirectionalSearchTests},
+	{"expansions",	  RunNodeExpansionBenchmark},
+	{"jumppoint",	  RunJumpPointSearchBenchmark},
+	{"chase",		  RunChaseBenchmark},
+	{"heuristics",	  RunHeuristicBenchmark},
+	{"visibility",	  RunVisibilityTableBenchmark}
+};
+
+const unsigned int g_kNumberOfTestSuites = sizeof(g_kTestSuites) / sizeof(g_kTestSuites[0]);
+
+//--------------------------------------------------------------------------------------
+// Checks whether a suite was selected on the command line, all suites run if none was named.
+// Param1: The number of command line arguments.
+// Param2: The command line arguments.
+// Param3: The name of the suite.
+// Returns true if the suite should run, false otherwise.
+//--------------------------------------------------------------------------------------
+bool IsSuiteSelected(int argc, char* argv[], const char* pName)
+{
+	if(argc < 2)
+	{
+		return true;
+	}
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(strcmp(argv[i], pName) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//--------------------------------------------------------------------------------------
+// Entry point of the tests.
+// Returns 0 if all selected suites passed, 1 otherwise.
+//--------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	bool isSuccessful = true;
+
+	for(unsigned int i = 0; i < g_kNumberOfTestSuites; ++i)
+	{
+		if(!IsSuiteSelected(argc, argv, g_kTestSuites[i].m_pName))
+		{
+			continue;
+		}
+
+		printf("\n== %s ==\n", g_kTestSuites[i].m_pName);
+
+		if(!g_kTestSuites[i].m_pRun())
+		{
+			printf("Suite %s FAILED\n", g_kTestSuites[i].m_pName);
+			isSuccessful = false;
+		}
+	}
+
+	printf(isSuccessful ? "All tests passed\n" : "Tests FAILED\n");
+
+	return isSuccessful ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  TestSuites.h
+*  Declares the test suites run by the test program. Each suite prints a table of its results
+*  and returns false if any of its property tests fails, benchmarks only report their numbers.
+*/
+
+#ifndef TEST_SUITES_H
+#define TEST_SUITES_H
+
+bool RunLineOfSightTests(void);
+bool RunBidirectionalSearchTests(void);
+bool RunNodeExpansionBenchmark(void);
+bool RunJumpPointSearchBenchmark(void);
+bool RunChaseBenchmark(void);
+bool RunHeuristicBenchmark(void);
+bool RunVisibilityTableBenchmark(void);
+
+#endif // TEST_SUITES_H
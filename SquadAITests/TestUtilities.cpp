@@ -0,0 +1,166 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  TestUtilities.cpp
+*  Helper functions shared by the tests and benchmarks: a reproducible random number
+*  generator, a high resolution timer and the set up of generated maps.
+*/
+
+// Includes
+#include <windows.h>
+#include "TestUtilities.h"
+
+// The state of the random number generator, fixed to make the runs reproducible
+unsigned int g_randomState = 7;
+
+//--------------------------------------------------------------------------------------
+// Generates a random number, the same sequence on every platform.
+// Param1: The number of possible values.
+// Returns a random number between 0 and the given number (exclusive).
+//--------------------------------------------------------------------------------------
+unsigned int GetRandomNumber(unsigned int range)
+{
+	g_randomState = g_randomState * 1103515245u + 12345u;
+	return (g_randomState >> 8) % range;
+}
+
+//--------------------------------------------------------------------------------------
+// Generates a random floating point number.
+// Returns a random number between 0 and 1.
+//--------------------------------------------------------------------------------------
+float GetRandomFloat(void)
+{
+	return static_cast<float>(GetRandomNumber(1 << 20)) / static_cast<float>(1 << 20);
+}
+
+//--------------------------------------------------------------------------------------
+// Restarts the random number sequence, each test suite starts from its own seed so that
+// its maps do not depend on the suites run before it.
+// Param1: The new state of the random number generator.
+//--------------------------------------------------------------------------------------
+void SetRandomSeed(unsigned int seed)
+{
+	g_randomState = seed;
+}
+
+//--------------------------------------------------------------------------------------
+// Reads the high resolution timer.
+// Returns the current time in microseconds.
+//--------------------------------------------------------------------------------------
+double GetTime(void)
+{
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+
+	return static_cast<double>(counter.QuadPart) * 1000000.0 / static_cast<double>(frequency.QuadPart);
+}
+
+//--------------------------------------------------------------------------------------
+// Returns the name of a kind of generated map used in the result tables.
+// Param1: The kind of map.
+//--------------------------------------------------------------------------------------
+const char* GetMapTypeName(MapType type)
+{
+	switch(type)
+	{
+	case WallsMap:
+		return "walls";
+	case SparseRandomMap:
+		return "5% random";
+	case DenseRandomMap:
+		return "15% random";
+	case OpenMap:
+		return "open";
+	default:
+		return "unknown";
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// Sets up a generated map in edit mode and starts the simulation on it, which creates the
+// obstacles and prepares the node graph, the visibility table and so on. The objects
+// required by the teams are placed along the left and right border of the grid.
+// Param1: The test environment to set up.
+// Param2: The kind of map to create.
+// Param3: The number of fields along each side of the grid.
+// Returns true if the simulation was started successfully, false otherwise.
+//--------------------------------------------------------------------------------------
+bool CreateMap(TestEnvironment& environment, MapType type, unsigned int numberOfGridPartitions)
+{
+	if(!environment.Initialise(numberOfGridPartitions * g_kTestGridSpacing, numberOfGridPartitions))
+	{
+		return false;
+	}
+
+	XMFLOAT2 position;
+
+	for(unsigned int team = 0; team < 2; ++team)
+	{
+		float x = (team == 0) ? 0.0f : static_cast<float>(numberOfGridPartitions - 1);
+
+		environment.GridToWorldPosition(XMFLOAT2(x, 0.0f), position);
+		environment.AddObject((team == 0) ? RedFlagType : BlueFlagType, position, 0.0f);
+		environment.GridToWorldPosition(XMFLOAT2(x, 1.0f), position);
+		environment.AddObject((team == 0) ? RedSpawnPointType : BlueSpawnPointType, position, 0.0f);
+		environment.GridToWorldPosition(XMFLOAT2(x, 2.0f), position);
+		environment.AddObject((team == 0) ? RedAttackPositionType : BlueAttackPositionType, position, 0.0f);
+
+		for(unsigned int i = 0; i < g_kSoldiersPerTeam; ++i)
+		{
+			environment.GridToWorldPosition(XMFLOAT2(x, static_cast<float>(3 + i)), position);
+			environment.AddObject((team == 0) ? RedSoldierType : BlueSoldierType, position, 0.0f);
+		}
+	}
+
+	// Keep the border columns free for the team objects
+	for(unsigned int x = 1; x < numberOfGridPartitions - 1; ++x)
+	{
+		for(unsigned int y = 0; y < numberOfGridPartitions; ++y)
+		{
+			bool isObstacle = false;
+
+			switch(type)
+			{
+			case WallsMap:
+				isObstacle = (x % 12 == 6 && y % 10 > 2) || (y % 12 == 6 && x % 10 > 2 && x % 10 < 8);
+				break;
+			case SparseRandomMap:
+				isObstacle = GetRandomNumber(100) < 5;
+				break;
+			case DenseRandomMap:
+				isObstacle = GetRandomNumber(100) < 15;
+				break;
+			case OpenMap:
+				break;
+			}
+
+			if(isObstacle)
+			{
+				environment.GridToWorldPosition(XMFLOAT2(static_cast<float>(x), static_cast<float>(y)), position);
+				environment.AddObject(ObstacleType, position, 0.0f);
+			}
+		}
+	}
+
+	return environment.StartSimulation();
+}
+
+//--------------------------------------------------------------------------------------
+// Picks the centre of a random grid field that is not blocked by an obstacle.
+// Param1: The test environment.
+// Param2: Will hold the world position of the field centre.
+//--------------------------------------------------------------------------------------
+void GetRandomFreePosition(TestEnvironment& environment, XMFLOAT2& position)
+{
+	unsigned int numberOfGridPartitions = environment.GetNumberOfGridPartitions();
+
+	do
+	{
+		unsigned int x = GetRandomNumber(numberOfGridPartitions);
+		unsigned int y = GetRandomNumber(numberOfGridPartitions);
+
+		environment.GridToWorldPosition(XMFLOAT2(static_cast<float>(x), static_cast<float>(y)), position);
+	}while(environment.IsBlocked(position));
+}
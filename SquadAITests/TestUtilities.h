@@ -0,0 +1,37 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  TestUtilities.h
+*  Helper functions shared by the tests and benchmarks: a reproducible random number
+*  generator, a high resolution timer and the set up of generated maps.
+*/
+
+#ifndef TEST_UTILITIES_H
+#define TEST_UTILITIES_H
+
+// Includes
+#include <DirectXMath.h>
+#include "TestEnvironment.h"
+
+using namespace DirectX;
+
+// The kinds of generated maps
+enum MapType
+{
+	WallsMap,		   // Regular walls with gaps, lots of rays run along the wall borders
+	SparseRandomMap,   // 5% of the fields are obstacles
+	DenseRandomMap,	   // 15% of the fields are obstacles
+	OpenMap			   // No obstacles at all
+};
+
+// The side length of a grid field in world units
+const float g_kTestGridSpacing = 2.5f;
+
+unsigned int GetRandomNumber(unsigned int range);
+float		 GetRandomFloat(void);
+void		 SetRandomSeed(unsigned int seed);
+double		 GetTime(void);
+const char*	 GetMapTypeName(MapType type);
+bool		 CreateMap(TestEnvironment& environment, MapType type, unsigned int numberOfGridPartitions);
+void		 GetRandomFreePosition(TestEnvironment& environment, XMFLOAT2& position);
+
+#endif // TEST_UTILITIES_H
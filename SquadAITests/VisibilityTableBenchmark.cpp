@@ -0,0 +1,143 @@
+/*
+*  Kevin Meergans, SquadAI, 2014
+*  VisibilityTableBenchmark.cpp
+*  Measures the costs and savings of the visibility table: the time to build it for a whole
+*  map and to rebuild it around a changed field, the memory it takes and the time per line of
+*  sight check for random rays up to the viewing distance of the soldiers. The checks using the
+*  table are compared to the exact checks, every pair of fields the table marks as fully
+*  visible has to be visible for the exact check as well.
+*/
+
+// Includes
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "TestEnvironment.h"
+#include "TestUtilities.h"
+#include "TestSuites.h"
+
+// The number of random rays checked on each map
+const unsigned int g_kNumberOfVisibilityRays = 200000;
+
+//--------------------------------------------------------------------------------------
+// Runs the benchmark of the visibility table on several maps.
+// Returns true if the table agrees with the exact line of sight checks for all rays, false
+// otherwise.
+//--------------------------------------------------------------------------------------
+bool RunVisibilityTableBenchmark(void)
+{
+	SetRandomSeed(24);
+
+	const MapType	   kMapTypes[5]				  = {WallsMap, SparseRandomMap, DenseRandomMap, WallsMap, SparseRandomMap};
+	const unsigned int kNumberOfGridPartitions[5] = {64, 64, 64, 128, 256};
+
+	bool isSuccessful = true;
+
+	printf("Visibility table for a viewing distance of %.1f, %u random rays up to the viewing distance per map\n", g_kSoldierViewingDistance, g_kNumberOfVisibilityRays);
+	printf("%-18s %9s %9s %8s %7s %7s %9s %9s %9s %8s\n", "map", "build ms", "field ms", "KB", "hits", "wrong", "exact us", "trav. us", "table us", "speedup");
+
+	for(unsigned int map = 0; map < 5; ++map)
+	{
+		TestEnvironment environment;
+
+		if(!CreateMap(environment, kMapTypes[map], kNumberOfGridPartitions[map]))
+		{
+			printf("Failed to set up the %s map of size %u\n", GetMapTypeName(kMapTypes[map]), kNumberOfGridPartitions[map]);
+			isSuccessful = false;
+			continue;
+		}
+
+		unsigned int numberOfGridPartitions = environment.GetNumberOfGridPartitions();
+
+		// Build a table of its own, the one of the environment was built when the simulation started
+		VisibilityTable visibilityTable;
+		visibilityTable.Initialise(&environment, g_kSoldierViewingDistance);
+
+		double startTime = GetTime();
+		visibilityTable.Update();
+		double buildTime = GetTime() - startTime;
+
+		// Rebuild the fields around a single changed field in the centre of the map
+		visibilityTable.Invalidate(numberOfGridPartitions / 2, numberOfGridPartitions / 2);
+
+		startTime			 = GetTime();
+		visibilityTable.Update();
+		double rebuildTime	 = GetTime() - startTime;
+
+		std::vector<XMFLOAT2> starts(g_kNumberOfVisibilityRays);
+		std::vector<XMFLOAT2> ends(g_kNumberOfVisibilityRays);
+		std::vector<bool>	  isFullyVisible(g_kNumberOfVisibilityRays);
+
+		float		 halfGridSize = 0.5f * numberOfGridPartitions * g_kTestGridSpacing;
+		unsigned int hits		  = 0;
+		unsigned int wrongHits	  = 0;
+
+		for(unsigned int i = 0; i < g_kNumberOfVisibilityRays; ++i)
+		{
+			// Keep the rays within the grid, soldiers cannot leave it
+			do
+			{
+				float angle	 = GetRandomFloat() * XM_2PI;
+				float length = GetRandomFloat() * g_kSoldierViewingDistance;
+
+				starts[i] = XMFLOAT2((GetRandomFloat() * 2.0f - 1.0f) * halfGridSize, (GetRandomFloat() * 2.0f - 1.0f) * halfGridSize);
+				ends[i]	  = XMFLOAT2(starts[i].x + cos(angle) * length, starts[i].y + sin(angle) * length);
+			}while(fabs(ends[i].x) >= halfGridSize || fabs(ends[i].y) >= halfGridSize);
+
+			XMFLOAT2 startGridPosition;
+			XMFLOAT2 endGridPosition;
+			environment.WorldToGridPosition(starts[i], startGridPosition);
+			environment.WorldToGridPosition(ends[i], endGridPosition);
+
+			isFullyVisible[i] = visibilityTable.IsFullyVisible(static_cast<unsigned int>(startGridPosition.x), static_cast<unsigned int>(startGridPosition.y),
+															   static_cast<unsigned int>(endGridPosition.x), static_cast<unsigned int>(endGridPosition.y));
+
+			if(isFullyVisible[i])
+			{
+				++hits;
+				wrongHits += environment.CheckLineOfSight(starts[i], ends[i]) ? 0 : 1;
+			}
+		}
+
+		if(wrongHits != 0)
+		{
+			isSuccessful = false;
+		}
+
+		// Time the exact checks and the checks that try the table first
+		unsigned int visible = 0;
+
+		double exactStartTime = GetTime();
+		for(unsigned int i = 0; i < g_kNumberOfVisibilityRays; ++i)
+		{
+			visible += environment.CheckLineOfSight(starts[i], ends[i]) ? 1 : 0;
+		}
+
+		double traversalStartTime = GetTime();
+		for(unsigned int i = 0; i < g_kNumberOfVisibilityRays; ++i)
+		{
+			visible += environment.CheckLineOfSightTraversal(starts[i], ends[i]) ? 1 : 0;
+		}
+
+		double tableStartTime = GetTime();
+		for(unsigned int i = 0; i < g_kNumberOfVisibilityRays; ++i)
+		{
+			visible += environment.CheckVisibility(starts[i], ends[i]) ? 1 : 0;
+		}
+
+		double endTime = GetTime();
+
+		double exactTime	 = (traversalStartTime - exactStartTime) / g_kNumberOfVisibilityRays;
+		double traversalTime = (tableStartTime - traversalStartTime) / g_kNumberOfVisibilityRays;
+		double tableTime	 = (endTime - tableStartTime) / g_kNumberOfVisibilityRays;
+
+		// The number of visible rays is printed so that the checks cannot be optimised away
+		printf("%3ux%-3u %-10s %9.1f %9.2f %8.1f %6.1f%% %7u %9.3f %9.3f %9.3f %8.2f (%u visible)\n", numberOfGridPartitions, numberOfGridPartitions, GetMapTypeName(kMapTypes[map]),
+			   buildTime / 1000.0, rebuildTime / 1000.0, visibilityTable.GetMemoryUsage() / 1024.0, 100.0 * hits / g_kNumberOfVisibilityRays, wrongHits,
+			   exactTime, traversalTime, tableTime, (tableTime > 0.0) ? traversalTime / tableTime : 0.0, visible / 3);
+
+		environment.EndSimulation();
+	}
+
+	return isSuccessful;
+}